@@ -0,0 +1,71 @@
+#include "bench.hpp"
+#include "starlet-math/animation.hpp"
+
+#include <random>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+  // 30 keys per channel over two seconds, a typical sampled clip
+  std::vector<SMath::AnimationTrack> randomTracks(const size_t n) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> pos(-10.0f, 10.0f), angle(-180.0f, 180.0f), size(0.5f, 2.0f);
+    std::vector<SMath::AnimationTrack> tracks(n);
+    for (SMath::AnimationTrack& track : tracks) {
+      for (int k = 0; k < 30; ++k) {
+        const float t = static_cast<float>(k) / 15.0f;
+        track.addPosition(t, { pos(rng), pos(rng), pos(rng) });
+        track.addRotation(t, SMath::Quat<float>::fromEuler({ angle(rng), angle(rng), angle(rng) }));
+        track.addSize(t, { size(rng), size(rng), size(rng) });
+      }
+    }
+    return tracks;
+  }
+}
+
+namespace Starlet::Math::Bench {
+  // Throughput is sampled transforms per second, every pass advances playback by one 60 Hz frame
+  void registerAnimation(Suite& s) {
+    const size_t n = s.options().bulkCount;
+    const std::vector<AnimationTrack> tracks = randomTracks(64);
+    std::vector<AnimationInstance> instances(n);
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> start(0.0f, 1.9f);
+    for (size_t i = 0; i < n; ++i) instances[i] = { &tracks[i % tracks.size()], start(rng), {} };
+    const auto advance = [&instances] {
+      for (AnimationInstance& inst : instances) {
+        inst.time += 1.0f / 60.0f;
+        if (inst.time > 1.9f) inst.time -= 1.9f;
+      }
+    };
+
+    // One object at a time with a fresh binary search per channel
+    std::vector<Mat4> matrices(n);
+    s.run("sample(search every frame) + modelMatrix", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        advance();
+        for (size_t i = 0; i < n; ++i) {
+          TrackCursor fresh;
+          matrices[i] = sample(*instances[i].track, instances[i].time, fresh).modelMatrix();
+        }
+        doNotOptimize(matrices.front());
+      }
+    });
+    s.run("evaluate(Mat4)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        advance();
+        evaluate(instances, matrices.data(), 1);
+        doNotOptimize(matrices.front());
+      }
+    });
+    std::vector<Transform> transforms(n);
+    s.run("evaluate(Transform)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        advance();
+        evaluate(instances, transforms.data(), 1);
+        doNotOptimize(transforms.front());
+      }
+    });
+  }
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Starlet::Math::Bench {
+  // Forces value to be materialised in memory so the work producing it cannot be dropped or hoisted
+  template<typename T>
+  inline void doNotOptimize(T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : "+m"(value) : : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+  }
+
+  // std::vector<bool> hands out proxies, so bool results are stored as bytes
+  template<typename T>
+  using Stored = std::conditional_t<std::is_same_v<T, bool>, unsigned char, T>;
+
+  struct Result {
+    std::string name;
+    std::string mode;     // "latency" or "throughput"
+    size_t opsPerSample;  // operations timed in one sample
+    double nsPerOp;       // median over samples
+    double opsPerSec;
+  };
+
+  struct Options {
+    double minSampleMs = 20.0;
+    int samples = 7;
+    size_t bulkCount = 4096;
+    std::string filter;
+  };
+
+  /*
+  Suite
+  * Each case runs twice, once on a single element (latency) and once over bulkCount elements (throughput)
+  * A run body performs `iterations` passes and must keep its results alive with doNotOptimize
+  */
+  class Suite {
+  public:
+    using Body = std::function<void(size_t iterations)>;
+
+    explicit Suite(Options options) : opts(std::move(options)) {}
+
+    const Options& options() const { return opts; }
+    const std::vector<Result>& results() const { return out; }
+
+    // opsPerIteration is the number of operations one pass of body performs
+    void run(const std::string& name, const std::string& mode, const size_t opsPerIteration, const Body& body) {
+      if (!opts.filter.empty() && name.find(opts.filter) == std::string::npos) return;
+
+      // Grow the iteration count until one sample is long enough to time reliably
+      size_t iterations = 1;
+      for (;;) {
+        const double ms = timeMs(body, iterations);
+        if (ms >= opts.minSampleMs || iterations >= (size_t(1) << 40)) break;
+        const double scale = ms <= 0.0 ? 10.0 : std::min(10.0, 1.2 * opts.minSampleMs / ms);
+        iterations = std::max(iterations + 1, static_cast<size_t>(static_cast<double>(iterations) * scale));
+      }
+
+      std::vector<double> ns;
+      ns.reserve(opts.samples);
+      for (int s = 0; s < opts.samples; ++s)
+        ns.push_back(timeMs(body, iterations) * 1e6 / static_cast<double>(iterations * opsPerIteration));
+      std::sort(ns.begin(), ns.end());
+
+      const double median = ns[ns.size() / 2];
+      out.push_back({ name, mode, iterations * opsPerIteration, median, median > 0.0 ? 1e9 / median : 0.0 });
+    }
+
+    /*
+    Benchmarks fn over each element of inputs, fn(const In&) -> Out
+    */
+    template<typename In, typename Fn>
+    void unary(const std::string& name, const std::vector<In>& inputs, Fn fn) {
+      using Out = Stored<decltype(fn(inputs[0]))>;
+
+      run(name, "latency", 1, [&](const size_t iterations) {
+        In in = inputs[0];
+        for (size_t it = 0; it < iterations; ++it) {
+          doNotOptimize(in);
+          Out r = fn(in);
+          doNotOptimize(r);
+        }
+      });
+
+      std::vector<Out> results(inputs.size());
+      run(name, "throughput", inputs.size(), [&](const size_t iterations) {
+        for (size_t it = 0; it < iterations; ++it) {
+          for (size_t i = 0; i < inputs.size(); ++i) results[i] = fn(inputs[i]);
+          doNotOptimize(results.front());
+        }
+      });
+    }
+
+    /*
+    Benchmarks fn over pairs of elements, fn(const A&, const B&) -> Out
+    */
+    template<typename A, typename B, typename Fn>
+    void binary(const std::string& name, const std::vector<A>& a, const std::vector<B>& b, Fn fn) {
+      using Out = Stored<decltype(fn(a[0], b[0]))>;
+      const size_t n = std::min(a.size(), b.size());
+
+      run(name, "latency", 1, [&](const size_t iterations) {
+        A lhs = a[0];
+        B rhs = b[0];
+        for (size_t it = 0; it < iterations; ++it) {
+          doNotOptimize(lhs);
+          doNotOptimize(rhs);
+          Out r = fn(lhs, rhs);
+          doNotOptimize(r);
+        }
+      });
+
+      std::vector<Out> results(n);
+      run(name, "throughput", n, [&](const size_t iterations) {
+        for (size_t it = 0; it < iterations; ++it) {
+          for (size_t i = 0; i < n; ++i) results[i] = fn(a[i], b[i]);
+          doNotOptimize(results.front());
+        }
+      });
+    }
+
+  private:
+    static double timeMs(const Body& body, const size_t iterations) {
+      const auto start = std::chrono::steady_clock::now();
+      body(iterations);
+      const auto end = std::chrono::steady_clock::now();
+      return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    Options opts;
+    std::vector<Result> out;
+  };
+
+  void registerVec(Suite& suite);
+  void registerMat4(Suite& suite);
+  void registerVertex(Suite& suite);
+  void registerRay(Suite& suite);
+  void registerAnimation(Suite& suite);
+  void registerFrustum(Suite& suite);
+}
@@ -0,0 +1,99 @@
+#include "bench.hpp"
+#include "starlet-math/frustum.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+  struct SceneBounds {
+    std::vector<float> x, y, z, radius;
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+
+    SMath::SphereBoundsSoA spheres() const { return { x, y, z, radius }; }
+    SMath::BoxBoundsSoA boxes() const { return { minX, minY, minZ, maxX, maxY, maxZ }; }
+  };
+
+  // Objects scattered around the camera so roughly a quarter of them survive the cull
+  SceneBounds randomScene(const size_t n, const unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-200.0f, 200.0f), size(0.5f, 4.0f);
+
+    SceneBounds s;
+    for (auto* v : { &s.x, &s.y, &s.z, &s.radius, &s.minX, &s.minY, &s.minZ, &s.maxX, &s.maxY, &s.maxZ }) v->resize(n);
+    for (size_t i = 0; i < n; ++i) {
+      s.x[i] = pos(rng); s.y[i] = pos(rng); s.z[i] = pos(rng);
+      s.radius[i] = size(rng);
+      s.minX[i] = s.x[i] - s.radius[i]; s.minY[i] = s.y[i] - s.radius[i]; s.minZ[i] = s.z[i] - s.radius[i];
+      s.maxX[i] = s.x[i] + s.radius[i]; s.maxY[i] = s.y[i] + s.radius[i]; s.maxZ[i] = s.z[i] + s.radius[i];
+    }
+    return s;
+  }
+}
+
+namespace Starlet::Math::Bench {
+  void registerFrustum(Suite& s) {
+    // Enough objects that the parallel paths split into several ranges
+    const size_t n = s.options().bulkCount * 16;
+    const SceneBounds scene = randomScene(n, 1);
+    const Frustum frustum(Mat4::perspective(60.0f, 16.0f / 9.0f, 0.1f, 500.0f) * Mat4::lookAt({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }));
+    std::vector<std::uint8_t> mask((n + 7) / 8);
+
+    // The loop callers write by hand: every plane against every object, one bit at a time
+    s.run("cullSpheres[scalar loop]", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        for (size_t i = 0; i < n; ++i) {
+          bool inside = true;
+          for (const Vec4<float>& p : frustum.planes)
+            if (p.x * scene.x[i] + p.y * scene.y[i] + p.z * scene.z[i] + p.w < -scene.radius[i]) { inside = false; break; }
+          const std::uint8_t bit = static_cast<std::uint8_t>(1u << (i % 8));
+          mask[i / 8] = inside ? mask[i / 8] | bit : mask[i / 8] & ~bit;
+        }
+        doNotOptimize(mask.front());
+      }
+    });
+    s.run("cullSpheres", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        frustum.cullSpheres(scene.spheres(), mask.data());
+        doNotOptimize(mask.front());
+      }
+    });
+    s.run("cullSpheresParallel", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        frustum.cullSpheresParallel(scene.spheres(), mask.data());
+        doNotOptimize(mask.front());
+      }
+    });
+
+    s.run("cullBoxes[scalar loop]", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        for (size_t i = 0; i < n; ++i) {
+          bool inside = true;
+          for (const Vec4<float>& p : frustum.planes) {
+            const float cx = p.x >= 0.0f ? scene.maxX[i] : scene.minX[i];
+            const float cy = p.y >= 0.0f ? scene.maxY[i] : scene.minY[i];
+            const float cz = p.z >= 0.0f ? scene.maxZ[i] : scene.minZ[i];
+            if (p.x * cx + p.y * cy + p.z * cz + p.w < 0.0f) { inside = false; break; }
+          }
+          const std::uint8_t bit = static_cast<std::uint8_t>(1u << (i % 8));
+          mask[i / 8] = inside ? mask[i / 8] | bit : mask[i / 8] & ~bit;
+        }
+        doNotOptimize(mask.front());
+      }
+    });
+    s.run("cullBoxes", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        frustum.cullBoxes(scene.boxes(), mask.data());
+        doNotOptimize(mask.front());
+      }
+    });
+    s.run("cullBoxesParallel", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        frustum.cullBoxesParallel(scene.boxes(), mask.data());
+        doNotOptimize(mask.front());
+      }
+    });
+  }
+}
@@ -0,0 +1,91 @@
+#include "bench.hpp"
+#include "starlet-math/mat4_kernels.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+  void printUsage(const char* exe) {
+    std::printf(
+      "Usage: %s [options]\n"
+      "  --filter <text>    only run benchmarks whose name contains text\n"
+      "  --json <path>      also write results as JSON ('-' for stdout)\n"
+      "  --min-time <ms>    minimum duration of one sample (default 20)\n"
+      "  --samples <n>      samples per benchmark, the median is reported (default 7)\n"
+      "  --count <n>        elements per throughput pass (default 4096)\n", exe);
+  }
+
+  const char* activeIsaName() {
+    switch (SMath::Kernels::activeIsa) {
+    case SMath::Kernels::Isa::Avx2Fma: return "avx2fma";
+    case SMath::Kernels::Isa::Sse2: return "sse2";
+    default: return "scalar";
+    }
+  }
+
+  void printTable(const SMath::Bench::Suite& suite) {
+    std::printf("%-36s %-11s %12s %16s\n", "benchmark", "mode", "ns/op", "ops/s");
+    for (const auto& r : suite.results())
+      std::printf("%-36s %-11s %12.3f %16.0f\n", r.name.c_str(), r.mode.c_str(), r.nsPerOp, r.opsPerSec);
+  }
+
+  // Benchmark names are plain ASCII without quotes or backslashes, so no escaping is needed
+  bool writeJson(const SMath::Bench::Suite& suite, const std::string& path) {
+    FILE* f = path == "-" ? stdout : std::fopen(path.c_str(), "w");
+    if (!f) return false;
+
+    const auto& opts = suite.options();
+    std::fprintf(f, "{\n  \"isa\": \"%s\",\n  \"samples\": %d,\n  \"minSampleMs\": %g,\n  \"bulkCount\": %zu,\n  \"results\": [\n",
+      activeIsaName(), opts.samples, opts.minSampleMs, opts.bulkCount);
+
+    const auto& results = suite.results();
+    for (size_t i = 0; i < results.size(); ++i) {
+      const auto& r = results[i];
+      std::fprintf(f, "    { \"name\": \"%s\", \"mode\": \"%s\", \"nsPerOp\": %.4f, \"opsPerSec\": %.1f, \"ops\": %zu }%s\n",
+        r.name.c_str(), r.mode.c_str(), r.nsPerOp, r.opsPerSec, r.opsPerSample, i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+
+    if (f != stdout) std::fclose(f);
+    return true;
+  }
+}
+
+int main(int argc, char** argv) {
+  SMath::Bench::Options opts;
+  std::string jsonPath;
+
+  for (int i = 1; i < argc; ++i) {
+    const bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--filter") == 0 && hasValue) opts.filter = argv[++i];
+    else if (std::strcmp(argv[i], "--json") == 0 && hasValue) jsonPath = argv[++i];
+    else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue) opts.minSampleMs = std::atof(argv[++i]);
+    else if (std::strcmp(argv[i], "--samples") == 0 && hasValue) opts.samples = std::max(1, std::atoi(argv[++i]));
+    else if (std::strcmp(argv[i], "--count") == 0 && hasValue) opts.bulkCount = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+    else {
+      printUsage(argv[0]);
+      return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+    }
+  }
+
+  SMath::Bench::Suite suite(opts);
+  SMath::Bench::registerVec(suite);
+  SMath::Bench::registerMat4(suite);
+  SMath::Bench::registerVertex(suite);
+  SMath::Bench::registerRay(suite);
+  SMath::Bench::registerAnimation(suite);
+  SMath::Bench::registerFrustum(suite);
+
+  // Keep stdout clean for the JSON when it goes there
+  if (jsonPath != "-") printTable(suite);
+  if (!jsonPath.empty() && !writeJson(suite, jsonPath)) {
+    std::fprintf(stderr, "Could not write %s\n", jsonPath.c_str());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,194 @@
+#include "bench.hpp"
+#include "starlet-math/mat4.hpp"
+#include "starlet-math/camera.hpp"
+#include "starlet-math/decompose.hpp"
+#include "starlet-math/fast_math.hpp"
+#include "starlet-math/frame_allocator.hpp"
+#include "starlet-math/transform_batch.hpp"
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+  std::vector<SMath::Transform> randomTransforms(const size_t n, const unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> rot(-360.0f, 360.0f);
+    std::uniform_real_distribution<float> size(0.1f, 10.0f);
+
+    std::vector<SMath::Transform> out(n);
+    for (SMath::Transform& t : out) {
+      t.pos = { pos(rng), pos(rng), pos(rng), 1.0f };
+      t.rot = { rot(rng), rot(rng), rot(rng) };
+      t.size = { size(rng), size(rng), size(rng) };
+    }
+    return out;
+  }
+  std::vector<SMath::Mat4> modelMatrices(const std::vector<SMath::Transform>& transforms) {
+    std::vector<SMath::Mat4> out(transforms.size());
+    for (size_t i = 0; i < transforms.size(); ++i) out[i] = SMath::Mat4::modelMatrix(transforms[i]);
+    return out;
+  }
+  std::vector<SMath::Mat4> rigidMatrices(const std::vector<SMath::Transform>& transforms) {
+    std::vector<SMath::Mat4> out(transforms.size());
+    for (size_t i = 0; i < transforms.size(); ++i)
+      out[i] = SMath::Mat4::fromTRS(transforms[i].pos, transforms[i].rot, { 1.0f, 1.0f, 1.0f });
+    return out;
+  }
+  std::vector<float> randomFloats(const size_t n, const float lo, const float hi, const unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> d(lo, hi);
+    std::vector<float> out(n);
+    for (float& f : out) f = d(rng);
+    return out;
+  }
+  std::vector<SMath::Vec3<float>> randomDirections(const size_t n, const unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> d(-1.0f, 1.0f);
+    std::vector<SMath::Vec3<float>> out(n);
+    for (auto& v : out) v = SMath::Vec3<float>{ d(rng), d(rng), d(rng) };
+    return out;
+  }
+
+  const char* isaName(const SMath::Kernels::Isa isa) {
+    switch (isa) {
+    case SMath::Kernels::Isa::Avx2Fma: return "avx2fma";
+    case SMath::Kernels::Isa::Sse2: return "sse2";
+    default: return "scalar";
+    }
+  }
+}
+
+namespace Starlet::Math::Bench {
+  void registerMat4(Suite& s) {
+    const size_t n = s.options().bulkCount;
+    const auto transforms = randomTransforms(n, 1);
+    const auto a = modelMatrices(transforms), b = modelMatrices(randomTransforms(n, 2));
+    const auto rigid = rigidMatrices(transforms);
+    const auto angles = randomFloats(n, -360.0f, 360.0f, 3);
+    const auto eyes = randomDirections(n, 4), fronts = randomDirections(n, 5);
+
+    std::vector<Vec4<float>> points(n);
+    for (size_t i = 0; i < n; ++i) points[i] = { transforms[i].pos.x, transforms[i].pos.y, transforms[i].pos.z, 1.0f };
+
+    s.unary("Mat4::identity", angles, [](float) { return Mat4::identity(); });
+    s.unary("Mat4::modelMatrix", transforms, [](const Transform& t) { return Mat4::modelMatrix(t); });
+    s.unary("Mat4::translation", points, [](const Vec4<float>& p) { return Mat4::translation(p); });
+    s.unary("Mat4::size", transforms, [](const Transform& t) { return Mat4::size(t.size); });
+    s.unary("Mat4::rotateX", angles, [](const float deg) { return Mat4::rotateX(deg); });
+    s.unary("Mat4::rotateY", angles, [](const float deg) { return Mat4::rotateY(deg); });
+    s.unary("Mat4::rotateZ", angles, [](const float deg) { return Mat4::rotateZ(deg); });
+    s.binary("Mat4::lookAt", eyes, fronts, [](const Vec3<float>& eye, const Vec3<float>& front) { return Mat4::lookAt(eye, front); });
+    s.unary("Mat4::perspective", angles, [](const float deg) { return Mat4::perspective(30.0f + std::fabs(deg) * 0.25f, 16.0f / 9.0f, 0.1f, 1000.0f); });
+
+    s.unary("Fast::fromTRS", transforms, [](const Transform& t) { return Fast::fromTRS(t); });
+    s.unary("Fast::rotateX", angles, [](const float deg) { return Fast::rotateX(deg); });
+    s.unary("Fast::perspective", angles, [](const float deg) { return Fast::perspective(30.0f + std::fabs(deg) * 0.25f, 16.0f / 9.0f, 0.1f, 1000.0f); });
+
+    s.unary("Mat4::transpose", a, [](const Mat4& m) { return m.transpose(); });
+    s.unary("Mat4::inverse", a, [](const Mat4& m) { return m.inverse(); });
+    s.unary("Mat4::inverseAffine", a, [](const Mat4& m) { return m.inverseAffine(); });
+    s.unary("Mat4::inverseRigid", rigid, [](const Mat4& m) { return m.inverseRigid(); });
+    s.unary("Mat4::normalMatrix", a, [](const Mat4& m) { return m.normalMatrix(); });
+    s.unary("Mat4::normalCofactors", a, [](const Mat4& m) { return m.normalCofactors(); });
+    s.unary("Mat4::isAffine", a, [](const Mat4& m) { return m.isAffine(); });
+    s.unary("Mat4::decompose", a, [](const Mat4& m) { return m.decompose(); });
+    s.unary("decomposePolar", a, [](const Mat4& m) { return decomposePolar(m); });
+
+    s.binary("Mat4::operator*(Mat4)", a, b, [](const Mat4& l, const Mat4& r) { return l * r; });
+    s.binary("Mat4::operator*=", a, b, [](Mat4 l, const Mat4& r) { return l *= r; });
+    s.binary("Mat4::operator*(Vec4)", a, points, [](const Mat4& m, const Vec4<float>& v) { return m * v; });
+    const std::vector<Vec4f> points4(points.begin(), points.end());
+    s.binary("Mat4::operator*(Vec4f)", a, points4, [](const Mat4& m, const Vec4f& v) { return m * v; });
+    s.binary("Mat4::operator==", a, b, [](const Mat4& l, const Mat4& r) { return l == r; });
+
+    // Every multiply kernel this CPU can run, independent of the startup dispatch
+    for (const Kernels::Isa isa : { Kernels::Isa::Scalar, Kernels::Isa::Sse2, Kernels::Isa::Avx2Fma }) {
+      if (!Kernels::isaSupported(isa)) continue;
+      s.binary(std::string("Kernels::mul[") + isaName(isa) + "]", a, b, [isa](const Mat4& l, const Mat4& r) {
+        Mat4 out;
+        Kernels::mul(l.models, r.models, out.models, isa);
+        return out;
+      });
+    }
+
+    std::vector<Mat4> inverted(n);
+    for (const Kernels::Isa isa : { Kernels::Isa::Scalar, Kernels::Isa::Sse2, Kernels::Isa::Avx2Fma }) {
+      if (!Kernels::isaSupported(isa)) continue;
+      s.run(std::string("Mat4::inverseBatch[") + isaName(isa) + "]", "throughput", n, [&](const size_t iterations) {
+        for (size_t it = 0; it < iterations; ++it) {
+          Mat4::inverseBatch(a.data(), inverted.data(), n, isa);
+          doNotOptimize(inverted.front());
+        }
+      });
+    }
+
+    TransformBatch batch;
+    for (const Transform& t : transforms) batch.push(t);
+    std::vector<Mat4> models(n);
+    s.run("buildModelMatrices", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        buildModelMatrices(batch, models.data());
+        doNotOptimize(models.front());
+      }
+    });
+
+    TransformBatch eulers;
+    s.run("decomposeBatch(Euler)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        decomposeBatch(a, eulers);
+        doNotOptimize(eulers.rotX.front());
+      }
+    });
+    // Per-frame camera matrices: rebuilt from scratch, versus the cached camera when nothing moved
+    s.unary("lookAt * perspective (rebuilt)", eyes, [](const Vec3<float>& eye) {
+      return Mat4::perspective(DEFAULT_FOV, 16.0f / 9.0f, NEAR_PLANE, FAR_PLANE) * Mat4::lookAt(eye, { 0.0f, 0.0f, -1.0f });
+    });
+    Camera camera;
+    camera.setViewport(1920.0f, 1080.0f);
+    s.unary("Camera::viewProjection (unchanged)", eyes, [&camera](const Vec3<float>&) { return camera.viewProjection(); });
+
+    std::vector<Vec3<float>> worldPoints(n), screenPoints(n);
+    for (size_t i = 0; i < n; ++i) worldPoints[i] = { points[i].x, points[i].y, points[i].z };
+    s.unary("project point (scalar)", worldPoints, [&camera](const Vec3<float>& p) {
+      const Vec4<float> clip = camera.viewProjection() * Vec4<float>{ p.x, p.y, p.z, 1.0f };
+      return Vec3<float>{ (clip.x / clip.w * 0.5f + 0.5f) * 1920.0f, (0.5f - clip.y / clip.w * 0.5f) * 1080.0f, clip.z / clip.w };
+    });
+    s.run("Camera::worldToScreen", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        camera.worldToScreen(worldPoints, screenPoints);
+        doNotOptimize(screenPoints.front());
+      }
+    });
+
+    // Per-frame instance scratch: a fresh vector each frame against a bump from the frame ring
+    s.run("scratch Mat4 (std::vector)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        std::vector<Mat4> scratch(n);
+        for (size_t i = 0; i < n; ++i) scratch[i] = a[i];
+        doNotOptimize(scratch.back());
+      }
+    });
+    FrameAllocator<> frames(n * sizeof(Mat4));
+    s.run("scratch Mat4 (FrameAllocator)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        frames.beginFrame();
+        const std::span<Mat4> scratch = frames.allocate<Mat4>(n);
+        for (size_t i = 0; i < n; ++i) scratch[i] = a[i];
+        doNotOptimize(scratch.back());
+      }
+    });
+
+    QuatTransformBatch quats;
+    s.run("decomposeBatch(Quat)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        decomposeBatch(a, quats);
+        doNotOptimize(quats.rotW.front());
+      }
+    });
+  }
+}
@@ -0,0 +1,94 @@
+#include "bench.hpp"
+#include "starlet-math/ray.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+  const char* isaName(const SMath::Kernels::Isa isa) {
+    switch (isa) {
+    case SMath::Kernels::Isa::Avx2Fma: return "Avx2Fma";
+    case SMath::Kernels::Isa::Sse2: return "Sse2";
+    default: return "Scalar";
+    }
+  }
+
+  void randomSoup(const size_t triangles, const float extent, std::vector<SMath::Vertex>& vertices, std::vector<std::uint32_t>& indices) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> center(-extent, extent), offset(-1.0f, 1.0f);
+    for (size_t t = 0; t < triangles; ++t) {
+      const SMath::Vec3<float> c{ center(rng), center(rng), center(rng) };
+      for (int k = 0; k < 3; ++k) {
+        SMath::Vertex v;
+        v.pos = c + SMath::Vec3<float>(offset(rng), offset(rng), offset(rng));
+        indices.push_back(static_cast<std::uint32_t>(vertices.size()));
+        vertices.push_back(v);
+      }
+    }
+  }
+
+  // Coherent rays from one eye point through a grid, like a picking or visibility sweep
+  std::vector<SMath::Ray> gridRays(const size_t n, const float extent) {
+    std::vector<SMath::Ray> rays(n);
+    const size_t side = std::max<size_t>(1, static_cast<size_t>(std::sqrt(static_cast<double>(n))));
+    for (size_t i = 0; i < n; ++i) {
+      const float x = (static_cast<float>(i % side) / side * 2.0f - 1.0f) * extent;
+      const float y = (static_cast<float>(i / side % side) / side * 2.0f - 1.0f) * extent;
+      rays[i].origin = { 0.0f, 0.0f, 3.0f * extent };
+      rays[i].dir = SMath::Vec3<float>(x, y, -3.0f * extent).normalized();
+    }
+    return rays;
+  }
+}
+
+namespace Starlet::Math::Bench {
+  // Throughput is rays per second
+  void registerRay(Suite& s) {
+    constexpr size_t SoupTriangles = 256;
+    std::vector<Vertex> vertices;
+    std::vector<std::uint32_t> indices;
+    randomSoup(SoupTriangles, 10.0f, vertices, indices);
+    const std::vector<TrianglePacket> packets = packTriangles(vertices, indices);
+    const auto rays = gridRays(s.options().bulkCount, 10.0f);
+
+    // The loop callers write by hand: Moller-Trumbore on Vec3 per triangle
+    s.unary("raycast(256 tris)[scalar loop]", rays, [&](const Ray& ray) {
+      RayHit best;
+      best.t = ray.tMax;
+      for (std::uint32_t tri = 0; tri < SoupTriangles; ++tri) {
+        Ray clipped = ray;
+        clipped.tMax = best.t;
+        float t, u, v;
+        if (intersectTriangle(clipped, vertices[indices[tri * 3]].pos, vertices[indices[tri * 3 + 1]].pos, vertices[indices[tri * 3 + 2]].pos, t, u, v))
+          best = { t, u, v, tri };
+      }
+      return best;
+    });
+    for (const Kernels::Isa isa : { Kernels::Isa::Scalar, Kernels::Isa::Sse2, Kernels::Isa::Avx2Fma }) {
+      if (!Kernels::isaSupported(isa)) continue;
+      s.unary(std::string("raycast(256 tris)[packets ") + isaName(isa) + "]", rays, [&, isa](const Ray& ray) { return raycast(packets, ray, isa); });
+    }
+
+    std::vector<Vertex> sceneVertices;
+    std::vector<std::uint32_t> sceneIndices;
+    randomSoup(100000, 50.0f, sceneVertices, sceneIndices);
+    const MeshRaycaster rc = MeshRaycaster::build(sceneVertices, sceneIndices);
+    const auto sceneRays = gridRays(s.options().bulkCount, 50.0f);
+
+    s.unary("MeshRaycaster::raycast(100k tris)", sceneRays, [&](const Ray& ray) { return rc.raycast(ray); });
+    s.unary("MeshRaycaster::occluded(100k tris)", sceneRays, [&](const Ray& ray) { return rc.occluded(ray); });
+    std::vector<RayHit> hits(sceneRays.size());
+    s.run("MeshRaycaster::raycast(100k tris, packets of 4)", "throughput", sceneRays.size(), [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        rc.raycast(sceneRays, hits);
+        doNotOptimize(hits.front());
+      }
+    });
+  }
+}
@@ -0,0 +1,122 @@
+#include "bench.hpp"
+#include "starlet-math/vec2.hpp"
+#include "starlet-math/vec3.hpp"
+#include "starlet-math/vec4.hpp"
+#include "starlet-math/fast_math.hpp"
+#include "starlet-math/vec_batch.hpp"
+#include "starlet-math/vec4f.hpp"
+#include "starlet-math/vec_expr.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+  template<typename V> V randomVec(std::mt19937& rng);
+
+  template<> SMath::Vec2<float> randomVec(std::mt19937& rng) {
+    std::uniform_real_distribution<float> d(-100.0f, 100.0f);
+    return { d(rng), d(rng) };
+  }
+  template<> SMath::Vec3<float> randomVec(std::mt19937& rng) {
+    std::uniform_real_distribution<float> d(-100.0f, 100.0f);
+    return { d(rng), d(rng), d(rng) };
+  }
+  template<> SMath::Vec4<float> randomVec(std::mt19937& rng) {
+    std::uniform_real_distribution<float> d(-100.0f, 100.0f);
+    return { d(rng), d(rng), d(rng), d(rng) };
+  }
+
+  template<typename V>
+  std::vector<V> randomVecs(const size_t n, const unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<V> out(n);
+    for (V& v : out) v = randomVec<V>(rng);
+    return out;
+  }
+
+  // Everything Vec2, Vec3 and Vec4 have in common
+  template<typename V>
+  void registerCommon(SMath::Bench::Suite& s, const std::string& type) {
+    const size_t n = s.options().bulkCount;
+    const auto a = randomVecs<V>(n, 1), b = randomVecs<V>(n, 2);
+    const std::vector<float> k(n, 1.5f);
+
+    s.unary(type + "::length", a, [](const V& v) { return v.length(); });
+    s.unary(type + "::lengthSquared", a, [](const V& v) { return v.lengthSquared(); });
+    s.unary(type + "::normalized", a, [](const V& v) { return v.normalized(); });
+    s.unary(type + "::operator-()", a, [](const V& v) { return -v; });
+    s.binary(type + "::dot", a, b, [](const V& l, const V& r) { return l.dot(r); });
+
+    s.binary(type + "::operator+", a, b, [](const V& l, const V& r) { return l + r; });
+    s.binary(type + "::operator-", a, b, [](const V& l, const V& r) { return l - r; });
+    s.binary(type + "::operator*", a, b, [](const V& l, const V& r) { return l * r; });
+    s.binary(type + "::operator/", a, b, [](const V& l, const V& r) { return l / r; });
+    s.binary(type + "::operator+(scalar)", a, k, [](const V& l, const float r) { return l + r; });
+    s.binary(type + "::operator-(scalar)", a, k, [](const V& l, const float r) { return l - r; });
+    s.binary(type + "::operator*(scalar)", a, k, [](const V& l, const float r) { return l * r; });
+    s.binary(type + "::operator/(scalar)", a, k, [](const V& l, const float r) { return l / r; });
+
+    s.binary(type + "::operator+=", a, b, [](V l, const V& r) { return l += r; });
+    s.binary(type + "::operator-=", a, b, [](V l, const V& r) { return l -= r; });
+    s.binary(type + "::operator*=", a, b, [](V l, const V& r) { return l *= r; });
+    s.binary(type + "::operator/=", a, b, [](V l, const V& r) { return l /= r; });
+    s.binary(type + "::operator+=(scalar)", a, k, [](V l, const float r) { return l += r; });
+    s.binary(type + "::operator-=(scalar)", a, k, [](V l, const float r) { return l -= r; });
+    s.binary(type + "::operator*=(scalar)", a, k, [](V l, const float r) { return l *= r; });
+    s.binary(type + "::operator/=(scalar)", a, k, [](V l, const float r) { return l /= r; });
+    s.binary(type + "::operator==", a, b, [](const V& l, const V& r) { return l == r; });
+    s.binary(type + "::operator!=", a, b, [](const V& l, const V& r) { return l != r; });
+  }
+}
+
+namespace Starlet::Math::Bench {
+  void registerVec(Suite& s) {
+    registerCommon<Vec2<float>>(s, "Vec2");
+    registerCommon<Vec3<float>>(s, "Vec3");
+    registerCommon<Vec4<float>>(s, "Vec4");
+
+    const size_t n = s.options().bulkCount;
+    const auto a = randomVecs<Vec3<float>>(n, 3), b = randomVecs<Vec3<float>>(n, 4);
+    s.binary("Vec3::cross", a, b, [](const Vec3<float>& l, const Vec3<float>& r) { return l.cross(r); });
+    s.unary("Fast::normalized(Vec3)", a, [](const Vec3<float>& v) { return Fast::normalized(v); });
+    s.unary("Fast::length(Vec3)", a, [](const Vec3<float>& v) { return Fast::length(v); });
+
+    const auto a4 = randomVecs<Vec4<float>>(n, 5), b4 = randomVecs<Vec4<float>>(n, 6);
+    const std::vector<Vec4f> fa(a4.begin(), a4.end()), fb(b4.begin(), b4.end());
+    s.binary("Vec4f::operator+", fa, fb, [](const Vec4f& l, const Vec4f& r) { return l + r; });
+    s.binary("Vec4f::dot", fa, fb, [](const Vec4f& l, const Vec4f& r) { return l.dot(r); });
+    s.unary("Vec4f::normalized", fa, [](const Vec4f& v) { return v.normalized(); });
+
+    std::vector<float> lengths(n);
+    std::vector<Vec3<float>> normalized(n);
+    s.run("lengthAll(Vec3)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        lengthAll(a, lengths);
+        doNotOptimize(lengths.front());
+      }
+    });
+    s.run("normalizeAll(Vec3)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        normalizeAll(a, normalized);
+        doNotOptimize(normalized.front());
+      }
+    });
+
+    // Same a * 0.5 + b - a / b per element, temporaries per operator against one fused pass
+    s.run("a * s + b - a / b (operators)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        for (size_t i = 0; i < n; ++i) normalized[i] = a[i] * 0.5f + b[i] - a[i] / b[i];
+        doNotOptimize(normalized.front());
+      }
+    });
+    s.run("a * s + b - a / b (Expr::assign)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        Expr::assign(normalized, Expr::lazy(a) * 0.5f + b - Expr::lazy(a) / b);
+        doNotOptimize(normalized.front());
+      }
+    });
+  }
+}
@@ -0,0 +1,150 @@
+#include "bench.hpp"
+#include "starlet-math/binary_archive.hpp"
+#include "starlet-math/mesh_normals.hpp"
+#include "starlet-math/vertex_packed.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+  std::vector<SMath::Vertex> randomVertices(const size_t n, const unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-100.0f, 100.0f), unit(0.0f, 1.0f), dir(-1.0f, 1.0f);
+
+    std::vector<SMath::Vertex> out(n);
+    for (SMath::Vertex& v : out) {
+      v.pos = { pos(rng), pos(rng), pos(rng) };
+      v.col = { unit(rng), unit(rng), unit(rng), unit(rng) };
+      v.norm = SMath::Vec3<float>(dir(rng), dir(rng), dir(rng)).normalized();
+      v.texCoord = { unit(rng), unit(rng) };
+    }
+    return out;
+  }
+
+  // Wavy grid of about `triangles` counter-clockwise triangles
+  void makeGrid(const size_t triangles, std::vector<SMath::Vertex>& vertices, std::vector<std::uint32_t>& indices) {
+    const std::uint32_t n = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(std::sqrt(static_cast<double>(triangles) / 2.0)));
+    vertices.assign(static_cast<size_t>(n + 1) * (n + 1), {});
+    for (std::uint32_t y = 0; y <= n; ++y)
+      for (std::uint32_t x = 0; x <= n; ++x) {
+        SMath::Vertex& v = vertices[y * (n + 1) + x];
+        v.pos = { static_cast<float>(x), static_cast<float>(y), std::sin(0.1f * static_cast<float>(x + y)) };
+        v.texCoord = { static_cast<float>(x) / n, static_cast<float>(y) / n };
+      }
+
+    indices.clear();
+    for (std::uint32_t y = 0; y < n; ++y)
+      for (std::uint32_t x = 0; x < n; ++x) {
+        const std::uint32_t i = y * (n + 1) + x;
+        indices.insert(indices.end(), { i, i + 1, i + n + 2, i, i + n + 2, i + n + 1 });
+      }
+  }
+}
+
+namespace Starlet::Math::Bench {
+  // Throughput is vertices per second, multiply by sizeof(Vertex) for input bandwidth
+  void registerVertex(Suite& s) {
+    const size_t n = s.options().bulkCount;
+    const auto vertices = randomVertices(n, 1);
+    const AABB bounds = AABB::fromVertices(vertices);
+
+    s.unary("Packing::pack(Vertex)", vertices, [](const Vertex& v) { return Packing::pack(v); });
+
+    std::vector<PackedVertex> packed(n);
+    std::vector<QuantizedVertex> quantized(n);
+    std::vector<Vertex> unpacked(n);
+    s.run("packVertices(PackedVertex)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        packVertices(vertices, packed);
+        doNotOptimize(packed.front());
+      }
+    });
+    s.run("unpackVertices(PackedVertex)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        unpackVertices(packed, unpacked);
+        doNotOptimize(unpacked.front());
+      }
+    });
+    s.run("packVertices(QuantizedVertex)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        packVertices(vertices, bounds, quantized);
+        doNotOptimize(quantized.front());
+      }
+    });
+    s.run("unpackVertices(QuantizedVertex)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        unpackVertices(quantized, bounds, unpacked);
+        doNotOptimize(unpacked.front());
+      }
+    });
+
+    // Mesh passes count triangles per second
+    std::vector<Vertex> mesh;
+    std::vector<std::uint32_t> indices;
+    makeGrid(n, mesh, indices);
+    const size_t triangles = indices.size() / 3;
+    const VertexAdjacency adjacency = VertexAdjacency::build(mesh.size(), indices);
+    std::vector<Vec4<float>> tangents(mesh.size());
+
+    s.run("VertexAdjacency::build", "throughput", triangles, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        VertexAdjacency built = VertexAdjacency::build(mesh.size(), indices);
+        doNotOptimize(built.corners.front());
+      }
+    });
+    s.run("computeNormals(Area)", "throughput", triangles, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        computeNormals(mesh, indices, adjacency, NormalWeighting::Area);
+        doNotOptimize(mesh.front());
+      }
+    });
+    s.run("computeNormals(Angle)", "throughput", triangles, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        computeNormals(mesh, indices, adjacency, NormalWeighting::Angle);
+        doNotOptimize(mesh.front());
+      }
+    });
+    s.run("computeTangents", "throughput", triangles, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        computeTangents(mesh, indices, adjacency, tangents);
+        doNotOptimize(tangents.front());
+      }
+    });
+
+    // Loading a vertex stream back: parsing the text operator<< output against a mapped, verified archive chunk
+    std::ostringstream text;
+    for (const Vertex& v : vertices) text << v.pos << ' ' << v.col << ' ' << v.norm << ' ' << v.texCoord.x << ' ' << v.texCoord.y << '\n';
+    const std::string textData = text.str();
+    s.run("load Vertex (text)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        std::istringstream in(textData);
+        for (Vertex& v : unpacked)
+          in >> v.pos.x >> v.pos.y >> v.pos.z >> v.col.x >> v.col.y >> v.col.z >> v.col.w
+             >> v.norm.x >> v.norm.y >> v.norm.z >> v.texCoord.x >> v.texCoord.y;
+        doNotOptimize(unpacked.back());
+      }
+    });
+    const std::string archivePath = (std::filesystem::temp_directory_path() / "starlet_math_bench.smb").string();
+    {
+      ArchiveWriter writer(archivePath);
+      writer.writeChunk(vertices);
+      writer.finish();
+    }
+    s.run("load Vertex (MappedArchive)", "throughput", n, [&](const size_t iterations) {
+      for (size_t it = 0; it < iterations; ++it) {
+        const MappedArchive archive(archivePath);
+        Vertex last = archive.get<Vertex>(0).back();
+        doNotOptimize(last);
+      }
+    });
+    std::filesystem::remove(archivePath);
+  }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace Starlet::Math {
+  /*
+  AlignedAllocator
+  * std::allocator replacement that over-aligns every block
+  * Defaults to a cache line so SIMD loads never straddle one at the start of a lane
+  */
+  template<typename T, size_t Alignment = 64>
+  struct AlignedAllocator {
+    static_assert(Alignment >= alignof(T), "alignment must satisfy the element type");
+    using value_type = T;
+
+    template<typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    constexpr AlignedAllocator() noexcept = default;
+    template<typename U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(const size_t n) {
+      return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, size_t) noexcept {
+      ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+  };
+
+  template<typename T, size_t Alignment = 64>
+  using AlignedVector = std::vector<T, AlignedAllocator<T, Alignment>>;
+}
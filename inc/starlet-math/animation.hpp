@@ -0,0 +1,268 @@
+#pragma once
+
+#include "fast_math.hpp"
+#include "mat4.hpp"
+#include "parallel.hpp"
+#include "quat.hpp"
+#include "simd.hpp"
+#include "transform.hpp"
+#include "vec3.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Starlet::Math {
+  /*
+  KeyframeChannel
+  * Keyframe times plus one value lane per component, N = 3 for vectors and 4 for quaternions
+  * Times must be added in increasing order
+  */
+  template<size_t N>
+  struct KeyframeChannel {
+    std::vector<float> times;
+    std::array<std::vector<float>, N> values;
+
+    size_t keyCount() const { return times.size(); }
+    bool empty() const { return times.empty(); }
+
+    void add(const float time, const std::array<float, N>& value) {
+      assert(times.empty() || time > times.back());
+      times.push_back(time);
+      for (size_t c = 0; c < N; ++c) values[c].push_back(value[c]);
+    }
+  };
+
+  /*
+  AnimationTrack
+  * One animated transform: independent position, rotation and size channels
+  * Empty channels sample as the identity, one key holds its value for all time
+  * Sampling clamps to the first and last key, wrap or ping-pong the time before sampling for looping clips
+  */
+  struct AnimationTrack {
+    KeyframeChannel<3> position;
+    KeyframeChannel<4> rotation;
+    KeyframeChannel<3> size;
+
+    void addPosition(const float time, const Vec3<float>& p) { position.add(time, { p.x, p.y, p.z }); }
+    void addSize(const float time, const Vec3<float>& s) { size.add(time, { s.x, s.y, s.z }); }
+    // Stored on the previous key's hemisphere, so sampling can blend without a sign test
+    void addRotation(const float time, const Quat<float>& q) {
+      Quat<float> r = q.normalized();
+      if (!rotation.empty()) {
+        const size_t last = rotation.keyCount() - 1;
+        const Quat<float> prev{ rotation.values[0][last], rotation.values[1][last], rotation.values[2][last], rotation.values[3][last] };
+        if (prev.dot(r) < 0.0f) r = { -r.x, -r.y, -r.z, -r.w };
+      }
+      rotation.add(time, { r.x, r.y, r.z, r.w });
+    }
+
+    float duration() const {
+      float end = 0.0f;
+      if (!position.empty()) end = std::max(end, position.times.back());
+      if (!rotation.empty()) end = std::max(end, rotation.times.back());
+      if (!size.empty()) end = std::max(end, size.times.back());
+      return end;
+    }
+  };
+
+  /*
+  TrackCursor
+  * Last key pair used per channel, playback that moves forward (or stays put) finds its keys without searching
+  * Any cursor is valid for any track, a stale one only costs a binary search
+  */
+  struct TrackCursor {
+    std::uint32_t position = 0, rotation = 0, size = 0;
+  };
+
+  /*
+  AnimationInstance
+  * One track being played, many instances may share a track
+  */
+  struct AnimationInstance {
+    const AnimationTrack* track = nullptr;
+    float time = 0.0f;
+    TrackCursor cursor{};
+  };
+
+  namespace Detail {
+    // Index k with times[k] <= t < times[k + 1] (clamped to the ends) and the blend factor into k + 1.
+    // Tries the cached key and its successor before falling back to a binary search.
+    inline std::uint32_t locateKey(const std::vector<float>& times, const float t, std::uint32_t& cursor, float& alpha) {
+      const size_t n = times.size();
+      if (n < 2 || t <= times[0]) { cursor = 0; alpha = 0.0f; return 0; }
+      if (t >= times[n - 1]) { cursor = static_cast<std::uint32_t>(n - 2); alpha = 1.0f; return cursor; }
+
+      size_t k = cursor;
+      if (k + 1 >= n || t < times[k]) k = std::upper_bound(times.begin(), times.end(), t) - times.begin() - 1;
+      else if (t >= times[k + 1]) {
+        if (k + 2 < n && t < times[k + 2]) ++k;
+        else k = std::upper_bound(times.begin() + k + 1, times.end(), t) - times.begin() - 1;
+      }
+
+      cursor = static_cast<std::uint32_t>(k);
+      alpha = (t - times[k]) / (times[k + 1] - times[k]);
+      return cursor;
+    }
+
+    // Keyframe pairs for four instances in lanes, a[c][l] and b[c][l] are component c of lane l
+    template<size_t N>
+    struct ChannelLanes4 {
+      alignas(16) float a[N][4];
+      alignas(16) float b[N][4];
+      alignas(16) float alpha[4];
+
+      void gather(const KeyframeChannel<N>& channel, const int lane, const float t, std::uint32_t& cursor, const std::array<float, N>& fallback) {
+        if (channel.empty()) {
+          for (size_t c = 0; c < N; ++c) a[c][lane] = b[c][lane] = fallback[c];
+          alpha[lane] = 0.0f;
+          return;
+        }
+        const std::uint32_t k = locateKey(channel.times, t, cursor, alpha[lane]);
+        const std::uint32_t next = std::min<std::uint32_t>(k + 1, static_cast<std::uint32_t>(channel.keyCount() - 1));
+        for (size_t c = 0; c < N; ++c) {
+          a[c][lane] = channel.values[c][k];
+          b[c][lane] = channel.values[c][next];
+        }
+      }
+      void fill(const int lane, const std::array<float, N>& value) {
+        for (size_t c = 0; c < N; ++c) a[c][lane] = b[c][lane] = value[c];
+        alpha[lane] = 0.0f;
+      }
+      Simd::Float4 blend(const size_t c) const {
+        const Simd::Float4 va = Simd::Float4::loadAligned(a[c]), vb = Simd::Float4::loadAligned(b[c]);
+        return Simd::madd(vb - va, Simd::Float4::loadAligned(alpha), va);
+      }
+    };
+
+    struct SampledLanes4 {
+      Simd::Float4 pos[3], rot[4], size[3];
+    };
+
+    // Samples instances[0, n), n <= 4, padding the unused lanes with the identity
+    inline SampledLanes4 sampleLanes4(AnimationInstance* instances, const size_t n) {
+      using Simd::Float4;
+      constexpr std::array<float, 3> zero3{ 0.0f, 0.0f, 0.0f }, one3{ 1.0f, 1.0f, 1.0f };
+      constexpr std::array<float, 4> identity{ 0.0f, 0.0f, 0.0f, 1.0f };
+
+      ChannelLanes4<3> pos, size;
+      ChannelLanes4<4> rot;
+      for (int l = 0; l < 4; ++l) {
+        if (static_cast<size_t>(l) >= n) {
+          pos.fill(l, zero3); rot.fill(l, identity); size.fill(l, one3);
+          continue;
+        }
+        AnimationInstance& inst = instances[l];
+        assert(inst.track);
+        pos.gather(inst.track->position, l, inst.time, inst.cursor.position, zero3);
+        rot.gather(inst.track->rotation, l, inst.time, inst.cursor.rotation, identity);
+        size.gather(inst.track->size, l, inst.time, inst.cursor.size, one3);
+      }
+
+      SampledLanes4 s;
+      for (size_t c = 0; c < 3; ++c) {
+        s.pos[c] = pos.blend(c);
+        s.size[c] = size.blend(c);
+      }
+      // Keys share a hemisphere (see addRotation), so nlerp needs no flip here
+      for (size_t c = 0; c < 4; ++c) s.rot[c] = rot.blend(c);
+      const Float4 len = Simd::sqrt(s.rot[0] * s.rot[0] + s.rot[1] * s.rot[1] + s.rot[2] * s.rot[2] + s.rot[3] * s.rot[3]);
+      const Float4 inv = Float4::splat(1.0f) / len;
+      for (size_t c = 0; c < 4; ++c) s.rot[c] = s.rot[c] * inv;
+      return s;
+    }
+
+    // translation * rotation * size for four sampled lanes, same layout as QuatTransform::modelMatrix
+    inline void storeModelMatrices4(const SampledLanes4& s, Mat4* out, const size_t n) {
+      using Simd::Float4;
+      const Float4 one = Float4::splat(1.0f), two = Float4::splat(2.0f), zero = Float4::splat(0.0f);
+      const Float4 x = s.rot[0], y = s.rot[1], z = s.rot[2], w = s.rot[3];
+      const Float4 xx = x * x, yy = y * y, zz = z * z;
+      const Float4 xy = x * y, xz = x * z, yz = y * z;
+      const Float4 wx = w * x, wy = w * y, wz = w * z;
+
+      Float4 e[16] = {
+        (one - two * (yy + zz)) * s.size[0], two * (xy + wz) * s.size[0], two * (xz - wy) * s.size[0], zero,
+        two * (xy - wz) * s.size[1], (one - two * (xx + zz)) * s.size[1], two * (yz + wx) * s.size[1], zero,
+        two * (xz + wy) * s.size[2], two * (yz - wx) * s.size[2], (one - two * (xx + yy)) * s.size[2], zero,
+        s.pos[0], s.pos[1], s.pos[2], one
+      };
+
+      Mat4 tail[4];
+      Mat4* dst = n == 4 ? out : tail;
+      for (int col = 0; col < 4; ++col) {
+        Float4* c = e + col * 4;
+        Simd::transpose(c[0], c[1], c[2], c[3]);
+        for (int l = 0; l < 4; ++l) c[l].store(dst[l].models + col * 4);
+      }
+      if (n != 4) std::copy(tail, tail + n, out);
+    }
+
+    // Euler degrees in the Mat4::fromTRS convention, the batched form of Quat::toEuler
+    inline void storeTransforms4(const SampledLanes4& s, Transform* out, const size_t n) {
+      using Simd::Float4;
+      const Float4 one = Float4::splat(1.0f), two = Float4::splat(2.0f), zero = Float4::splat(0.0f);
+      const Float4 x = s.rot[0], y = s.rot[1], z = s.rot[2], w = s.rot[3];
+
+      const Float4 m0 = one - two * (y * y + z * z), m1 = two * (x * y + w * z);
+      const Float4 m4 = two * (x * y - w * z), m5 = one - two * (x * x + z * z);
+      const Float4 m8 = two * (x * z + w * y), m9 = two * (y * z - w * x), m10 = one - two * (x * x + y * y);
+
+      const Float4 cosY = Simd::sqrt(m0 * m0 + m4 * m4);
+      const Float4 locked = cosY <= Float4::splat(1e-6f);
+      const Float4 toDegrees = Float4::splat(RAD_TO_DEG);
+      const Float4 rotY = Fast::atan2(-m8, cosY) * toDegrees;
+      const Float4 rotX = Fast::atan2(Simd::select(locked, m1 * m8, -m9), Simd::select(locked, m5, m10)) * toDegrees;
+      const Float4 rotZ = Simd::select(locked, zero, Fast::atan2(-m4, m0) * toDegrees);
+
+      for (size_t l = 0; l < n; ++l) {
+        const int lane = static_cast<int>(l);
+        out[l].pos = { s.pos[0].lane(lane), s.pos[1].lane(lane), s.pos[2].lane(lane), 1.0f };
+        out[l].rot = { rotX.lane(lane), rotY.lane(lane), rotZ.lane(lane) };
+        out[l].size = { s.size[0].lane(lane), s.size[1].lane(lane), s.size[2].lane(lane) };
+      }
+    }
+
+    template<typename Out, typename Store>
+    inline void evaluateInstances(std::span<AnimationInstance> instances, Out* out, Store store, const unsigned threads) {
+      // Multiple of four, so only the final range has a partial block
+      constexpr size_t Grain = 256;
+      parallelFor(instances.size(), Grain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i += 4) {
+          const size_t n = std::min<size_t>(4, end - i);
+          store(sampleLanes4(&instances[i], n), out + i, n);
+        }
+      }, threads);
+    }
+  }
+
+  // Single-instance reference path, same result as the batched evaluate
+  inline QuatTransform sample(const AnimationTrack& track, const float time, TrackCursor& cursor) {
+    AnimationInstance inst{ &track, time, cursor };
+    const Detail::SampledLanes4 s = Detail::sampleLanes4(&inst, 1);
+    cursor = inst.cursor;
+
+    QuatTransform t;
+    t.pos = { s.pos[0].lane(0), s.pos[1].lane(0), s.pos[2].lane(0), 1.0f };
+    t.rot = { s.rot[0].lane(0), s.rot[1].lane(0), s.rot[2].lane(0), s.rot[3].lane(0) };
+    t.size = { s.size[0].lane(0), s.size[1].lane(0), s.size[2].lane(0) };
+    return t;
+  }
+
+  /*
+  Batched evaluation
+  * Keys are looked up per instance through its cursor, blending and output run four instances per SIMD pass
+  * Cursors are updated in place, out must hold instances.size() entries
+  * Instances are independent, threads splits them into contiguous ranges (0 uses every hardware thread)
+  */
+  inline void evaluate(std::span<AnimationInstance> instances, Mat4* out, const unsigned threads = 0) {
+    Detail::evaluateInstances(instances, out, Detail::storeModelMatrices4, threads);
+  }
+  inline void evaluate(std::span<AnimationInstance> instances, Transform* out, const unsigned threads = 0) {
+    Detail::evaluateInstances(instances, out, Detail::storeTransforms4, threads);
+  }
+}
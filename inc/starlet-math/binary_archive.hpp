@@ -0,0 +1,419 @@
+#pragma once
+
+#include "mat4.hpp"
+#include "transform.hpp"
+#include "vertex.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Starlet::Math {
+  /*
+  Binary archive layout, little-endian, version 1
+  * 64-byte header: magic, version, directory offset and chunk count, directory checksum, file size
+  * Chunks follow back to back, each starting on a 64-byte boundary so a mapped chunk is a valid T array
+  * The directory of 64-byte ChunkEntry records comes last, which lets the writer stream chunks
+    without knowing how many there will be; the header is patched when the writer finishes
+  * Element sizes are stored per chunk and must match the reader's sizeof(T)
+  */
+  enum class ChunkType : std::uint32_t { Vertex = 1, Index16 = 2, Index32 = 3, Transform = 4, Mat4 = 5 };
+
+  template<typename T> struct ChunkTraits;
+  template<> struct ChunkTraits<Vertex> { static constexpr ChunkType type = ChunkType::Vertex; };
+  template<> struct ChunkTraits<std::uint16_t> { static constexpr ChunkType type = ChunkType::Index16; };
+  template<> struct ChunkTraits<std::uint32_t> { static constexpr ChunkType type = ChunkType::Index32; };
+  template<> struct ChunkTraits<Transform> { static constexpr ChunkType type = ChunkType::Transform; };
+  template<> struct ChunkTraits<Mat4> { static constexpr ChunkType type = ChunkType::Mat4; };
+
+  struct ArchiveHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    std::uint64_t directoryOffset;
+    std::uint64_t chunkCount;
+    std::uint64_t directoryChecksum;
+    std::uint64_t fileSize;
+    std::uint8_t reserved[16];
+  };
+  struct ChunkEntry {
+    ChunkType type;
+    std::uint32_t elementSize;
+    std::uint32_t tag;          // caller-chosen id, e.g. a mesh or LOD index
+    std::uint32_t reserved0;
+    std::uint64_t offset;
+    std::uint64_t count;
+    std::uint64_t bytes;
+    std::uint64_t checksum;
+    std::uint8_t reserved1[16];
+  };
+  static_assert(sizeof(ArchiveHeader) == 64 && sizeof(ChunkEntry) == 64);
+
+  namespace Detail {
+    inline constexpr char archiveMagic[8] = { 'S', 'T', 'M', 'A', 'T', 'H', 'B', '\0' };
+    inline constexpr std::uint32_t archiveVersion = 1;
+    inline constexpr size_t archiveAlignment = 64;
+  }
+
+  /*
+  Checksum
+  * Streaming 64-bit hash, four independent multiply lanes over 32-byte blocks so it runs at several GB/s
+  * update() takes bytes in pieces of any size, the result only depends on the concatenated bytes
+  */
+  class Checksum {
+  public:
+    void update(const void* data, size_t bytes) {
+      const auto* p = static_cast<const std::byte*>(data);
+      total += bytes;
+      if (pending > 0) {
+        const size_t take = std::min(bytes, Block - pending);
+        std::memcpy(tail + pending, p, take);
+        pending += take; p += take; bytes -= take;
+        if (pending < Block) return;
+        mixBlock(tail);
+        pending = 0;
+      }
+      for (; bytes >= Block; p += Block, bytes -= Block) mixBlock(p);
+      std::memcpy(tail, p, bytes);
+      pending = bytes;
+    }
+
+    std::uint64_t finish() const {
+      std::byte last[Block] = {};
+      std::memcpy(last, tail, pending);
+      std::uint64_t l[4] = { lanes[0], lanes[1], lanes[2], lanes[3] };
+      if (pending > 0) mix(l, last);
+      std::uint64_t h = total * Prime;
+      for (const std::uint64_t v : l) h = std::rotl(h ^ v, 27) * Prime + 0x52dce729u;
+      h ^= h >> 33; h *= 0xff51afd7ed558ccdull;
+      h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ull;
+      return h ^ (h >> 33);
+    }
+
+    static std::uint64_t of(const void* data, const size_t bytes) {
+      Checksum c;
+      c.update(data, bytes);
+      return c.finish();
+    }
+
+  private:
+    static constexpr size_t Block = 32;
+    static constexpr std::uint64_t Prime = 0x9e3779b185ebca87ull;
+
+    std::uint64_t lanes[4] = { 0x60ea27eeadc0b5d6ull, 0xc2b2ae3d27d4eb4full, 0x165667b19e3779f9ull, 0x27d4eb2f165667c5ull };
+    std::byte tail[Block] = {};
+    size_t pending = 0;
+    std::uint64_t total = 0;
+
+    static void mix(std::uint64_t (&l)[4], const std::byte* block) {
+      for (int i = 0; i < 4; ++i) {
+        std::uint64_t w;
+        std::memcpy(&w, block + i * 8, 8);
+        l[i] = std::rotl(l[i] + w * 0xc2b2ae3d27d4eb4full, 31) * Prime;
+      }
+    }
+    void mixBlock(const std::byte* block) { mix(lanes, block); }
+  };
+
+  /*
+  ArchiveWriter
+  * Streams chunks straight to disk, only the directory is kept in memory
+  * beginChunk/append/endChunk write one chunk from any number of pieces, writeChunk does all three
+  * Every call returns false once a write has failed or the chunk sequence is misused; finish() must
+    succeed for the file to be readable, an unfinished file has no directory and fails to open
+  */
+  class ArchiveWriter {
+  public:
+    ArchiveWriter() = default;
+    explicit ArchiveWriter(const std::string& path) { open(path); }
+    ~ArchiveWriter() { if (isOpen()) finish(); }
+
+    ArchiveWriter(const ArchiveWriter&) = delete;
+    ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+
+    bool open(const std::string& path) {
+      out = std::ofstream(path, std::ios::binary | std::ios::trunc);
+      entries.clear();
+      inChunk = false;
+      position = 0;
+      failed = !out;
+      if (failed) return false;
+      const ArchiveHeader placeholder{};
+      return writeRaw(&placeholder, sizeof(placeholder));
+    }
+    bool isOpen() const { return out.is_open(); }
+    bool good() const { return isOpen() && !failed; }
+
+    template<typename T>
+    bool beginChunk(const std::uint32_t tag = 0) {
+      static_assert(std::is_trivially_copyable_v<T>, "chunks are written and mapped as raw bytes");
+      if (!good() || inChunk) return fail();
+      if (!pad()) return false;
+      ChunkEntry e{};
+      e.type = ChunkTraits<T>::type;
+      e.elementSize = sizeof(T);
+      e.tag = tag;
+      e.offset = position;
+      entries.push_back(e);
+      hash = Checksum{};
+      inChunk = true;
+      return true;
+    }
+    // Any contiguous range of the chunk's element type: std::vector, AlignedVector, std::span, arena spans
+    template<std::ranges::contiguous_range R>
+    bool append(const R& elements) {
+      using T = std::ranges::range_value_t<R>;
+      if (!good() || !inChunk || entries.back().type != ChunkTraits<T>::type) return fail();
+      const size_t count = std::ranges::size(elements);
+      const size_t bytes = count * sizeof(T);
+      hash.update(std::ranges::data(elements), bytes);
+      entries.back().count += count;
+      entries.back().bytes += bytes;
+      return writeRaw(std::ranges::data(elements), bytes);
+    }
+    bool endChunk() {
+      if (!good() || !inChunk) return fail();
+      entries.back().checksum = hash.finish();
+      inChunk = false;
+      return true;
+    }
+    template<std::ranges::contiguous_range R>
+    bool writeChunk(const R& elements, const std::uint32_t tag = 0) {
+      return beginChunk<std::ranges::range_value_t<R>>(tag) && append(elements) && endChunk();
+    }
+
+    // Writes the directory, patches the header and closes the file
+    bool finish() {
+      if (inChunk) fail();
+      bool ok = good() && pad();
+      if (ok) {
+        ArchiveHeader h{};
+        std::memcpy(h.magic, Detail::archiveMagic, sizeof(h.magic));
+        h.version = Detail::archiveVersion;
+        h.headerSize = sizeof(ArchiveHeader);
+        h.directoryOffset = position;
+        h.chunkCount = entries.size();
+        h.directoryChecksum = Checksum::of(entries.data(), entries.size() * sizeof(ChunkEntry));
+        h.fileSize = position + entries.size() * sizeof(ChunkEntry);
+        ok = writeRaw(entries.data(), entries.size() * sizeof(ChunkEntry));
+        if (ok) {
+          out.seekp(0);
+          ok = writeRaw(&h, sizeof(h));
+        }
+      }
+      out.close();
+      return ok && !out.fail();
+    }
+
+  private:
+    std::ofstream out;
+    std::vector<ChunkEntry> entries;
+    Checksum hash;
+    std::uint64_t position = 0;
+    bool inChunk = false;
+    bool failed = false;
+
+    static_assert(std::endian::native == std::endian::little, "archives are stored little-endian");
+
+    bool fail() { failed = true; return false; }
+    bool writeRaw(const void* data, const size_t bytes) {
+      out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+      position += bytes;
+      return out ? true : fail();
+    }
+    bool pad() {
+      static constexpr char zeros[Detail::archiveAlignment] = {};
+      const size_t gap = (Detail::archiveAlignment - position % Detail::archiveAlignment) % Detail::archiveAlignment;
+      return gap == 0 || writeRaw(zeros, gap);
+    }
+  };
+
+  /*
+  MappedArchive
+  * Maps a whole archive read-only and hands out std::span views straight into the mapping, no copies
+  * open() checks the header, file size and directory checksum; chunk checksums are checked lazily,
+    the first time get() touches a chunk, and the result is cached so later calls cost nothing
+  * view() skips the checksum entirely, for data already verified or trusted
+  * Spans stay valid until close() or destruction; get() and verify() may be called from several threads
+  */
+  class MappedArchive {
+  public:
+    MappedArchive() = default;
+    explicit MappedArchive(const std::string& path) { open(path); }
+    ~MappedArchive() { close(); }
+
+    MappedArchive(const MappedArchive&) = delete;
+    MappedArchive& operator=(const MappedArchive&) = delete;
+    MappedArchive(MappedArchive&& o) noexcept { swap(o); }
+    MappedArchive& operator=(MappedArchive&& o) noexcept { MappedArchive moved(std::move(o)); swap(moved); return *this; }
+
+    bool open(const std::string& path) {
+      close();
+      if (!map(path)) return false;
+      if (!validate()) {
+        close();
+        return false;
+      }
+      verified = std::make_unique<std::atomic<std::uint8_t>[]>(entries.size());
+      for (size_t i = 0; i < entries.size(); ++i) verified[i].store(Unchecked, std::memory_order_relaxed);
+      return true;
+    }
+    void close() {
+      unmap();
+      entries = {};
+      verified.reset();
+    }
+    bool isOpen() const { return data != nullptr; }
+
+    size_t chunkCount() const { return entries.size(); }
+    const ChunkEntry& chunk(const size_t index) const { return entries[index]; }
+
+    // Index of the first chunk of the given type and tag, or chunkCount() if there is none
+    template<typename T>
+    size_t find(const std::uint32_t tag = 0) const {
+      for (size_t i = 0; i < entries.size(); ++i)
+        if (entries[i].type == ChunkTraits<T>::type && entries[i].tag == tag) return i;
+      return entries.size();
+    }
+
+    // Compares the chunk's bytes to its stored checksum once, later calls return the cached result
+    bool verify(const size_t index) const {
+      if (index >= entries.size()) return false;
+      std::uint8_t state = verified[index].load(std::memory_order_acquire);
+      if (state == Unchecked) {
+        const ChunkEntry& e = entries[index];
+        state = Checksum::of(data + e.offset, e.bytes) == e.checksum ? Valid : Corrupt;
+        verified[index].store(state, std::memory_order_release);
+      }
+      return state == Valid;
+    }
+
+    // Empty when the index is out of range, the type or element size does not match, or the checksum fails
+    template<typename T>
+    std::span<const T> get(const size_t index) const {
+      const std::span<const T> v = view<T>(index);
+      return v.empty() || verify(index) ? v : std::span<const T>{};
+    }
+    template<typename T>
+    std::span<const T> view(const size_t index) const {
+      if (index >= entries.size()) return {};
+      const ChunkEntry& e = entries[index];
+      if (e.type != ChunkTraits<T>::type || e.elementSize != sizeof(T)) return {};
+      return { reinterpret_cast<const T*>(data + e.offset), static_cast<size_t>(e.count) };
+    }
+
+  private:
+    enum : std::uint8_t { Unchecked, Valid, Corrupt };
+
+    const std::byte* data = nullptr;
+    size_t size = 0;
+    std::span<const ChunkEntry> entries;
+    std::unique_ptr<std::atomic<std::uint8_t>[]> verified;
+#if defined(_WIN32)
+    HANDLE mapping = nullptr;
+#endif
+
+    bool validate() {
+      if (size < sizeof(ArchiveHeader)) return false;
+      ArchiveHeader h;
+      std::memcpy(&h, data, sizeof(h));
+      if (std::memcmp(h.magic, Detail::archiveMagic, sizeof(h.magic)) != 0) return false;
+      if (h.version != Detail::archiveVersion || h.headerSize != sizeof(ArchiveHeader) || h.fileSize != size) return false;
+      if (h.directoryOffset % Detail::archiveAlignment != 0 || h.directoryOffset > size) return false;
+      if (h.chunkCount > (size - h.directoryOffset) / sizeof(ChunkEntry)) return false;
+
+      const std::byte* dir = data + h.directoryOffset;
+      const size_t dirBytes = static_cast<size_t>(h.chunkCount) * sizeof(ChunkEntry);
+      if (Checksum::of(dir, dirBytes) != h.directoryChecksum) return false;
+      entries = { reinterpret_cast<const ChunkEntry*>(dir), static_cast<size_t>(h.chunkCount) };
+
+      for (const ChunkEntry& e : entries) {
+        if (e.offset % Detail::archiveAlignment != 0 || e.offset < sizeof(ArchiveHeader)) return false;
+        if (e.offset > h.directoryOffset || e.bytes > h.directoryOffset - e.offset) return false;
+        if (e.elementSize == 0 || e.bytes / e.elementSize != e.count || e.bytes % e.elementSize != 0) return false;
+      }
+      return true;
+    }
+
+#if defined(_WIN32)
+    bool map(const std::string& path) {
+      HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (file == INVALID_HANDLE_VALUE) return false;
+      LARGE_INTEGER fileSize{};
+      if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+          data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+          size = data ? static_cast<size_t>(fileSize.QuadPart) : 0;
+        }
+      }
+      CloseHandle(file);
+      if (!data) unmap();
+      return data != nullptr;
+    }
+    void unmap() {
+      if (data) UnmapViewOfFile(data);
+      if (mapping) CloseHandle(mapping);
+      data = nullptr;
+      mapping = nullptr;
+      size = 0;
+    }
+#else
+    bool map(const std::string& path) {
+      const int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0) return false;
+      struct stat st{};
+      if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+          data = static_cast<const std::byte*>(p);
+          size = static_cast<size_t>(st.st_size);
+        }
+      }
+      ::close(fd);
+      return data != nullptr;
+    }
+    void unmap() {
+      if (data) ::munmap(const_cast<std::byte*>(data), size);
+      data = nullptr;
+      size = 0;
+    }
+#endif
+
+    void swap(MappedArchive& o) noexcept {
+      std::swap(data, o.data);
+      std::swap(size, o.size);
+      std::swap(entries, o.entries);
+      std::swap(verified, o.verified);
+#if defined(_WIN32)
+      std::swap(mapping, o.mapping);
+#endif
+    }
+  };
+}
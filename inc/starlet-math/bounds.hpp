@@ -0,0 +1,150 @@
+#pragma once
+
+#include "simd.hpp"
+#include "vec3.hpp"
+#include "vertex.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+namespace Starlet::Math {
+  /*
+  AABB
+  * Axis-aligned bounding box, min and max corners
+  * Default constructed boxes are empty (min > max) so expanding them takes the first point as-is
+  */
+  struct AABB {
+    Vec3<float> min{ FLT_MAX };
+    Vec3<float> max{ -FLT_MAX };
+
+    constexpr AABB() = default;
+    constexpr AABB(const Vec3<float>& minIn, const Vec3<float>& maxIn) : min(minIn), max(maxIn) {}
+
+    bool empty() const { return min.x > max.x || min.y > max.y || min.z > max.z; }
+
+    Vec3<float> center() const { return (min + max) * 0.5f; }
+    Vec3<float> extent() const { return max - min; }
+    float surfaceArea() const {
+      if (empty()) return 0.0f;
+      const Vec3<float> e = extent();
+      return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+    }
+    int longestAxis() const {
+      const Vec3<float> e = extent();
+      return (e.x >= e.y && e.x >= e.z) ? 0 : (e.y >= e.z ? 1 : 2);
+    }
+
+    void expand(const Vec3<float>& p) {
+      min = { std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z) };
+      max = { std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z) };
+    }
+    void expand(const AABB& b) {
+      min = { std::min(min.x, b.min.x), std::min(min.y, b.min.y), std::min(min.z, b.min.z) };
+      max = { std::max(max.x, b.max.x), std::max(max.y, b.max.y), std::max(max.z, b.max.z) };
+    }
+
+    bool contains(const Vec3<float>& p) const {
+      return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y && p.z >= min.z && p.z <= max.z;
+    }
+    bool intersects(const AABB& b) const {
+      return min.x <= b.max.x && max.x >= b.min.x && min.y <= b.max.y && max.y >= b.min.y && min.z <= b.max.z && max.z >= b.min.z;
+    }
+
+    static AABB fromPoints(std::span<const Vec3<float>> points) {
+      using Simd::Float4;
+
+      const float* p = reinterpret_cast<const float*>(points.data());
+      const size_t n = points.size();
+
+      Float4 minX = Float4::splat(FLT_MAX), minY = minX, minZ = minX;
+      Float4 maxX = Float4::splat(-FLT_MAX), maxY = maxX, maxZ = maxX;
+      size_t i = 0;
+      for (; i + 4 <= n; i += 4) {
+        Float4 x, y, z;
+        Simd::loadXYZ4(p + i * 3, x, y, z);
+        minX = Simd::min(minX, x); minY = Simd::min(minY, y); minZ = Simd::min(minZ, z);
+        maxX = Simd::max(maxX, x); maxY = Simd::max(maxY, y); maxZ = Simd::max(maxZ, z);
+      }
+
+      AABB box{ { Simd::horizontalMin(minX), Simd::horizontalMin(minY), Simd::horizontalMin(minZ) },
+                { Simd::horizontalMax(maxX), Simd::horizontalMax(maxY), Simd::horizontalMax(maxZ) } };
+      for (; i < n; ++i) box.expand(points[i]);
+      return box;
+    }
+    static AABB fromVertices(std::span<const Vertex> vertices) {
+      using Simd::Float4;
+
+      // Each position loads as (x, y, z, col.r), the fourth lane is ignored
+      Float4 lo = Float4::splat(FLT_MAX), hi = Float4::splat(-FLT_MAX);
+      for (const Vertex& v : vertices) {
+        const Float4 p = Float4::load(&v.pos.x);
+        lo = Simd::min(lo, p);
+        hi = Simd::max(hi, p);
+      }
+      if (vertices.empty()) return AABB{};
+      return { { lo.lane(0), lo.lane(1), lo.lane(2) }, { hi.lane(0), hi.lane(1), hi.lane(2) } };
+    }
+  };
+
+  /*
+  BoundingSphere
+  * Center and radius packed into 16 bytes
+  */
+  struct alignas(16) BoundingSphere {
+    Vec3<float> center{ 0.0f };
+    float radius{ 0.0f };
+
+    bool contains(const Vec3<float>& p) const { return (p - center).lengthSquared() <= static_cast<double>(radius) * radius; }
+    bool intersects(const BoundingSphere& s) const {
+      const float r = radius + s.radius;
+      return (s.center - center).lengthSquared() <= static_cast<double>(r) * r;
+    }
+
+    // Centered on the points' AABB, radius reaches the furthest point
+    static BoundingSphere fromPoints(std::span<const Vec3<float>> points) {
+      using Simd::Float4;
+      if (points.empty()) return {};
+
+      BoundingSphere s;
+      s.center = AABB::fromPoints(points).center();
+
+      const float* p = reinterpret_cast<const float*>(points.data());
+      const size_t n = points.size();
+      const Float4 cx = Float4::splat(s.center.x), cy = Float4::splat(s.center.y), cz = Float4::splat(s.center.z);
+
+      Float4 furthest = Float4::splat(0.0f);
+      size_t i = 0;
+      for (; i + 4 <= n; i += 4) {
+        Float4 x, y, z;
+        Simd::loadXYZ4(p + i * 3, x, y, z);
+        const Float4 dx = x - cx, dy = y - cy, dz = z - cz;
+        furthest = Simd::max(furthest, Simd::madd(dx, dx, Simd::madd(dy, dy, dz * dz)));
+      }
+
+      float maxSq = Simd::horizontalMax(furthest);
+      for (; i < n; ++i) {
+        const Vec3<float> d = points[i] - s.center;
+        maxSq = std::max(maxSq, d.x * d.x + d.y * d.y + d.z * d.z);
+      }
+      s.radius = std::sqrt(maxSq);
+      return s;
+    }
+    static BoundingSphere fromVertices(std::span<const Vertex> vertices) {
+      if (vertices.empty()) return {};
+
+      BoundingSphere s;
+      s.center = AABB::fromVertices(vertices).center();
+
+      float maxSq = 0.0f;
+      for (const Vertex& v : vertices) {
+        const Vec3<float> d = v.pos - s.center;
+        maxSq = std::max(maxSq, d.x * d.x + d.y * d.y + d.z * d.z);
+      }
+      s.radius = std::sqrt(maxSq);
+      return s;
+    }
+  };
+}
@@ -0,0 +1,294 @@
+#pragma once
+
+#include "bounds.hpp"
+#include "parallel.hpp"
+#include "vertex.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace Starlet::Math {
+  /*
+  BvhNode
+  * 32 bytes, two per cache line
+  * Interior nodes: left child is the next node, offset is the right child
+  * Leaf nodes: primitives [offset, offset + count) of Bvh::primitives
+  */
+  struct BvhNode {
+    AABB bounds;
+    std::uint32_t offset{ 0 };
+    std::uint32_t count{ 0 };
+
+    bool isLeaf() const { return count != 0; }
+  };
+  static_assert(sizeof(BvhNode) == 32, "BvhNode should stay cache-line friendly");
+
+  struct BvhBuildOptions {
+    unsigned threads{ 0 };                    // 0 uses every hardware thread
+    std::uint32_t maxLeafSize{ 4 };
+    std::uint32_t binCount{ 16 };
+    std::uint32_t parallelThreshold{ 4096 };  // smallest subtree handed to another thread
+  };
+
+  /*
+  Bvh
+  * Bounding volume hierarchy built with binned SAH
+  * Large subtrees are built on separate threads, then flattened depth-first
+  */
+  struct Bvh {
+    using BuildOptions = BvhBuildOptions;
+
+    std::vector<BvhNode> nodes;
+    std::vector<std::uint32_t> primitives;
+
+    bool empty() const { return nodes.empty(); }
+
+    static Bvh build(std::span<const AABB> primitiveBounds, const BuildOptions& options = {}) {
+      Builder builder(primitiveBounds, options);
+      return builder.run();
+    }
+    // One primitive per triangle, primitive i covers indices [3i, 3i + 3)
+    static Bvh buildTriangles(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices, const BuildOptions& options = {}) {
+      std::vector<AABB> bounds(indices.size() / 3);
+      parallelFor(bounds.size(), 1024, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+          AABB b;
+          b.expand(vertices[indices[t * 3]].pos);
+          b.expand(vertices[indices[t * 3 + 1]].pos);
+          b.expand(vertices[indices[t * 3 + 2]].pos);
+          bounds[t] = b;
+        }
+      }, options.threads);
+      return build(bounds, options);
+    }
+
+    // Calls fn(primitive) for every primitive in a leaf whose bounds overlap box
+    template<typename Fn>
+    void query(const AABB& box, Fn&& fn) const {
+      if (nodes.empty()) return;
+
+      std::uint32_t stack[MaxDepth + 1];
+      int top = 0;
+      stack[top++] = 0;
+      while (top > 0) {
+        const std::uint32_t index = stack[--top];
+        const BvhNode& node = nodes[index];
+        if (!node.bounds.intersects(box)) continue;
+
+        if (node.isLeaf()) {
+          for (std::uint32_t i = 0; i < node.count; ++i) fn(primitives[node.offset + i]);
+        }
+        else {
+          stack[top++] = node.offset;
+          stack[top++] = index + 1;
+        }
+      }
+    }
+
+    // Bounds the traversal stack, deeper ranges become (large) leaves
+    static constexpr int MaxDepth = 63;
+
+  private:
+
+    struct BuildNode {
+      AABB bounds;
+      std::uint32_t first{ 0 }, count{ 0 };
+      std::uint32_t left{ 0 }, right{ 0 };
+    };
+
+    struct Builder {
+      std::span<const AABB> bounds;
+      BuildOptions options;
+      std::vector<Vec3<float>> centroids;
+      std::vector<std::uint32_t> order;
+      std::vector<BuildNode> buildNodes;
+      std::atomic<std::uint32_t> nodeCount{ 0 };
+      std::atomic<int> spareThreads{ 0 };
+
+      Builder(std::span<const AABB> boundsIn, const BuildOptions& optionsIn) : bounds(boundsIn), options(optionsIn) {
+        options.maxLeafSize = std::max<std::uint32_t>(options.maxLeafSize, 1);
+        options.binCount = std::clamp<std::uint32_t>(options.binCount, 2, 64);
+        const unsigned threads = options.threads == 0 ? defaultThreadCount() : options.threads;
+        spareThreads = static_cast<int>(threads) - 1;
+      }
+
+      Bvh run() {
+        Bvh bvh;
+        const size_t n = bounds.size();
+        if (n == 0) return bvh;
+
+        centroids.resize(n);
+        order.resize(n);
+        parallelFor(n, 4096, [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            centroids[i] = bounds[i].center();
+            order[i] = static_cast<std::uint32_t>(i);
+          }
+        }, options.threads);
+
+        // A binary tree with at most n leaves never needs more than 2n - 1 nodes
+        buildNodes.resize(2 * n - 1);
+        nodeCount = 1;
+        buildRange(0, 0, static_cast<std::uint32_t>(n), 0);
+
+        flatten(bvh);
+        bvh.primitives = std::move(order);
+        return bvh;
+      }
+
+      void buildRange(const std::uint32_t nodeIndex, const std::uint32_t first, const std::uint32_t count, const int depth) {
+        BuildNode& node = buildNodes[nodeIndex];
+        node.first = first;
+        node.count = count;
+
+        AABB centroidBounds;
+        for (std::uint32_t i = first; i < first + count; ++i) {
+          node.bounds.expand(bounds[order[i]]);
+          centroidBounds.expand(centroids[order[i]]);
+        }
+        if (count <= 1 || depth >= MaxDepth) return;
+
+        const std::uint32_t mid = split(node, centroidBounds);
+        if (mid == first) return;  // SAH prefers a leaf
+
+        const std::uint32_t left = nodeCount.fetch_add(2);
+        node.left = left;
+        node.right = left + 1;
+        node.count = 0;
+
+        const std::uint32_t leftCount = mid - first;
+        const std::uint32_t rightCount = count - leftCount;
+
+        const bool large = leftCount >= options.parallelThreshold && rightCount >= options.parallelThreshold;
+        if (large && acquireThread()) {
+          std::thread worker([this, left, first, leftCount, depth] { buildRange(left, first, leftCount, depth + 1); });
+          buildRange(left + 1, mid, rightCount, depth + 1);
+          worker.join();
+          spareThreads.fetch_add(1);
+        }
+        else {
+          buildRange(left, first, leftCount, depth + 1);
+          buildRange(left + 1, mid, rightCount, depth + 1);
+        }
+      }
+
+      bool acquireThread() {
+        int spare = spareThreads.load();
+        while (spare > 0)
+          if (spareThreads.compare_exchange_weak(spare, spare - 1)) return true;
+        return false;
+      }
+
+      // Partitions order[first, first + count) and returns where the right child starts,
+      // or node.first when the node should stay a leaf
+      std::uint32_t split(const BuildNode& node, const AABB& centroidBounds) {
+        struct Bin { AABB bounds; std::uint32_t count{ 0 }; };
+
+        const std::uint32_t first = node.first, count = node.count;
+        const std::uint32_t binCount = options.binCount;
+
+        float bestCost = FLT_MAX;
+        int bestAxis = -1;
+        std::uint32_t bestBin = 0;
+
+        Bin bins[64];
+        float rightArea[64];
+        std::uint32_t rightCount[64];
+        for (int axis = 0; axis < 3; ++axis) {
+          const float lo = axisOf(centroidBounds.min, axis), hi = axisOf(centroidBounds.max, axis);
+          if (hi <= lo) continue;
+
+          const float scale = binCount / (hi - lo);
+          for (std::uint32_t b = 0; b < binCount; ++b) bins[b] = Bin{};
+          for (std::uint32_t i = first; i < first + count; ++i) {
+            const std::uint32_t b = std::min(binCount - 1, static_cast<std::uint32_t>((axisOf(centroids[order[i]], axis) - lo) * scale));
+            bins[b].bounds.expand(bounds[order[i]]);
+            ++bins[b].count;
+          }
+
+          // Sweep from the right to get the cost of everything past each split plane
+          AABB acc;
+          std::uint32_t accCount = 0;
+          for (std::uint32_t b = binCount - 1; b > 0; --b) {
+            acc.expand(bins[b].bounds);
+            accCount += bins[b].count;
+            rightArea[b] = acc.surfaceArea();
+            rightCount[b] = accCount;
+          }
+
+          acc = AABB{};
+          accCount = 0;
+          for (std::uint32_t b = 1; b < binCount; ++b) {
+            acc.expand(bins[b - 1].bounds);
+            accCount += bins[b - 1].count;
+            if (accCount == 0 || rightCount[b] == 0) continue;
+
+            const float cost = accCount * acc.surfaceArea() + rightCount[b] * rightArea[b];
+            if (cost < bestCost) {
+              bestCost = cost;
+              bestAxis = axis;
+              bestBin = b;
+            }
+          }
+        }
+
+        // Traversal cost of one interior node vs intersecting every primitive here
+        const float parentArea = node.bounds.surfaceArea();
+        const float leafCost = static_cast<float>(count);
+        const float splitCost = parentArea > 0.0f ? 1.0f + bestCost / parentArea : FLT_MAX;
+        if (count <= options.maxLeafSize && leafCost <= splitCost) return first;
+
+        std::uint32_t* begin = order.data() + first;
+        std::uint32_t* end = begin + count;
+        std::uint32_t* mid = begin;
+        if (bestAxis >= 0) {
+          const float lo = axisOf(centroidBounds.min, bestAxis), hi = axisOf(centroidBounds.max, bestAxis);
+          const float scale = binCount / (hi - lo);
+          mid = std::partition(begin, end, [&](std::uint32_t prim) {
+            return std::min(binCount - 1, static_cast<std::uint32_t>((axisOf(centroids[prim], bestAxis) - lo) * scale)) < bestBin;
+          });
+        }
+        if (mid == begin || mid == end) {
+          // Coincident centroids, split the range in half so leaves stay bounded
+          if (count <= options.maxLeafSize) return first;
+          mid = begin + count / 2;
+        }
+        return first + static_cast<std::uint32_t>(mid - begin);
+      }
+
+      void flatten(Bvh& bvh) const {
+        bvh.nodes.reserve(nodeCount.load());
+
+        struct Pending { std::uint32_t buildIndex; std::uint32_t parent; };
+        std::vector<Pending> stack{ { 0, UINT32_MAX } };
+        while (!stack.empty()) {
+          const Pending item = stack.back();
+          stack.pop_back();
+
+          const std::uint32_t flatIndex = static_cast<std::uint32_t>(bvh.nodes.size());
+          if (item.parent != UINT32_MAX) bvh.nodes[item.parent].offset = flatIndex;
+
+          const BuildNode& src = buildNodes[item.buildIndex];
+          BvhNode dst;
+          dst.bounds = src.bounds;
+          dst.count = src.count;
+          dst.offset = src.count != 0 ? src.first : 0;
+          bvh.nodes.push_back(dst);
+
+          // Left is visited next so it lands at flatIndex + 1, right patches its parent when reached
+          if (src.count == 0) {
+            stack.push_back({ src.right, flatIndex });
+            stack.push_back({ src.left, UINT32_MAX });
+          }
+        }
+      }
+
+      static float axisOf(const Vec3<float>& v, const int axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+    };
+  };
+}
@@ -0,0 +1,230 @@
+#pragma once
+
+#include "mat4.hpp"
+#include "simd.hpp"
+#include "vec3.hpp"
+#include "constants.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+namespace Starlet::Math {
+  enum class DepthMode {
+    Standard,  // OpenGL clip space, near maps to -1 and far to 1, same as Mat4::perspective
+    Reversed,  // near maps to 1 and far to 0, for a [0, 1] depth range (glClipControl) and a GREATER depth test
+  };
+
+  namespace Detail {
+    // out[i] = perspective divide of m * pre(in[i]), then post on the result, four points per pass.
+    // pre and post take and return lanes by reference, a partial last block is padded and trimmed.
+    template<typename Pre, typename Post>
+    inline void projectPoints(const Mat4& m, std::span<const Vec3<float>> in, std::span<Vec3<float>> out, Pre&& pre, Post&& post) {
+      using Simd::Float4;
+      assert(out.size() == in.size());
+
+      Float4 e[16];
+      for (int k = 0; k < 16; ++k) e[k] = Float4::splat(m.models[k]);
+      const auto block = [&](const float* src, float* dst) {
+        Float4 x, y, z;
+        Simd::loadXYZ4(src, x, y, z);
+        pre(x, y, z);
+        const Float4 cx = Simd::madd(e[0], x, Simd::madd(e[4], y, Simd::madd(e[8], z, e[12])));
+        const Float4 cy = Simd::madd(e[1], x, Simd::madd(e[5], y, Simd::madd(e[9], z, e[13])));
+        const Float4 cz = Simd::madd(e[2], x, Simd::madd(e[6], y, Simd::madd(e[10], z, e[14])));
+        const Float4 cw = Simd::madd(e[3], x, Simd::madd(e[7], y, Simd::madd(e[11], z, e[15])));
+        const Float4 inv = Float4::splat(1.0f) / cw;
+        x = cx * inv; y = cy * inv; z = cz * inv;
+        post(x, y, z);
+        Simd::storeXYZ4(dst, x, y, z);
+      };
+
+      size_t i = 0;
+      for (; i + 4 <= in.size(); i += 4) block(&in[i].x, &out[i].x);
+      if (i == in.size()) return;
+
+      float src[12] = {}, dst[12];
+      for (size_t l = 0; i + l < in.size(); ++l) {
+        src[l * 3] = in[i + l].x; src[l * 3 + 1] = in[i + l].y; src[l * 3 + 2] = in[i + l].z;
+      }
+      block(src, dst);
+      for (size_t l = 0; i + l < in.size(); ++l) out[i + l] = { dst[l * 3], dst[l * 3 + 1], dst[l * 3 + 2] };
+    }
+  }
+
+  /*
+  Camera
+  * Perspective camera that caches view, projection, view-projection and their inverses
+  * Setters only mark what they change, matrices are rebuilt on the next read, setting an unchanged value costs nothing
+  * A far plane of infinity gives an infinite projection, Reversed depth with an infinite far plane keeps precision everywhere
+  * Screen coordinates are pixels from the top-left corner of the viewport with z the NDC depth
+  * Reads rebuild caches through mutable state, share a Camera between threads only after it has been read once
+  */
+  class Camera {
+  public:
+    static constexpr float InfiniteFar = std::numeric_limits<float>::infinity();
+
+    const Vec3<float>& position() const { return pos; }
+    const Vec3<float>& front() const { return forward; }
+    const Vec3<float>& up() const { return upDir; }
+
+    void setPosition(const Vec3<float>& p) { if (!(p == pos)) { pos = p; touch(ViewDirty); } }
+    // front need not be normalized
+    void setFront(const Vec3<float>& f) {
+      const Vec3<float> n = f.normalized();
+      if (!(n == forward)) { forward = n; touch(ViewDirty); }
+    }
+    void setUp(const Vec3<float>& u) { if (!(u == upDir)) { upDir = u; touch(ViewDirty); } }
+    void lookAt(const Vec3<float>& target) { setFront(target - pos); }
+    // Degrees, yaw -90 and pitch 0 look down -z (DEFAULT_YAW, DEFAULT_PITCH)
+    void setOrientation(const float yaw, const float pitch) {
+      const float cy = std::cos(radians(yaw)), sy = std::sin(radians(yaw));
+      const float cp = std::cos(radians(pitch)), sp = std::sin(radians(pitch));
+      setFront({ cy * cp, sp, sy * cp });
+    }
+
+    float fov() const { return fovDegrees; }
+    float nearPlane() const { return nearDist; }
+    float farPlane() const { return farDist; }
+    bool isInfinite() const { return std::isinf(farDist); }
+    float aspect() const { return width / height; }
+    float viewportWidth() const { return width; }
+    float viewportHeight() const { return height; }
+    DepthMode depthMode() const { return depth; }
+
+    // farPlane may be InfiniteFar
+    void setPerspective(const float degFov, const float nearPlaneIn, const float farPlaneIn) {
+      assert(nearPlaneIn > 0.0f && farPlaneIn > nearPlaneIn);
+      if (degFov == fovDegrees && nearPlaneIn == nearDist && farPlaneIn == farDist) return;
+      fovDegrees = degFov; nearDist = nearPlaneIn; farDist = farPlaneIn;
+      touch(ProjectionDirty);
+    }
+    void setViewport(const float widthIn, const float heightIn) {
+      assert(widthIn > 0.0f && heightIn > 0.0f);
+      if (widthIn == width && heightIn == height) return;
+      width = widthIn; height = heightIn;
+      touch(ProjectionDirty);
+    }
+    void setDepthMode(const DepthMode mode) { if (mode != depth) { depth = mode; touch(ProjectionDirty); } }
+
+    // NDC depth of the near and far planes in the current mode
+    float nearDepth() const { return depth == DepthMode::Reversed ? 1.0f : -1.0f; }
+    float farDepth() const { return depth == DepthMode::Reversed ? 0.0f : 1.0f; }
+
+    // Bumped by every change, lets callers skip re-uploading matrices they already have
+    std::uint64_t version() const { return changes; }
+
+    const Mat4& view() const { update(); return cache.view; }
+    const Mat4& projection() const { update(); return cache.projection; }
+    const Mat4& viewProjection() const { update(); return cache.viewProjection; }
+    const Mat4& inverseView() const { update(); return cache.inverseView; }
+    const Mat4& inverseProjection() const { update(); return cache.inverseProjection; }
+    const Mat4& inverseViewProjection() const { update(); return cache.inverseViewProjection; }
+
+    /*
+    Batched projection between world space and screen space, four points per SIMD pass
+    * Points behind the camera come out with a depth outside [nearDepth, farDepth], a range check on z rejects them
+    * screenToWorld takes the same pixel and depth layout, nearDepth() gives the point on the near plane
+    */
+    void worldToScreen(std::span<const Vec3<float>> world, std::span<Vec3<float>> screen) const {
+      using Simd::Float4;
+      const Float4 halfW = Float4::splat(0.5f * width), halfH = Float4::splat(0.5f * height);
+      Detail::projectPoints(viewProjection(), world, screen, [](Float4&, Float4&, Float4&) {},
+        [&](Float4& x, Float4& y, Float4&) {
+          x = Simd::madd(x, halfW, halfW);
+          y = halfH - y * halfH;
+        });
+    }
+    void screenToWorld(std::span<const Vec3<float>> screen, std::span<Vec3<float>> world) const {
+      using Simd::Float4;
+      const Float4 toNdcX = Float4::splat(2.0f / width), toNdcY = Float4::splat(-2.0f / height), one = Float4::splat(1.0f);
+      Detail::projectPoints(inverseViewProjection(), screen, world,
+        [&](Float4& x, Float4& y, Float4&) {
+          x = Simd::madd(x, toNdcX, -one);
+          y = Simd::madd(y, toNdcY, one);
+        }, [](Float4&, Float4&, Float4&) {});
+    }
+    Vec3<float> worldToScreen(const Vec3<float>& world) const {
+      Vec3<float> out;
+      worldToScreen({ &world, 1 }, { &out, 1 });
+      return out;
+    }
+    Vec3<float> screenToWorld(const Vec3<float>& screen) const {
+      Vec3<float> out;
+      screenToWorld({ &screen, 1 }, { &out, 1 });
+      return out;
+    }
+
+  private:
+    enum : std::uint8_t { ViewDirty = 1, ProjectionDirty = 2 };
+
+    struct Matrices {
+      Mat4 view, projection, viewProjection;
+      Mat4 inverseView, inverseProjection, inverseViewProjection;
+    };
+
+    Vec3<float> pos{ INITIAL_POS };
+    Vec3<float> forward{ 0.0f, 0.0f, -1.0f };  // DEFAULT_YAW, DEFAULT_PITCH without the rounding of cos(-90)
+    Vec3<float> upDir{ WORLD_UP };
+    float fovDegrees = DEFAULT_FOV;
+    float nearDist = NEAR_PLANE;
+    float farDist = FAR_PLANE;
+    float width = 1.0f, height = 1.0f;
+    DepthMode depth = DepthMode::Standard;
+
+    std::uint64_t changes = 0;
+    mutable std::uint8_t dirty = ViewDirty | ProjectionDirty;
+    mutable Matrices cache;
+
+    void touch(const std::uint8_t what) { dirty |= what; ++changes; }
+
+    // Closed-form projection and inverse, tan runs once per projection change
+    void buildProjection() const {
+      const float cotHalfFov = 1.0f / std::tan(radians(fovDegrees) * 0.5f);
+      const float n = nearDist, f = farDist;
+
+      // clip z = a * z + b * w, clip w = -z
+      float a, b;
+      if (depth == DepthMode::Reversed) {
+        a = isInfinite() ? 0.0f : n / (f - n);
+        b = isInfinite() ? n : f * n / (f - n);
+      }
+      else {
+        a = isInfinite() ? -1.0f : -(f + n) / (f - n);
+        b = isInfinite() ? -2.0f * n : -(2.0f * f * n) / (f - n);
+      }
+
+      Mat4& p = cache.projection;
+      p = Mat4{};
+      p.models[0] = cotHalfFov / aspect();
+      p.models[5] = cotHalfFov;
+      p.models[10] = a;
+      p.models[11] = -1.0f;
+      p.models[14] = b;
+
+      // z = -w', w = (z' - a * z) / b
+      Mat4& inv = cache.inverseProjection;
+      inv = Mat4{};
+      inv.models[0] = 1.0f / p.models[0];
+      inv.models[5] = 1.0f / p.models[5];
+      inv.models[14] = -1.0f;
+      inv.models[11] = 1.0f / b;
+      inv.models[15] = a / b;
+    }
+
+    void update() const {
+      if (!dirty) return;
+      if (dirty & ViewDirty) {
+        cache.view = Mat4::lookAt(pos, forward, upDir);
+        cache.inverseView = cache.view.inverseRigid();
+      }
+      if (dirty & ProjectionDirty) buildProjection();
+      cache.viewProjection = cache.projection * cache.view;
+      cache.inverseViewProjection = cache.inverseView * cache.inverseProjection;
+      dirty = 0;
+    }
+  };
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "mat4.hpp"
+#include "vec3.hpp"
+#include "vec4f.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <span>
+
+namespace Starlet::Math {
+  /*
+  Camera-relative rendering
+  * World positions and the camera origin stay in double, their difference is taken before dropping to float
+  * Objects near the camera keep full float precision however far they are from the world origin
+  * view is the camera's view matrix built at the origin, e.g. Mat4::lookAt({ 0, 0, 0 }, front, up)
+  */
+
+  // Float copy of model with its translation rebased onto cameraOrigin
+  inline Mat4 rebase(const Mat4d& model, const Vec3<double>& cameraOrigin) {
+    Mat4 result = model.cast<float>();
+    result.models[12] = static_cast<float>(model.models[12] - cameraOrigin.x);
+    result.models[13] = static_cast<float>(model.models[13] - cameraOrigin.y);
+    result.models[14] = static_cast<float>(model.models[14] - cameraOrigin.z);
+    return result;
+  }
+
+  /*
+  Writes out[i] = view * local[i] translated by positions[i] - cameraOrigin
+  * local holds each object's rotation and scale (its translation is added on top of the position)
+  * The view columns stay in registers for the whole pass, no double matrix products are formed
+  */
+  inline void buildCameraRelativeModelViews(std::span<const Vec3<double>> positions, std::span<const Mat4> local,
+                                            const Vec3<double>& cameraOrigin, const Mat4& view, std::span<Mat4> out) {
+    assert(positions.size() == local.size() && positions.size() == out.size());
+
+    const Vec4f v0 = view.column(0), v1 = view.column(1), v2 = view.column(2), v3 = view.column(3);
+    auto transform = [&](const Vec4f& c) {
+      return madd(v3, c.broadcast<3>(), madd(v2, c.broadcast<2>(), madd(v1, c.broadcast<1>(), v0 * c.broadcast<0>())));
+    };
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+      const Vec4f rel(
+        static_cast<float>(positions[i].x - cameraOrigin.x),
+        static_cast<float>(positions[i].y - cameraOrigin.y),
+        static_cast<float>(positions[i].z - cameraOrigin.z),
+        0.0f);
+
+      const Mat4& m = local[i];
+      Mat4& o = out[i];
+      o.setColumn(0, transform(m.column(0)));
+      o.setColumn(1, transform(m.column(1)));
+      o.setColumn(2, transform(m.column(2)));
+      o.setColumn(3, transform(m.column(3) + rel));
+    }
+  }
+  // Same as above with double model matrices, their translations are the world positions
+  inline void buildCameraRelativeModelViews(std::span<const Mat4d> models, const Vec3<double>& cameraOrigin,
+                                            const Mat4& view, std::span<Mat4> out) {
+    assert(models.size() == out.size());
+    for (size_t i = 0; i < models.size(); ++i) out[i] = view * rebase(models[i], cameraOrigin);
+  }
+}
@@ -4,6 +4,8 @@
 #include "vec3.hpp"
 #include "vec4.hpp"
 
+#include <cmath>
+
 namespace Starlet {
 	constexpr unsigned int NUMBEROFLIGHTS{ 50 };
 
@@ -29,8 +31,12 @@ namespace Starlet {
 	constexpr Math::Vec4 DEFAULT_COLOUR{ 0.0f, 1.0f, 0.0f, 1.0f };
 
 	constexpr float DEG_TO_RAD{ 0.01745329251994329576923690768489f };
-	inline float radians(float degrees) { return degrees * DEG_TO_RAD; }
+	constexpr float radians(float degrees) { return degrees * DEG_TO_RAD; }
 
 	constexpr float RAD_TO_DEG{ 57.295779513082320876798154814105f };
-	inline float degrees(float radians) { return radians * RAD_TO_DEG; }
+	constexpr float degrees(float radians) { return radians * RAD_TO_DEG; }
+
+	// Sine and cosine of the same angle, lets the compiler emit a single sincos (float or double)
+	template<typename T>
+	constexpr void sincos(const T radians, T& s, T& c) { s = Math::Cx::sin(radians); c = Math::Cx::cos(radians); }
 }
\ No newline at end of file
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace Starlet::Math::Cx {
+  /*
+  Cx
+  * sqrt, sin, cos, tan, atan2 and asin usable in constant expressions
+  * Compile-time calls evaluate a double precision series, runtime calls forward to <cmath>
+  */
+  namespace Detail {
+    constexpr double PI = 3.14159265358979323846;
+    constexpr double HALF_PI = PI / 2.0;
+    constexpr double QUARTER_PI = PI / 4.0;
+    constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+    constexpr bool isFinite(const double x) { return x == x && x - x == 0.0; }
+
+    constexpr double sqrt(double x) {
+      if (x < 0.0 || x != x) return NaN;
+      if (x == 0.0 || !isFinite(x)) return x;
+
+      // Scale into [0.25, 4] by powers of four so Newton converges in a handful of steps
+      double scale = 1.0;
+      while (x > 4.0) { x *= 0.25; scale *= 2.0; }
+      while (x < 0.25) { x *= 4.0; scale *= 0.5; }
+
+      // Starting above the root, Newton decreases monotonically until it stalls
+      double guess = 2.0;
+      for (int i = 0; i < 64; ++i) {
+        const double next = 0.5 * (guess + x / guess);
+        if (next >= guess) break;
+        guess = next;
+      }
+      return guess * scale;
+    }
+
+    // Taylor series, |x| <= pi / 4
+    constexpr double sinReduced(const double x) {
+      const double x2 = x * x;
+      double term = x, sum = x;
+      for (int n = 1; n < 12; ++n) {
+        term *= -x2 / ((2.0 * n) * (2.0 * n + 1.0));
+        sum += term;
+      }
+      return sum;
+    }
+    constexpr double cosReduced(const double x) {
+      const double x2 = x * x;
+      double term = 1.0, sum = 1.0;
+      for (int n = 1; n < 12; ++n) {
+        term *= -x2 / ((2.0 * n - 1.0) * (2.0 * n));
+        sum += term;
+      }
+      return sum;
+    }
+
+    // Splits x into quadrant * pi/2 + r with |r| <= pi/4
+    constexpr double reduce(const double x, long long& quadrant) {
+      const double q = x / HALF_PI;
+      quadrant = q >= 0.0 ? static_cast<long long>(q + 0.5) : -static_cast<long long>(-q + 0.5);
+      return x - static_cast<double>(quadrant) * HALF_PI;
+    }
+
+    constexpr double sin(const double x) {
+      if (!isFinite(x)) return NaN;
+      long long quadrant = 0;
+      const double r = reduce(x, quadrant);
+      switch (quadrant & 3) {
+      case 0: return sinReduced(r);
+      case 1: return cosReduced(r);
+      case 2: return -sinReduced(r);
+      default: return -cosReduced(r);
+      }
+    }
+    constexpr double cos(const double x) {
+      if (!isFinite(x)) return NaN;
+      long long quadrant = 0;
+      const double r = reduce(x, quadrant);
+      switch (quadrant & 3) {
+      case 0: return cosReduced(r);
+      case 1: return -sinReduced(r);
+      case 2: return -cosReduced(r);
+      default: return sinReduced(r);
+      }
+    }
+
+    constexpr double atan(const double x) {
+      if (x != x) return NaN;
+      if (x < 0.0) return -atan(-x);
+      if (!isFinite(x)) return HALF_PI;
+      if (x > 1.0) return HALF_PI - atan(1.0 / x);
+      // tan(pi/8), past it the series converges slowly
+      if (x > 0.41421356237309504880) return QUARTER_PI + atan((x - 1.0) / (x + 1.0));
+
+      const double x2 = x * x;
+      double power = x, sum = x;
+      for (int n = 1; n < 40; ++n) {
+        power *= -x2;
+        sum += power / (2.0 * n + 1.0);
+      }
+      return sum;
+    }
+    constexpr double atan2(const double y, const double x) {
+      if (x != x || y != y) return NaN;
+      if (x > 0.0) return atan(y / x);
+      if (x < 0.0) return y >= 0.0 ? atan(y / x) + PI : atan(y / x) - PI;
+      if (y > 0.0) return HALF_PI;
+      if (y < 0.0) return -HALF_PI;
+      return 0.0;
+    }
+  }
+
+  template<typename T>
+  constexpr T abs(const T x) { return x < T(0) ? -x : x; }
+
+  // Integral arguments give a double, like std::sqrt
+  template<typename T>
+  constexpr auto sqrt(const T x) {
+    if constexpr (std::is_integral_v<T>) {
+      if (std::is_constant_evaluated()) return Detail::sqrt(static_cast<double>(x));
+      return std::sqrt(static_cast<double>(x));
+    }
+    else {
+      if (std::is_constant_evaluated()) return static_cast<T>(Detail::sqrt(static_cast<double>(x)));
+      return std::sqrt(x);
+    }
+  }
+
+  template<typename T> requires std::is_floating_point_v<T>
+  constexpr T sin(const T x) {
+    if (std::is_constant_evaluated()) return static_cast<T>(Detail::sin(static_cast<double>(x)));
+    return std::sin(x);
+  }
+  template<typename T> requires std::is_floating_point_v<T>
+  constexpr T cos(const T x) {
+    if (std::is_constant_evaluated()) return static_cast<T>(Detail::cos(static_cast<double>(x)));
+    return std::cos(x);
+  }
+  template<typename T> requires std::is_floating_point_v<T>
+  constexpr T tan(const T x) {
+    if (std::is_constant_evaluated()) return static_cast<T>(Detail::sin(static_cast<double>(x)) / Detail::cos(static_cast<double>(x)));
+    return std::tan(x);
+  }
+  template<typename T> requires std::is_floating_point_v<T>
+  constexpr T atan2(const T y, const T x) {
+    if (std::is_constant_evaluated()) return static_cast<T>(Detail::atan2(static_cast<double>(y), static_cast<double>(x)));
+    return std::atan2(y, x);
+  }
+  template<typename T> requires std::is_floating_point_v<T>
+  constexpr T asin(const T x) {
+    if (std::is_constant_evaluated()) {
+      const double d = static_cast<double>(x);
+      if (d < -1.0 || d > 1.0) return static_cast<T>(Detail::NaN);
+      return static_cast<T>(Detail::atan2(d, Detail::sqrt(1.0 - d * d)));
+    }
+    return std::asin(x);
+  }
+}
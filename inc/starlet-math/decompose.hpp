@@ -0,0 +1,292 @@
+#pragma once
+
+#include "fast_math.hpp"
+#include "mat4.hpp"
+#include "quat.hpp"
+#include "simd.hpp"
+#include "transform_batch.hpp"
+#include "vec3.hpp"
+#include "vec4.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace Starlet::Math {
+  /*
+  QuatTransformBatch
+  * Structure-of-arrays storage for many QuatTransforms, the quaternion counterpart of TransformBatch
+  */
+  struct QuatTransformBatch {
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> rotX, rotY, rotZ, rotW;
+    std::vector<float> sizeX, sizeY, sizeZ;
+
+    size_t count() const { return posX.size(); }
+    bool empty() const { return posX.empty(); }
+
+    void resize(const size_t n) {
+      posX.resize(n, 0.0f); posY.resize(n, 0.0f); posZ.resize(n, 0.0f);
+      rotX.resize(n, 0.0f); rotY.resize(n, 0.0f); rotZ.resize(n, 0.0f); rotW.resize(n, 1.0f);
+      sizeX.resize(n, 1.0f); sizeY.resize(n, 1.0f); sizeZ.resize(n, 1.0f);
+    }
+    void clear() {
+      for (std::vector<float>* lane : { &posX, &posY, &posZ, &rotX, &rotY, &rotZ, &rotW, &sizeX, &sizeY, &sizeZ }) lane->clear();
+    }
+
+    QuatTransform get(const size_t i) const {
+      QuatTransform t;
+      t.pos = { posX[i], posY[i], posZ[i], 1.0f };
+      t.rot = { rotX[i], rotY[i], rotZ[i], rotW[i] };
+      t.size = { sizeX[i], sizeY[i], sizeZ[i] };
+      return t;
+    }
+  };
+
+  namespace Detail {
+    // Four matrices transposed into lanes: translation, column lengths and the normalized 3x3 basis,
+    // basis[col * 3 + row] holds models[col * 4 + row] / size[col]
+    struct Decomposed4 {
+      Simd::Float4 pos[3], size[3], basis[9];
+    };
+
+    inline Decomposed4 decomposeLanes4(const Mat4* m) {
+      using Simd::Float4;
+
+      Float4 e[16];
+      for (int col = 0; col < 4; ++col) {
+        Float4* c = e + col * 4;
+        for (int l = 0; l < 4; ++l) c[l] = Float4::load(m[l].models + col * 4);
+        Simd::transpose(c[0], c[1], c[2], c[3]);
+      }
+
+      // Zero columns stay zero, like Mat4::decompose skipping the divide
+      const Float4 zero = Float4::splat(0.0f), one = Float4::splat(1.0f);
+      Decomposed4 d;
+      for (int col = 0; col < 3; ++col) {
+        const Float4* c = e + col * 4;
+        const Float4 len = Simd::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+        const Float4 inv = one / Simd::select(len > zero, len, one);
+        d.size[col] = len;
+        for (int row = 0; row < 3; ++row) d.basis[col * 3 + row] = c[row] * inv;
+      }
+      d.pos[0] = e[12]; d.pos[1] = e[13]; d.pos[2] = e[14];
+      return d;
+    }
+
+    // The first n lanes of v into dst[i, i + n)
+    inline void storeLanes(const Simd::Float4& v, std::vector<float>& dst, const size_t i, const size_t n) {
+      if (n == 4) { v.store(&dst[i]); return; }
+      for (size_t l = 0; l < n; ++l) dst[i + l] = v.lane(static_cast<int>(l));
+    }
+
+    // Runs fn(decomposed lanes, first index, lane count) over in, padding the last block with identities
+    template<typename Fn>
+    inline void forEachBlock4(std::span<const Mat4> in, Fn&& fn) {
+      size_t i = 0;
+      for (; i + 4 <= in.size(); i += 4) fn(decomposeLanes4(&in[i]), i, size_t(4));
+      if (i == in.size()) return;
+
+      Mat4 tail[4] = { Mat4::identity(), Mat4::identity(), Mat4::identity(), Mat4::identity() };
+      for (size_t l = 0; i + l < in.size(); ++l) tail[l] = in[i + l];
+      fn(decomposeLanes4(tail), i, in.size() - i);
+    }
+  }
+
+  /*
+  Batched decomposition of translation * rotation * scale matrices, four per pass
+  * Scale is the column lengths, so shear is folded into the rotation and mirroring is lost, see decomposePolar for those
+  * The Euler overload returns the same degrees as Mat4::decompose to within Fast::ATAN2_MAX_ERROR,
+    treating columns within 1e-6 of gimbal lock as locked instead of only exact zeros
+  * The quaternion overload matches Quat::fromMat4 and avoids the Euler singularity altogether
+  */
+  inline void decomposeBatch(std::span<const Mat4> in, TransformBatch& out) {
+    using Simd::Float4;
+    out.resize(in.size());
+
+    const Float4 toDegrees = Float4::splat(RAD_TO_DEG), zero = Float4::splat(0.0f);
+    Detail::forEachBlock4(in, [&](const Detail::Decomposed4& d, const size_t i, const size_t n) {
+      const Float4* b = d.basis;
+      // asin(-b[2]) as an atan2 over the unit column, accurate all the way to +-90 degrees
+      const Float4 cosY = Simd::sqrt(b[0] * b[0] + b[1] * b[1]);
+      const Float4 locked = cosY < Float4::splat(1e-6f);
+
+      const Float4 rotY = Fast::atan2(-b[2], cosY);
+      const Float4 rotX = Fast::atan2(Simd::select(locked, -b[6], b[5]), Simd::select(locked, b[4], b[8]));
+      const Float4 rotZ = Simd::select(locked, zero, Fast::atan2(b[1], b[0]));
+
+      Detail::storeLanes(d.pos[0], out.posX, i, n);
+      Detail::storeLanes(d.pos[1], out.posY, i, n);
+      Detail::storeLanes(d.pos[2], out.posZ, i, n);
+      Detail::storeLanes(rotX * toDegrees, out.rotX, i, n);
+      Detail::storeLanes(rotY * toDegrees, out.rotY, i, n);
+      Detail::storeLanes(rotZ * toDegrees, out.rotZ, i, n);
+      Detail::storeLanes(d.size[0], out.sizeX, i, n);
+      Detail::storeLanes(d.size[1], out.sizeY, i, n);
+      Detail::storeLanes(d.size[2], out.sizeZ, i, n);
+    });
+  }
+  inline void decomposeBatch(std::span<const Mat4> in, QuatTransformBatch& out) {
+    using Simd::Float4;
+    out.resize(in.size());
+
+    const Float4 zero = Float4::splat(0.0f), one = Float4::splat(1.0f), half = Float4::splat(0.5f);
+    Detail::forEachBlock4(in, [&](const Detail::Decomposed4& d, const size_t i, const size_t n) {
+      const Float4* b = d.basis;
+      const Float4 r00 = b[0], r10 = b[1], r20 = b[2];
+      const Float4 r01 = b[3], r11 = b[4], r21 = b[5];
+      const Float4 r02 = b[6], r12 = b[7], r22 = b[8];
+
+      // Quat::fromMat4's four branches as lane masks, each lane takes the largest diagonal term
+      const Float4 trace = r00 + r11 + r22;
+      const Float4 useW = trace > zero;
+      const Float4 useX = Simd::select(useW, zero, (r00 > r11) & (r00 > r22));
+      const Float4 useY = Simd::select(useW | useX, zero, r11 > r22);
+
+      const Float4 t = one + Simd::select(useW, trace,
+        Simd::select(useX, r00 - r11 - r22, Simd::select(useY, r11 - r00 - r22, r22 - r00 - r11)));
+      const Float4 s = half / Simd::sqrt(Simd::max(t, Float4::splat(1e-30f)));
+      const Float4 big = t * s;
+
+      const Float4 sx = r21 - r12, sy = r02 - r20, sz = r10 - r01;
+      const Float4 xy = r01 + r10, xz = r02 + r20, yz = r12 + r21;
+      // Lanes in none of the three masks took the r22 branch
+      Float4 qx = Simd::select(useW, sx * s, Simd::select(useX, big, Simd::select(useY, xy * s, xz * s)));
+      Float4 qy = Simd::select(useW, sy * s, Simd::select(useX, xy * s, Simd::select(useY, big, yz * s)));
+      Float4 qz = Simd::select(useW, sz * s, Simd::select(useX, xz * s, Simd::select(useY, yz * s, big)));
+      Float4 qw = Simd::select(useW, big, Simd::select(useX, sx * s, Simd::select(useY, sy * s, sz * s)));
+
+      // Sheared or degenerate bases are not orthonormal, renormalize like fromMat4 does
+      const Float4 len = Simd::sqrt(qx * qx + qy * qy + qz * qz + qw * qw);
+      const Float4 degenerate = len < Float4::splat(1e-6f);
+      const Float4 inv = one / Simd::select(degenerate, one, len);
+      qx = Simd::select(degenerate, zero, qx * inv); qy = Simd::select(degenerate, zero, qy * inv);
+      qz = Simd::select(degenerate, zero, qz * inv); qw = Simd::select(degenerate, one, qw * inv);
+
+      Detail::storeLanes(d.pos[0], out.posX, i, n);
+      Detail::storeLanes(d.pos[1], out.posY, i, n);
+      Detail::storeLanes(d.pos[2], out.posZ, i, n);
+      Detail::storeLanes(qx, out.rotX, i, n);
+      Detail::storeLanes(qy, out.rotY, i, n);
+      Detail::storeLanes(qz, out.rotZ, i, n);
+      Detail::storeLanes(qw, out.rotW, i, n);
+      Detail::storeLanes(d.size[0], out.sizeX, i, n);
+      Detail::storeLanes(d.size[1], out.sizeY, i, n);
+      Detail::storeLanes(d.size[2], out.sizeZ, i, n);
+    });
+  }
+
+  /*
+  PolarDecomposition
+  * m = translate(pos) * rot * stretch, with rot a proper rotation and stretch the remaining 3x3
+  * size is the diagonal of stretch, the off-diagonal entries are shear
+  * A mirroring matrix keeps rot proper and carries the flip as a negative size.x
+  */
+  struct PolarDecomposition {
+    Vec4<float> pos{ 0.0f, 0.0f, 0.0f, 1.0f };
+    Quat<float> rot{};
+    Vec3<float> size{ 1.0f };
+    Mat4 stretch = Mat4::identity();
+    bool reflected = false;
+
+    // Drops the shear, exact when m was built from a translation, rotation and (possibly negative) scale
+    QuatTransform toQuatTransform() const { return { pos, rot, size }; }
+    Mat4 compose() const {
+      Mat4 result = rot.toMat4() * stretch;
+      result.models[12] = pos.x;
+      result.models[13] = pos.y;
+      result.models[14] = pos.z;
+      return result;
+    }
+  };
+
+  namespace Detail {
+    // Unit vector along the largest column, then Gram-Schmidt, falling back to coordinate axes for missing columns.
+    // Only used for (near) singular matrices where the polar iteration has no inverse to work with.
+    inline void orthonormalBasis(const Vec3<float> (&c)[3], Vec3<float> (&u)[3]) {
+      const Vec3<float> axes[3] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+      const float len[3] = { c[0].dot(c[0]), c[1].dot(c[1]), c[2].dot(c[2]) };
+      const int i0 = len[0] >= len[1] ? (len[0] >= len[2] ? 0 : 2) : (len[1] >= len[2] ? 1 : 2);
+      const int i1 = len[(i0 + 1) % 3] >= len[(i0 + 2) % 3] ? (i0 + 1) % 3 : (i0 + 2) % 3;
+      const int i2 = 3 - i0 - i1;
+
+      const auto unit = [](const Vec3<float>& v) { const float l = v.dot(v); return l > 1e-24f ? v * (1.0f / std::sqrt(l)) : Vec3<float>(0.0f); };
+      u[i0] = len[i0] > 1e-24f ? unit(c[i0]) : axes[i0];
+      for (const Vec3<float>& candidate : { c[i1], axes[i1], axes[i2], axes[i0] }) {
+        u[i1] = unit(candidate - u[i0] * u[i0].dot(candidate));
+        if (u[i1].dot(u[i1]) > 0.5f) break;
+      }
+      // Completing in cyclic order keeps the determinant at +1
+      u[i2] = i1 == (i0 + 1) % 3 ? u[i0].cross(u[i1]) : u[i1].cross(u[i0]);
+    }
+  }
+
+  /*
+  Robust decomposition through the polar decomposition of the upper 3x3
+  * Scaled Newton iteration Q <- (g * Q + Q^-T / g) / 2 converges to the closest rotation in a handful of steps
+  * Handles shear, non-uniform and negative scale, singular matrices fall back to a Gram-Schmidt basis
+  * Scalar and iterative, a few times the cost of Mat4::decompose, so keep it for matrices that may carry shear or mirroring
+  */
+  inline PolarDecomposition decomposePolar(const Mat4& m) {
+    PolarDecomposition result;
+    result.pos = { m.models[12], m.models[13], m.models[14], 1.0f };
+
+    const Vec3<float> cols[3] = {
+      { m.models[0], m.models[1], m.models[2] },
+      { m.models[4], m.models[5], m.models[6] },
+      { m.models[8], m.models[9], m.models[10] }
+    };
+    const float det = cols[0].dot(cols[1].cross(cols[2]));
+    const float volume = std::sqrt(cols[0].dot(cols[0]) * cols[1].dot(cols[1]) * cols[2].dot(cols[2]));
+    result.reflected = det < 0.0f;
+
+    Vec3<float> q[3];
+    if (std::abs(det) <= 1e-6f * volume) Detail::orthonormalBasis(cols, q);
+    else {
+      // Flipping x first gives a positive determinant, so the iteration lands on a proper rotation
+      q[0] = result.reflected ? -cols[0] : cols[0];
+      q[1] = cols[1];
+      q[2] = cols[2];
+      for (int iteration = 0; iteration < 32; ++iteration) {
+        // Q^-T is the cofactor matrix over the determinant
+        const float qDet = q[0].dot(q[1].cross(q[2]));
+        const Vec3<float> invT[3] = { q[1].cross(q[2]) / qDet, q[2].cross(q[0]) / qDet, q[0].cross(q[1]) / qDet };
+
+        const float norm = q[0].dot(q[0]) + q[1].dot(q[1]) + q[2].dot(q[2]);
+        const float invNorm = invT[0].dot(invT[0]) + invT[1].dot(invT[1]) + invT[2].dot(invT[2]);
+        const float g = std::sqrt(std::sqrt(invNorm / norm));
+
+        float change = 0.0f;
+        for (int c = 0; c < 3; ++c) {
+          const Vec3<float> next = (q[c] * g + invT[c] / g) * 0.5f;
+          const Vec3<float> delta = next - q[c];
+          change += delta.dot(delta);
+          q[c] = next;
+        }
+        if (change < 1e-12f) break;
+      }
+    }
+
+    Mat4 r = Mat4::identity();
+    for (int c = 0; c < 3; ++c) {
+      r.models[c * 4 + 0] = q[c].x;
+      r.models[c * 4 + 1] = q[c].y;
+      r.models[c * 4 + 2] = q[c].z;
+    }
+    result.rot = Quat<float>::fromMat4(r);
+
+    // stretch = R^T * m, computed against the quaternion's own matrix so compose() round-trips
+    const Mat4 rq = result.rot.toMat4();
+    const Vec3<float> axes[3] = {
+      { rq.models[0], rq.models[1], rq.models[2] },
+      { rq.models[4], rq.models[5], rq.models[6] },
+      { rq.models[8], rq.models[9], rq.models[10] }
+    };
+    for (int c = 0; c < 3; ++c)
+      for (int row = 0; row < 3; ++row)
+        result.stretch.models[c * 4 + row] = axes[row].dot(cols[c]);
+    result.size = { result.stretch.models[0], result.stretch.models[5], result.stretch.models[10] };
+    return result;
+  }
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "mat4.hpp"
+#include "simd.hpp"
+#include "vec3.hpp"
+#include "vec4.hpp"
+#include "constants.hpp"
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+namespace Starlet::Math::Fast {
+  /*
+  Fast
+  * Opt-in approximations for paths that can trade a few ULPs for speed (culling, LOD)
+  * Error bounds below are checked by tests/fast_math_test.cpp against the exact path
+  */
+
+  // Absolute error of sin/cos/sincos for |x| <= SINCOS_MAX_INPUT radians
+  constexpr float SINCOS_MAX_ERROR = 1.5e-7f;
+  // Beyond this the three-part pi/2 reduction loses bits and the error grows with |x|
+  constexpr float SINCOS_MAX_INPUT = 8192.0f;
+  // Relative error of rsqrt and rcp for normal, finite, non-zero inputs
+  constexpr float RSQRT_MAX_REL_ERROR = 5e-7f;
+  constexpr float RCP_MAX_REL_ERROR = 3e-7f;
+  // Absolute error of atan2 in radians, any finite inputs
+  constexpr float ATAN2_MAX_ERROR = 4e-7f;
+
+  namespace Detail {
+    constexpr float TWO_OVER_PI = 0.636619772367581343f;
+    // pi/2 split in three so the leading products stay exact for small quadrant counts
+    constexpr float PIO2_A = 1.5703125f;
+    constexpr float PIO2_B = 4.837512969970703125e-4f;
+    constexpr float PIO2_C = 7.54978995489188216e-8f;
+    constexpr float PI = 3.14159265358979323846f;
+    constexpr float TAN_PI_OVER_8 = 0.414213562373095049f;
+
+    template<typename S>
+    inline S splat(const float v) {
+      if constexpr (std::is_same_v<S, float>) return v;
+      else return S::splat(v);
+    }
+
+    // Minimax polynomials on [-pi/4, pi/4]
+    template<typename S>
+    inline S sinPoly(const S& r, const S& r2) {
+      S p = Simd::madd(r2, splat<S>(-1.9515295891e-4f), splat<S>(8.3321608736e-3f));
+      p = Simd::madd(r2, p, splat<S>(-1.6666654611e-1f));
+      return Simd::madd(r * r2, p, r);
+    }
+    template<typename S>
+    inline S cosPoly(const S& r2) {
+      S p = Simd::madd(r2, splat<S>(2.443315711809948e-5f), splat<S>(-1.388731625493765e-3f));
+      p = Simd::madd(r2, p, splat<S>(4.166664568298827e-2f));
+      return Simd::madd(r2 * r2, p, Simd::madd(r2, splat<S>(-0.5f), splat<S>(1.0f)));
+    }
+  }
+
+  inline void sincos(const float x, float& s, float& c) {
+    const int q = static_cast<int>(x * Detail::TWO_OVER_PI + (x >= 0.0f ? 0.5f : -0.5f));
+    const float qf = static_cast<float>(q);
+    const float r = ((x - qf * Detail::PIO2_A) - qf * Detail::PIO2_B) - qf * Detail::PIO2_C;
+    const float r2 = r * r;
+
+    const float ps = Detail::sinPoly(r, r2);
+    const float pc = Detail::cosPoly(r2);
+
+    // Odd quadrants swap sin and cos, bit 1 of q (and of q + 1 for cos) flips the sign
+    const bool swap = (q & 1) != 0;
+    s = swap ? pc : ps;
+    c = swap ? ps : pc;
+    s = std::bit_cast<float>(std::bit_cast<std::uint32_t>(s) ^ (static_cast<std::uint32_t>(q & 2) << 30));
+    c = std::bit_cast<float>(std::bit_cast<std::uint32_t>(c) ^ (static_cast<std::uint32_t>((q + 1) & 2) << 30));
+  }
+  inline float sin(const float x) { float s, c; sincos(x, s, c); return s; }
+  inline float cos(const float x) { float s, c; sincos(x, s, c); return c; }
+
+  // One Newton step on the hardware estimate, the scalar fallback needs three from the bit trick
+  inline float rsqrt(const float x) {
+#ifdef STARLET_MATH_SSE
+    const float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+    return y * (1.5f - 0.5f * x * y * y);
+#else
+    float y = std::bit_cast<float>(0x5f375a86u - (std::bit_cast<std::uint32_t>(x) >> 1));
+    for (int i = 0; i < 3; ++i) y = y * (1.5f - 0.5f * x * y * y);
+    return y;
+#endif
+  }
+  inline float rcp(const float x) {
+#ifdef STARLET_MATH_SSE
+    const float y = _mm_cvtss_f32(_mm_rcp_ss(_mm_set_ss(x)));
+    return y * (2.0f - x * y);
+#else
+    return 1.0f / x;
+#endif
+  }
+  inline float tan(const float x) { float s, c; sincos(x, s, c); return s * rcp(c); }
+
+  // Folds into atan of [0, tan(pi/8)] and evaluates a minimax polynomial there, no libm call
+  inline float atan2(const float y, const float x) {
+    const float ax = std::abs(x), ay = std::abs(y);
+    const bool steep = ay > ax;
+    const float t = steep ? (ay > 0.0f ? ax / ay : 0.0f) : (ax > 0.0f ? ay / ax : 0.0f);
+
+    const bool upper = t > Detail::TAN_PI_OVER_8;
+    const float r = upper ? (t - 1.0f) / (t + 1.0f) : t;
+    const float z = r * r;
+    float a = (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z * r + r;
+    if (upper) a += 0.25f * Detail::PI;
+
+    if (steep) a = 0.5f * Detail::PI - a;
+    if (x < 0.0f) a = Detail::PI - a;
+    return std::signbit(y) ? -a : a;
+  }
+
+  inline float length(const Vec3<float>& v) {
+    const float lenSq = v.x * v.x + v.y * v.y + v.z * v.z;
+    return lenSq < 1e-30f ? 0.0f : lenSq * rsqrt(lenSq);
+  }
+  // Same zero-length cutoff as Vec3::normalized
+  inline Vec3<float> normalized(const Vec3<float>& v) {
+    const float lenSq = v.x * v.x + v.y * v.y + v.z * v.z;
+    if (lenSq < 1e-12f) return Vec3<float>(0.0f);
+    return v * rsqrt(lenSq);
+  }
+  inline Vec4<float> normalized(const Vec4<float>& v) {
+    const float lenSq = v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w;
+    if (lenSq < 1e-12f) return Vec4<float>(0.0f);
+    return v * rsqrt(lenSq);
+  }
+
+  inline Simd::Float4 rsqrt(const Simd::Float4& x) {
+#ifdef STARLET_MATH_SSE
+    const Simd::Float4 y{ _mm_rsqrt_ps(x.v) };
+    return y * (Simd::Float4::splat(1.5f) - Simd::Float4::splat(0.5f) * x * y * y);
+#else
+    return Simd::Float4::set(rsqrt(x.v[0]), rsqrt(x.v[1]), rsqrt(x.v[2]), rsqrt(x.v[3]));
+#endif
+  }
+  inline Simd::Float4 rcp(const Simd::Float4& x) {
+#ifdef STARLET_MATH_SSE
+    const Simd::Float4 y{ _mm_rcp_ps(x.v) };
+    return y * (Simd::Float4::splat(2.0f) - x * y);
+#else
+    return Simd::Float4::splat(1.0f) / x;
+#endif
+  }
+  inline void sincos(const Simd::Float4& x, Simd::Float4& s, Simd::Float4& c) {
+#ifdef STARLET_MATH_SSE
+    using Simd::Float4;
+    const __m128i q = _mm_cvtps_epi32((x * Float4::splat(Detail::TWO_OVER_PI)).v);
+    const Float4 qf{ _mm_cvtepi32_ps(q) };
+    const Float4 r = ((x - qf * Float4::splat(Detail::PIO2_A)) - qf * Float4::splat(Detail::PIO2_B)) - qf * Float4::splat(Detail::PIO2_C);
+    const Float4 r2 = r * r;
+
+    const Float4 ps = Detail::sinPoly(r, r2);
+    const Float4 pc = Detail::cosPoly(r2);
+
+    const __m128i one = _mm_set1_epi32(1), two = _mm_set1_epi32(2);
+    const Float4 swap{ _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, one), one)) };
+    const __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, two), 30));
+    const __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, one), two), 30));
+    s = { _mm_xor_ps(Simd::select(swap, pc, ps).v, sinSign) };
+    c = { _mm_xor_ps(Simd::select(swap, ps, pc).v, cosSign) };
+#else
+    for (int i = 0; i < 4; ++i) sincos(x.v[i], s.v[i], c.v[i]);
+#endif
+  }
+  // Same folding and polynomial as the scalar atan2, the quadrant fix-ups become selects
+  inline Simd::Float4 atan2(const Simd::Float4& y, const Simd::Float4& x) {
+#ifdef STARLET_MATH_SSE
+    using Simd::Float4;
+    const Float4 zero = Float4::splat(0.0f), one = Float4::splat(1.0f);
+    const Float4 ax = Simd::max(x, -x), ay = Simd::max(y, -y);
+    const Float4 steep = ay > ax;
+    const Float4 num = Simd::select(steep, ax, ay), den = Simd::select(steep, ay, ax);
+    const Float4 t = Simd::select(den > zero, num / Simd::select(den > zero, den, one), zero);
+
+    const Float4 upper = t > Float4::splat(Detail::TAN_PI_OVER_8);
+    const Float4 r = Simd::select(upper, (t - one) / (t + one), t);
+    const Float4 z = r * r;
+    Float4 p = Simd::madd(z, Float4::splat(8.05374449538e-2f), Float4::splat(-1.38776856032e-1f));
+    p = Simd::madd(p, z, Float4::splat(1.99777106478e-1f));
+    p = Simd::madd(p, z, Float4::splat(-3.33329491539e-1f));
+    Float4 a = Simd::madd(p * z, r, r);
+    a = Simd::select(upper, a + Float4::splat(0.25f * Detail::PI), a);
+
+    a = Simd::select(steep, Float4::splat(0.5f * Detail::PI) - a, a);
+    a = Simd::select(x < zero, Float4::splat(Detail::PI) - a, a);
+    return { _mm_xor_ps(a.v, _mm_and_ps(y.v, _mm_set1_ps(-0.0f))) };
+#else
+    return Simd::Float4::set(atan2(y.v[0], x.v[0]), atan2(y.v[1], x.v[1]), atan2(y.v[2], x.v[2]), atan2(y.v[3], x.v[3]));
+#endif
+  }
+
+  // Same layouts as the Mat4 builders, with the polynomial sincos
+  inline Mat4 rotateX(const float angle) {
+    float s, c;
+    sincos(radians(angle), s, c);
+
+    Mat4 result = Mat4::identity();
+    result.models[5] = c;
+    result.models[6] = s;
+    result.models[9] = -s;
+    result.models[10] = c;
+    return result;
+  }
+  inline Mat4 rotateY(const float angle) {
+    float s, c;
+    sincos(radians(angle), s, c);
+
+    Mat4 result = Mat4::identity();
+    result.models[0] = c;
+    result.models[2] = s;
+    result.models[8] = -s;
+    result.models[10] = c;
+    return result;
+  }
+  inline Mat4 rotateZ(const float angle) {
+    float s, c;
+    sincos(radians(angle), s, c);
+
+    Mat4 result = Mat4::identity();
+    result.models[0] = c;
+    result.models[1] = s;
+    result.models[4] = -s;
+    result.models[5] = c;
+    return result;
+  }
+  inline Mat4 fromTRS(const Vec4<float>& pos, const Vec3<float>& rot, const Vec3<float>& size) {
+    float sx, cx, sy, cy, sz, cz;
+    sincos(radians(rot.x), sx, cx);
+    sincos(radians(rot.y), sy, cy);
+    sincos(radians(rot.z), sz, cz);
+
+    Mat4 result;
+    Math::Detail::composeTRS(sx, cx, sy, cy, sz, cz, size.x, size.y, size.z, result.models);
+    result.models[12] = pos.x;
+    result.models[13] = pos.y;
+    result.models[14] = pos.z;
+    result.models[15] = 1.0f;
+    return result;
+  }
+  inline Mat4 fromTRS(const Transform& t) { return fromTRS(t.pos, t.rot, t.size); }
+  inline Mat4 perspective(const float degFov, const float aspect, const float nearPlane, const float farPlane) {
+    float s, c;
+    sincos(radians(degFov) * 0.5f, s, c);
+    const float cotHalfFov = c * rcp(s);
+    const float invDepth = rcp(nearPlane - farPlane);
+
+    Mat4 projection{};
+    projection.models[0] = cotHalfFov * rcp(aspect);
+    projection.models[5] = cotHalfFov;
+    projection.models[10] = (farPlane + nearPlane) * invDepth;
+    projection.models[11] = -1.0f;
+    projection.models[14] = 2.0f * farPlane * nearPlane * invDepth;
+    projection.models[15] = 0.0f;
+    return projection;
+  }
+}
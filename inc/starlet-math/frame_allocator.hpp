@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Starlet::Math {
+  // Sizes are in bytes, everything but peak counts since the last reset
+  struct ArenaStats {
+    size_t capacity = 0;     // bytes the arena serves without touching the heap
+    size_t used = 0;         // bytes handed out, overflow included, with alignment padding
+    size_t peak = 0;         // largest used seen at any reset, the capacity that would never overflow
+    size_t allocations = 0;
+    size_t overflowed = 0;   // bytes that did not fit and came from the heap
+
+    ArenaStats& operator+=(const ArenaStats& o) {
+      capacity += o.capacity; used += o.used; peak += o.peak;
+      allocations += o.allocations; overflowed += o.overflowed;
+      return *this;
+    }
+  };
+
+  /*
+  LinearArena
+  * One 64-byte aligned block, allocation rounds up to a cache line and bumps an offset, reset() frees everything at once
+  * Arrays come back uninitialized as std::span<T>, T must be trivially copyable (Mat4, Vertex, Transform, vectors)
+  * A request that does not fit is served from a separate heap block and counted as overflow, it never fails;
+    the next reset() releases those blocks and grows the arena to the peak so later frames fit again
+  * Not thread safe, give each thread its own arena (FrameAllocator::claimWorker)
+  * Aligned to a cache line itself, so arenas stored side by side for workers never share one
+  */
+  class alignas(64) LinearArena {
+  public:
+    static constexpr size_t Alignment = 64;
+
+    LinearArena() = default;
+    explicit LinearArena(const size_t capacity) { grow(capacity); }
+    ~LinearArena() { releaseOverflow(); release(base); }
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+    LinearArena(LinearArena&& o) noexcept { swap(o); }
+    LinearArena& operator=(LinearArena&& o) noexcept { LinearArena moved(std::move(o)); swap(moved); return *this; }
+
+    template<typename T>
+    std::span<T> allocate(const size_t count) {
+      static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>, "arena memory is never constructed or destroyed");
+      static_assert(alignof(T) <= Alignment, "type is over-aligned for the arena");
+      return { static_cast<T*>(allocateBytes(count * sizeof(T))), count };
+    }
+
+    // Offsets stay multiples of Alignment, so the fast path is one add and one compare
+    void* allocateBytes(const size_t bytes) {
+      const size_t end = offset + roundUp(bytes);
+      ++allocations;
+      if (end <= cap) {
+        void* p = base + offset;
+        offset = end;
+        return p;
+      }
+      return allocateOverflow(bytes);
+    }
+
+    void reset() {
+      peakBytes = std::max(peakBytes, used());
+      if (!overflow.empty()) {
+        releaseOverflow();
+        grow(peakBytes);
+      }
+      offset = 0;
+      overflowBytes = 0;
+      allocations = 0;
+    }
+
+    size_t capacity() const { return cap; }
+    size_t used() const { return offset + overflowBytes; }
+    ArenaStats stats() const { return { cap, used(), std::max(peakBytes, used()), allocations, overflowBytes }; }
+
+  private:
+    std::byte* base = nullptr;
+    size_t cap = 0;
+    size_t offset = 0;
+    size_t allocations = 0;
+    size_t overflowBytes = 0;
+    size_t peakBytes = 0;
+    std::vector<std::byte*> overflow;
+
+    static size_t roundUp(const size_t bytes) { return (bytes + Alignment - 1) & ~(Alignment - 1); }
+    static std::byte* acquire(const size_t bytes) {
+      return static_cast<std::byte*>(::operator new(bytes, std::align_val_t(Alignment)));
+    }
+    static void release(std::byte* p) {
+      if (p) ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    void grow(const size_t bytes) {
+      const size_t rounded = roundUp(bytes);
+      if (rounded <= cap) return;
+      release(base);
+      base = nullptr;  // acquire may throw
+      cap = 0;
+      base = acquire(rounded);
+      cap = rounded;
+    }
+    void releaseOverflow() {
+      for (std::byte* p : overflow) release(p);
+      overflow.clear();
+    }
+    void* allocateOverflow(const size_t bytes) {
+      const size_t rounded = roundUp(std::max<size_t>(bytes, 1));
+      overflow.push_back(acquire(rounded));
+      overflowBytes += rounded;
+      return overflow.back();
+    }
+
+    void swap(LinearArena& o) noexcept {
+      std::swap(base, o.base);
+      std::swap(cap, o.cap);
+      std::swap(offset, o.offset);
+      std::swap(allocations, o.allocations);
+      std::swap(overflowBytes, o.overflowBytes);
+      std::swap(peakBytes, o.peakBytes);
+      std::swap(overflow, o.overflow);
+    }
+  };
+
+  /*
+  FrameAllocator
+  * A ring of Frames sets of arenas, triple-buffered by default, for per-frame scratch such as instance matrices
+  * beginFrame() moves to the next set and resets it, so memory from the previous Frames - 1 frames stays valid
+    while the GPU may still read it; call it once the frame that used the set has been retired
+  * Each set has a main arena for the owning thread and workerCount arenas for worker threads;
+    claimWorker() binds one of them to the calling thread until the next beginFrame(), the first call per
+    thread costs one atomic increment and later calls hit a thread_local cache, no locks either way
+  * Once every worker arena is bound, claimWorker() returns nullptr for further threads in that frame
+  */
+  namespace Detail {
+    inline std::atomic<std::uint64_t> frameEpochs{ 0 };
+
+    // Worker arenas bound to this thread, keyed by frame set epoch; a few slots so interleaved allocators coexist
+    struct WorkerBinding {
+      std::uint64_t epoch = 0;
+      LinearArena* arena = nullptr;
+    };
+    inline thread_local std::array<WorkerBinding, 4> workerBindings{};
+    inline thread_local size_t nextWorkerBinding = 0;
+  }
+
+  template<size_t Frames = 3>
+  class FrameAllocator {
+  public:
+    static_assert(Frames >= 1);
+
+    explicit FrameAllocator(const size_t frameBytes, const size_t workerCount = 0, const size_t workerBytes = 0) {
+      for (FrameSet& f : sets) {
+        f.main = LinearArena(frameBytes);
+        f.workers.reserve(workerCount);
+        for (size_t w = 0; w < workerCount; ++w) f.workers.emplace_back(workerBytes);
+        f.epoch = newEpoch();
+      }
+    }
+
+    void beginFrame() {
+      slot = (slot + 1) % Frames;
+      ++frameNumber;
+      FrameSet& f = sets[slot];
+      f.main.reset();
+      for (LinearArena& w : f.workers) w.reset();
+      f.claimed.store(0, std::memory_order_relaxed);
+      f.epoch = newEpoch();
+    }
+
+    // Frames begun so far, the constructor leaves frame 0 ready for use
+    std::uint64_t frame() const { return frameNumber; }
+
+    LinearArena& arena() { return sets[slot].main; }
+    template<typename T>
+    std::span<T> allocate(const size_t count) { return arena().template allocate<T>(count); }
+
+    size_t workerCount() const { return sets[slot].workers.size(); }
+    LinearArena& worker(const size_t index) {
+      assert(index < workerCount());
+      return sets[slot].workers[index];
+    }
+    // The calling thread's worker arena for this frame, the same one on every call until beginFrame();
+    // nullptr when more threads than workerCount ask in one frame
+    LinearArena* claimWorker() {
+      FrameSet& f = sets[slot];
+      for (const Detail::WorkerBinding& b : Detail::workerBindings)
+        if (b.epoch == f.epoch) return b.arena;
+
+      const size_t index = f.claimed.fetch_add(1, std::memory_order_relaxed);
+      LinearArena* arena = index < f.workers.size() ? &f.workers[index] : nullptr;
+      Detail::workerBindings[Detail::nextWorkerBinding] = { f.epoch, arena };
+      Detail::nextWorkerBinding = (Detail::nextWorkerBinding + 1) % Detail::workerBindings.size();
+      return arena;
+    }
+
+    // Main and worker arenas of the current frame added together
+    ArenaStats stats() const {
+      const FrameSet& f = sets[slot];
+      ArenaStats total = f.main.stats();
+      for (const LinearArena& w : f.workers) total += w.stats();
+      return total;
+    }
+
+  private:
+    struct FrameSet {
+      LinearArena main;
+      std::vector<LinearArena> workers;
+      std::atomic<size_t> claimed{ 0 };
+      std::uint64_t epoch = 0;
+    };
+
+    // Unique across every allocator, so a stale thread_local binding can never match a later frame
+    static std::uint64_t newEpoch() { return Detail::frameEpochs.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+    std::array<FrameSet, Frames> sets;
+    size_t slot = 0;
+    std::uint64_t frameNumber = 0;
+  };
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "mat4.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
+#include "vec3.hpp"
+#include "vec4.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Starlet::Math {
+  // Bounding spheres as parallel component arrays, all spans the same length
+  struct SphereBoundsSoA {
+    std::span<const float> x, y, z, radius;
+    size_t size() const { return x.size(); }
+  };
+  // Axis-aligned boxes as parallel component arrays, all spans the same length
+  struct BoxBoundsSoA {
+    std::span<const float> minX, minY, minZ;
+    std::span<const float> maxX, maxY, maxZ;
+    size_t size() const { return minX.size(); }
+  };
+
+  /*
+  Frustum
+  * Six inward-facing planes (xyz normal, w distance) extracted from a view-projection matrix
+  * Assumes OpenGL clip space, matching Mat4::perspective
+  * Batch culling writes one visibility bit per object, bit (i % 8) of byte (i / 8)
+  */
+  struct Frustum {
+    enum Plane { Left, Right, Bottom, Top, Near, Far, PlaneCount };
+
+    Vec4<float> planes[PlaneCount];
+
+    Frustum() = default;
+    explicit Frustum(const Mat4& viewProjection) {
+      const float* m = viewProjection.models;
+      const Vec4<float> row0{ m[0], m[4], m[8], m[12] };
+      const Vec4<float> row1{ m[1], m[5], m[9], m[13] };
+      const Vec4<float> row2{ m[2], m[6], m[10], m[14] };
+      const Vec4<float> row3{ m[3], m[7], m[11], m[15] };
+
+      planes[Left] = row3 + row0;
+      planes[Right] = row3 - row0;
+      planes[Bottom] = row3 + row1;
+      planes[Top] = row3 - row1;
+      planes[Near] = row3 + row2;
+      planes[Far] = row3 - row2;
+
+      for (Vec4<float>& p : planes) {
+        const float len = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+        if (len > 0.0f) p /= len;
+      }
+    }
+
+    float distance(const Plane plane, const Vec3<float>& point) const {
+      const Vec4<float>& p = planes[plane];
+      return p.x * point.x + p.y * point.y + p.z * point.z + p.w;
+    }
+
+    bool containsPoint(const Vec3<float>& point) const {
+      for (int i = 0; i < PlaneCount; ++i)
+        if (distance(Plane(i), point) < 0.0f) return false;
+      return true;
+    }
+    bool intersectsSphere(const Vec3<float>& center, const float radius) const {
+      for (int i = 0; i < PlaneCount; ++i)
+        if (distance(Plane(i), center) < -radius) return false;
+      return true;
+    }
+    // Tests the box corner furthest along each plane normal, conservative near frustum corners
+    bool intersectsAABB(const Vec3<float>& min, const Vec3<float>& max) const {
+      for (const Vec4<float>& p : planes) {
+        const Vec3<float> corner{ p.x >= 0.0f ? max.x : min.x, p.y >= 0.0f ? max.y : min.y, p.z >= 0.0f ? max.z : min.z };
+        if (p.x * corner.x + p.y * corner.y + p.z * corner.z + p.w < 0.0f) return false;
+      }
+      return true;
+    }
+
+    // mask needs (bounds.size() + 7) / 8 bytes
+    void cullSpheres(const SphereBoundsSoA& bounds, std::uint8_t* mask) const {
+      cullSpheresRange(bounds, mask, 0, bounds.size());
+    }
+    void cullBoxes(const BoxBoundsSoA& bounds, std::uint8_t* mask) const {
+      cullBoxesRange(bounds, mask, 0, bounds.size());
+    }
+
+    // Writes the indices of visible objects in ascending order, returns how many
+    size_t cullSpheresCompact(const SphereBoundsSoA& bounds, std::uint32_t* indices) const {
+      std::uint8_t mask[BlockSize / 8];
+      size_t count = 0;
+      for (size_t begin = 0; begin < bounds.size(); begin += BlockSize) {
+        const size_t end = std::min(bounds.size(), begin + BlockSize);
+        cullSpheresRange(bounds, mask, begin, end);
+        count += compact(mask, begin, end, indices + count);
+      }
+      return count;
+    }
+    size_t cullBoxesCompact(const BoxBoundsSoA& bounds, std::uint32_t* indices) const {
+      std::uint8_t mask[BlockSize / 8];
+      size_t count = 0;
+      for (size_t begin = 0; begin < bounds.size(); begin += BlockSize) {
+        const size_t end = std::min(bounds.size(), begin + BlockSize);
+        cullBoxesRange(bounds, mask, begin, end);
+        count += compact(mask, begin, end, indices + count);
+      }
+      return count;
+    }
+
+    // Same output as cullSpheres/cullBoxes, split across threads (0 = all hardware threads)
+    void cullSpheresParallel(const SphereBoundsSoA& bounds, std::uint8_t* mask, const unsigned threads = 0) const {
+      parallelFor(bounds.size(), ParallelGrain, [&](size_t begin, size_t end) { cullSpheresRange(bounds, mask + begin / 8, begin, end); }, threads);
+    }
+    void cullBoxesParallel(const BoxBoundsSoA& bounds, std::uint8_t* mask, const unsigned threads = 0) const {
+      parallelFor(bounds.size(), ParallelGrain, [&](size_t begin, size_t end) { cullBoxesRange(bounds, mask + begin / 8, begin, end); }, threads);
+    }
+
+  private:
+    static constexpr size_t BlockSize = 1024;
+    static constexpr size_t ParallelGrain = 4096;
+
+    static size_t compact(const std::uint8_t* mask, const size_t begin, const size_t end, std::uint32_t* indices) {
+      size_t count = 0;
+      for (size_t i = begin; i < end; ++i)
+        if (mask[(i - begin) / 8] & (1u << (i % 8)))
+          indices[count++] = static_cast<std::uint32_t>(i);
+      return count;
+    }
+
+    // begin must be a multiple of 8, mask points at the byte holding object begin
+    void cullSpheresRange(const SphereBoundsSoA& b, std::uint8_t* mask, const size_t begin, const size_t end) const {
+      using Simd::Float4;
+
+      const Float4 zero = Float4::splat(0.0f);
+      size_t i = begin;
+      for (; i + 8 <= end; i += 8) {
+        const Float4 x0 = Float4::load(&b.x[i]), x1 = Float4::load(&b.x[i + 4]);
+        const Float4 y0 = Float4::load(&b.y[i]), y1 = Float4::load(&b.y[i + 4]);
+        const Float4 z0 = Float4::load(&b.z[i]), z1 = Float4::load(&b.z[i + 4]);
+        const Float4 r0 = -Float4::load(&b.radius[i]), r1 = -Float4::load(&b.radius[i + 4]);
+
+        Float4 in0 = zero == zero, in1 = zero == zero;
+        for (const Vec4<float>& p : planes) {
+          const Float4 nx = Float4::splat(p.x), ny = Float4::splat(p.y), nz = Float4::splat(p.z), d = Float4::splat(p.w);
+          in0 = in0 & (Simd::madd(nx, x0, Simd::madd(ny, y0, Simd::madd(nz, z0, d))) >= r0);
+          in1 = in1 & (Simd::madd(nx, x1, Simd::madd(ny, y1, Simd::madd(nz, z1, d))) >= r1);
+        }
+        mask[(i - begin) / 8] = static_cast<std::uint8_t>(Simd::moveMask(in0) | (Simd::moveMask(in1) << 4));
+      }
+      if (i < end) {
+        std::uint8_t bits = 0;
+        for (size_t k = i; k < end; ++k)
+          if (intersectsSphere({ b.x[k], b.y[k], b.z[k] }, b.radius[k])) bits |= std::uint8_t(1u << (k - i));
+        mask[(i - begin) / 8] = bits;
+      }
+    }
+    void cullBoxesRange(const BoxBoundsSoA& b, std::uint8_t* mask, const size_t begin, const size_t end) const {
+      using Simd::Float4;
+
+      // The furthest corner along each plane normal only depends on the normal's signs
+      const float* cornerX[PlaneCount];
+      const float* cornerY[PlaneCount];
+      const float* cornerZ[PlaneCount];
+      for (int p = 0; p < PlaneCount; ++p) {
+        cornerX[p] = planes[p].x >= 0.0f ? b.maxX.data() : b.minX.data();
+        cornerY[p] = planes[p].y >= 0.0f ? b.maxY.data() : b.minY.data();
+        cornerZ[p] = planes[p].z >= 0.0f ? b.maxZ.data() : b.minZ.data();
+      }
+
+      const Float4 zero = Float4::splat(0.0f);
+      size_t i = begin;
+      for (; i + 8 <= end; i += 8) {
+        Float4 in0 = zero == zero, in1 = zero == zero;
+        for (int p = 0; p < PlaneCount; ++p) {
+          const Vec4<float>& pl = planes[p];
+          const Float4 nx = Float4::splat(pl.x), ny = Float4::splat(pl.y), nz = Float4::splat(pl.z), d = Float4::splat(pl.w);
+          const float* cx = cornerX[p] + i;
+          const float* cy = cornerY[p] + i;
+          const float* cz = cornerZ[p] + i;
+          in0 = in0 & (Simd::madd(nx, Float4::load(cx), Simd::madd(ny, Float4::load(cy), Simd::madd(nz, Float4::load(cz), d))) >= zero);
+          in1 = in1 & (Simd::madd(nx, Float4::load(cx + 4), Simd::madd(ny, Float4::load(cy + 4), Simd::madd(nz, Float4::load(cz + 4), d))) >= zero);
+        }
+        mask[(i - begin) / 8] = static_cast<std::uint8_t>(Simd::moveMask(in0) | (Simd::moveMask(in1) << 4));
+      }
+      if (i < end) {
+        std::uint8_t bits = 0;
+        for (size_t k = i; k < end; ++k)
+          if (intersectsAABB({ b.minX[k], b.minY[k], b.minZ[k] }, { b.maxX[k], b.maxY[k], b.maxZ[k] })) bits |= std::uint8_t(1u << (k - i));
+        mask[(i - begin) / 8] = bits;
+      }
+    }
+  };
+}
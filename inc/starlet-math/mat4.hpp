@@ -2,302 +2,600 @@
 
 #include "vec3.hpp"
 #include "vec4.hpp"
+#include "vec4f.hpp"
 #include "transform.hpp"
 #include "constants.hpp"
+#include "mat4_kernels.hpp"
+#include "simd.hpp"
+#include "constexpr_math.hpp"
 #include <cmath>
+#include <cstddef>
+#include <type_traits>
 
 namespace Starlet::Math {
-  struct Mat4 {
-    float models[16]{ 0.0f };
-
-    inline const float* ptr() const { return models; }
-    inline float* ptr() { return models; }
-
-    static Mat4 identity() {
-      Mat4 result;
-      result.models[0] = 1.0f;
-      result.models[5] = 1.0f;
-      result.models[10] = 1.0f;
-      result.models[15] = 1.0f;
-      return result;
-    }
-    static Mat4 modelMatrix(const Transform& t) {
-      return Mat4::translation(t.pos)
-        * Mat4::rotateX(t.rot.x)
-        * Mat4::rotateY(t.rot.y)
-        * Mat4::rotateZ(t.rot.z)
-        * Mat4::size(t.size);
+  namespace Detail {
+    // Same rounding as radians() for float, full precision for double
+    template<typename T>
+    constexpr T toRadians(const T degrees) { return degrees * static_cast<T>(0.01745329251994329576923690768489L); }
+
+    // Rotation-and-scale block of translation * rotateX * rotateY * rotateZ * size, written out entry by entry
+    // from the sines and cosines of the three angles; writes e[0..2], e[4..6] and e[8..10] of a column-major matrix.
+    // S is float or double for a single matrix or Simd::Float4 for four matrices in transposed lanes.
+    template<typename S>
+    constexpr void composeTRS(const S& sx, const S& cx, const S& sy, const S& cy, const S& sz, const S& cz,
+                              const S& scaleX, const S& scaleY, const S& scaleZ, S* e) {
+      const S sxsy = sx * sy;
+      const S cxsy = cx * sy;
+
+      e[0] = cy * cz * scaleX;
+      e[1] = (cx * sz - sxsy * cz) * scaleX;
+      e[2] = (sx * sz + cxsy * cz) * scaleX;
+
+      e[4] = -cy * sz * scaleY;
+      e[5] = (cx * cz + sxsy * sz) * scaleY;
+      e[6] = (sx * cz - cxsy * sz) * scaleY;
+
+      e[8] = -sy * scaleZ;
+      e[9] = -sx * cy * scaleZ;
+      e[10] = cx * cy * scaleZ;
     }
-    Mat4 transpose() const {
-      Mat4 result;
-      for (int row = 0; row < 4; ++row)
-        for (int col = 0; col < 4; ++col)
-          result.models[col * 4 + row] = models[row * 4 + col];
 
-      return result;
-    }
-    Mat4 inverse() const {
-      const float* m = models;
-
-      Mat4 inv;
-      inv.models[0] = m[5] * m[10] * m[15] -
+    // Cofactor expansion of a column-major 4x4 matrix, returns the determinant.
+    // S is float for a single matrix or Simd::Float4 for four matrices in transposed lanes.
+    template<typename S>
+    constexpr S inverseCofactors(const S* m, S* inv) {
+      inv[0] = m[5] * m[10] * m[15] -
         m[5] * m[11] * m[14] -
         m[9] * m[6] * m[15] +
         m[9] * m[7] * m[14] +
         m[13] * m[6] * m[11] -
         m[13] * m[7] * m[10];
 
-      inv.models[4] = -m[4] * m[10] * m[15] +
+      inv[4] = -m[4] * m[10] * m[15] +
         m[4] * m[11] * m[14] +
         m[8] * m[6] * m[15] -
         m[8] * m[7] * m[14] -
         m[12] * m[6] * m[11] +
         m[12] * m[7] * m[10];
 
-      inv.models[8] = m[4] * m[9] * m[15] -
+      inv[8] = m[4] * m[9] * m[15] -
         m[4] * m[11] * m[13] -
         m[8] * m[5] * m[15] +
         m[8] * m[7] * m[13] +
         m[12] * m[5] * m[11] -
         m[12] * m[7] * m[9];
 
-      inv.models[12] = -m[4] * m[9] * m[14] +
+      inv[12] = -m[4] * m[9] * m[14] +
         m[4] * m[10] * m[13] +
         m[8] * m[5] * m[14] -
         m[8] * m[6] * m[13] -
         m[12] * m[5] * m[10] +
         m[12] * m[6] * m[9];
 
-      inv.models[1] = -m[1] * m[10] * m[15] +
+      inv[1] = -m[1] * m[10] * m[15] +
         m[1] * m[11] * m[14] +
         m[9] * m[2] * m[15] -
         m[9] * m[3] * m[14] -
         m[13] * m[2] * m[11] +
         m[13] * m[3] * m[10];
 
-      inv.models[5] = m[0] * m[10] * m[15] -
+      inv[5] = m[0] * m[10] * m[15] -
         m[0] * m[11] * m[14] -
         m[8] * m[2] * m[15] +
         m[8] * m[3] * m[14] +
         m[12] * m[2] * m[11] -
         m[12] * m[3] * m[10];
 
-      inv.models[9] = -m[0] * m[9] * m[15] +
+      inv[9] = -m[0] * m[9] * m[15] +
         m[0] * m[11] * m[13] +
         m[8] * m[1] * m[15] -
         m[8] * m[3] * m[13] -
         m[12] * m[1] * m[11] +
         m[12] * m[3] * m[9];
 
-      inv.models[13] = m[0] * m[9] * m[14] -
+      inv[13] = m[0] * m[9] * m[14] -
         m[0] * m[10] * m[13] -
         m[8] * m[1] * m[14] +
         m[8] * m[2] * m[13] +
         m[12] * m[1] * m[10] -
         m[12] * m[2] * m[9];
 
-      inv.models[2] = m[1] * m[6] * m[15] -
+      inv[2] = m[1] * m[6] * m[15] -
         m[1] * m[7] * m[14] -
         m[5] * m[2] * m[15] +
         m[5] * m[3] * m[14] +
         m[13] * m[2] * m[7] -
         m[13] * m[3] * m[6];
 
-      inv.models[6] = -m[0] * m[6] * m[15] +
+      inv[6] = -m[0] * m[6] * m[15] +
         m[0] * m[7] * m[14] +
         m[4] * m[2] * m[15] -
         m[4] * m[3] * m[14] -
         m[12] * m[2] * m[7] +
         m[12] * m[3] * m[6];
 
-      inv.models[10] = m[0] * m[5] * m[15] -
+      inv[10] = m[0] * m[5] * m[15] -
         m[0] * m[7] * m[13] -
         m[4] * m[1] * m[15] +
         m[4] * m[3] * m[13] +
         m[12] * m[1] * m[7] -
         m[12] * m[3] * m[5];
 
-      inv.models[14] = -m[0] * m[5] * m[14] +
+      inv[14] = -m[0] * m[5] * m[14] +
         m[0] * m[6] * m[13] +
         m[4] * m[1] * m[14] -
         m[4] * m[2] * m[13] -
         m[12] * m[1] * m[6] +
         m[12] * m[2] * m[5];
 
-      inv.models[3] = -m[1] * m[6] * m[11] +
+      inv[3] = -m[1] * m[6] * m[11] +
         m[1] * m[7] * m[10] +
         m[5] * m[2] * m[11] -
         m[5] * m[3] * m[10] -
         m[9] * m[2] * m[7] +
         m[9] * m[3] * m[6];
 
-      inv.models[7] = m[0] * m[6] * m[11] -
+      inv[7] = m[0] * m[6] * m[11] -
         m[0] * m[7] * m[10] -
         m[4] * m[2] * m[11] +
         m[4] * m[3] * m[10] +
         m[8] * m[2] * m[7] -
         m[8] * m[3] * m[6];
 
-      inv.models[11] = -m[0] * m[5] * m[11] +
+      inv[11] = -m[0] * m[5] * m[11] +
         m[0] * m[7] * m[9] +
         m[4] * m[1] * m[11] -
         m[4] * m[3] * m[9] -
         m[8] * m[1] * m[7] +
         m[8] * m[3] * m[5];
 
-      inv.models[15] = m[0] * m[5] * m[10] -
+      inv[15] = m[0] * m[5] * m[10] -
         m[0] * m[6] * m[9] -
         m[4] * m[1] * m[10] +
         m[4] * m[2] * m[9] +
         m[8] * m[1] * m[6] -
         m[8] * m[2] * m[5];
 
-      float det = m[0] * inv.models[0] + m[1]
-        * inv.models[4] + m[2]
-        * inv.models[8] + m[3]
-        * inv.models[12];
+      return m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+    }
+
+#ifdef STARLET_MATH_SSE
+    // a * b - c * d
+    STARLET_MATH_TARGET_AVX2_FMA inline __m256 det2Avx2(const __m256 a, const __m256 b, const __m256 c, const __m256 d) {
+      return _mm256_fmsub_ps(a, b, _mm256_mul_ps(c, d));
+    }
+    // a * p - b * q + c * r, negated when flip has the sign bit set
+    STARLET_MATH_TARGET_AVX2_FMA inline __m256 cofactorAvx2(const __m256 a, const __m256 p, const __m256 b, const __m256 q,
+                                                            const __m256 c, const __m256 r, const __m256 flip) {
+      return _mm256_xor_ps(_mm256_fmadd_ps(c, r, det2Avx2(a, p, b, q)), flip);
+    }
+
+    // Inverts eight consecutive column-major matrices with one matrix per AVX lane, singular ones become identity.
+    // Expands by the 2x2 minors of the first two and last two columns, fewer products than inverseCofactors().
+    // Returns false if any of the eight was singular.
+    STARLET_MATH_TARGET_AVX2_FMA inline bool inverse8Avx2Fma(const float* in, float* out) {
+      // a[c * 4 + r] holds element (r, c) of all eight matrices
+      __m256 a[16];
+      for (int col = 0; col < 4; ++col) {
+        __m128 lo[4], hi[4];
+        for (int l = 0; l < 4; ++l) {
+          lo[l] = _mm_loadu_ps(in + l * 16 + col * 4);
+          hi[l] = _mm_loadu_ps(in + (l + 4) * 16 + col * 4);
+        }
+        _MM_TRANSPOSE4_PS(lo[0], lo[1], lo[2], lo[3]);
+        _MM_TRANSPOSE4_PS(hi[0], hi[1], hi[2], hi[3]);
+        for (int r = 0; r < 4; ++r) a[col * 4 + r] = _mm256_insertf128_ps(_mm256_castps128_ps256(lo[r]), hi[r], 1);
+      }
+
+      const __m256 s0 = det2Avx2(a[0], a[5], a[4], a[1]), s1 = det2Avx2(a[0], a[6], a[4], a[2]);
+      const __m256 s2 = det2Avx2(a[0], a[7], a[4], a[3]), s3 = det2Avx2(a[1], a[6], a[5], a[2]);
+      const __m256 s4 = det2Avx2(a[1], a[7], a[5], a[3]), s5 = det2Avx2(a[2], a[7], a[6], a[3]);
+      const __m256 c5 = det2Avx2(a[10], a[15], a[14], a[11]), c4 = det2Avx2(a[9], a[15], a[13], a[11]);
+      const __m256 c3 = det2Avx2(a[9], a[14], a[13], a[10]), c2 = det2Avx2(a[8], a[15], a[12], a[11]);
+      const __m256 c1 = det2Avx2(a[8], a[14], a[12], a[10]), c0 = det2Avx2(a[8], a[13], a[12], a[9]);
+
+      __m256 det = _mm256_fmadd_ps(s0, c5, _mm256_mul_ps(s2, c3));
+      det = _mm256_fmadd_ps(s3, c2, det);
+      det = _mm256_fmadd_ps(s5, c0, det);
+      det = _mm256_fnmadd_ps(s1, c4, det);
+      det = _mm256_fnmadd_ps(s4, c1, det);
+
+      const __m256 pos = _mm256_setzero_ps(), neg = _mm256_set1_ps(-0.0f);
+      __m256 inv[16];
+      inv[0] = cofactorAvx2(a[5], c5, a[6], c4, a[7], c3, pos);
+      inv[1] = cofactorAvx2(a[1], c5, a[2], c4, a[3], c3, neg);
+      inv[2] = cofactorAvx2(a[13], s5, a[14], s4, a[15], s3, pos);
+      inv[3] = cofactorAvx2(a[9], s5, a[10], s4, a[11], s3, neg);
+      inv[4] = cofactorAvx2(a[4], c5, a[6], c2, a[7], c1, neg);
+      inv[5] = cofactorAvx2(a[0], c5, a[2], c2, a[3], c1, pos);
+      inv[6] = cofactorAvx2(a[12], s5, a[14], s2, a[15], s1, neg);
+      inv[7] = cofactorAvx2(a[8], s5, a[10], s2, a[11], s1, pos);
+      inv[8] = cofactorAvx2(a[4], c4, a[5], c2, a[7], c0, pos);
+      inv[9] = cofactorAvx2(a[0], c4, a[1], c2, a[3], c0, neg);
+      inv[10] = cofactorAvx2(a[12], s4, a[13], s2, a[15], s0, pos);
+      inv[11] = cofactorAvx2(a[8], s4, a[9], s2, a[11], s0, neg);
+      inv[12] = cofactorAvx2(a[4], c3, a[5], c1, a[6], c0, neg);
+      inv[13] = cofactorAvx2(a[0], c3, a[1], c1, a[2], c0, pos);
+      inv[14] = cofactorAvx2(a[12], s3, a[13], s1, a[14], s0, neg);
+      inv[15] = cofactorAvx2(a[8], s3, a[9], s1, a[10], s0, pos);
+
+      const __m256 one = _mm256_set1_ps(1.0f);
+      const __m256 singular = _mm256_cmp_ps(det, _mm256_setzero_ps(), _CMP_EQ_OQ);
+      const __m256 invDet = _mm256_div_ps(one, _mm256_blendv_ps(det, one, singular));
+      for (int k = 0; k < 16; ++k)
+        inv[k] = _mm256_blendv_ps(_mm256_mul_ps(inv[k], invDet), k % 5 == 0 ? one : _mm256_setzero_ps(), singular);
+
+      for (int col = 0; col < 4; ++col) {
+        __m128 lo[4], hi[4];
+        for (int r = 0; r < 4; ++r) {
+          lo[r] = _mm256_castps256_ps128(inv[col * 4 + r]);
+          hi[r] = _mm256_extractf128_ps(inv[col * 4 + r], 1);
+        }
+        _MM_TRANSPOSE4_PS(lo[0], lo[1], lo[2], lo[3]);
+        _MM_TRANSPOSE4_PS(hi[0], hi[1], hi[2], hi[3]);
+        for (int l = 0; l < 4; ++l) {
+          _mm_storeu_ps(out + l * 16 + col * 4, lo[l]);
+          _mm_storeu_ps(out + (l + 4) * 16 + col * 4, hi[l]);
+        }
+      }
+      return _mm256_movemask_ps(singular) == 0;
+    }
+#endif
+  }
+
+  template<typename T>
+  struct BasicMat4 {
+    static_assert(std::is_floating_point_v<T>, "BasicMat4 needs a floating point type");
+
+    T models[16]{ T(0) };
+
+    constexpr const T* ptr() const { return models; }
+    constexpr T* ptr() { return models; }
+
+    static constexpr BasicMat4 identity() {
+      BasicMat4 result;
+      result.models[0] = T(1);
+      result.models[5] = T(1);
+      result.models[10] = T(1);
+      result.models[15] = T(1);
+      return result;
+    }
+    // Transform is float only
+    static constexpr BasicMat4 modelMatrix(const Transform& t) requires std::is_same_v<T, float> {
+      return BasicMat4::fromTRS(t);
+    }
+    static constexpr BasicMat4 fromTRS(const Transform& t) requires std::is_same_v<T, float> {
+      return BasicMat4::fromTRS(t.pos, t.rot, t.size);
+    }
+    // translation * rotateX * rotateY * rotateZ * size, written out entry by entry
+    static constexpr BasicMat4 fromTRS(const Vec4<T>& pos, const Vec3<T>& rot, const Vec3<T>& size) {
+      T sx, cx, sy, cy, sz, cz;
+      Starlet::sincos(Detail::toRadians(rot.x), sx, cx);
+      Starlet::sincos(Detail::toRadians(rot.y), sy, cy);
+      Starlet::sincos(Detail::toRadians(rot.z), sz, cz);
+
+      BasicMat4 result;
+      Detail::composeTRS(sx, cx, sy, cy, sz, cz, size.x, size.y, size.z, result.models);
+      result.models[12] = pos.x;
+      result.models[13] = pos.y;
+      result.models[14] = pos.z;
+      result.models[15] = T(1);
+      return result;
+    }
+    // Element-wise conversion, e.g. Mat4d to Mat4 once values are small enough for float
+    template<typename U>
+    constexpr BasicMat4<U> cast() const {
+      BasicMat4<U> result;
+      for (int i = 0; i < 16; ++i) result.models[i] = static_cast<U>(models[i]);
+      return result;
+    }
+    constexpr BasicMat4 transpose() const {
+      BasicMat4 result;
+      for (int row = 0; row < 4; ++row)
+        for (int col = 0; col < 4; ++col)
+          result.models[col * 4 + row] = models[row * 4 + col];
+
+      return result;
+    }
+    constexpr BasicMat4 inverse() const {
+      BasicMat4 inv;
+      inverse(inv);
+      return inv;
+    }
+    // Returns false and writes identity when the matrix is singular
+    constexpr bool inverse(BasicMat4& out) const {
+      T inv[16];
+      const T det = Detail::inverseCofactors(models, inv);
+      if (det == T(0)) {
+        out = BasicMat4::identity();
+        return false;
+      }
+
+      const T invDet = T(1) / det;
+      for (int i = 0; i < 16; ++i) out.models[i] = inv[i] * invDet;
+      return true;
+    }
 
-      if (det == 0) return Mat4::identity();
-      else          det = 1.0 / det;
+    constexpr bool isAffine(const T epsilon = T(1e-6)) const {
+      return Cx::abs(models[3]) <= epsilon
+        && Cx::abs(models[7]) <= epsilon
+        && Cx::abs(models[11]) <= epsilon
+        && Cx::abs(models[15] - T(1)) <= epsilon;
+    }
+    constexpr BasicMat4 inverseAffine() const {
+      BasicMat4 inv;
+      inverseAffine(inv);
+      return inv;
+    }
+    // Inverts the upper 3x3 and back-transforms the translation, bottom row is assumed (0, 0, 0, 1)
+    constexpr bool inverseAffine(BasicMat4& out) const {
+      const T* m = models;
+      const T c0 = m[5] * m[10] - m[6] * m[9];
+      const T c1 = m[2] * m[9] - m[1] * m[10];
+      const T c2 = m[1] * m[6] - m[2] * m[5];
+
+      const T det = m[0] * c0 + m[4] * c1 + m[8] * c2;
+      if (det == T(0)) {
+        out = BasicMat4::identity();
+        return false;
+      }
+      const T invDet = T(1) / det;
+
+      BasicMat4 inv;
+      inv.models[0] = c0 * invDet;
+      inv.models[1] = c1 * invDet;
+      inv.models[2] = c2 * invDet;
+      inv.models[4] = (m[6] * m[8] - m[4] * m[10]) * invDet;
+      inv.models[5] = (m[0] * m[10] - m[2] * m[8]) * invDet;
+      inv.models[6] = (m[2] * m[4] - m[0] * m[6]) * invDet;
+      inv.models[8] = (m[4] * m[9] - m[5] * m[8]) * invDet;
+      inv.models[9] = (m[1] * m[8] - m[0] * m[9]) * invDet;
+      inv.models[10] = (m[0] * m[5] - m[1] * m[4]) * invDet;
+
+      inv.models[12] = -(inv.models[0] * m[12] + inv.models[4] * m[13] + inv.models[8] * m[14]);
+      inv.models[13] = -(inv.models[1] * m[12] + inv.models[5] * m[13] + inv.models[9] * m[14]);
+      inv.models[14] = -(inv.models[2] * m[12] + inv.models[6] * m[13] + inv.models[10] * m[14]);
+      inv.models[15] = T(1);
+
+      out = inv;
+      return true;
+    }
+    // Inverse-transpose of the upper 3x3, for transforming normals
+    // A singular upper 3x3 has no normal matrix, this returns identity then; use the bool overload to detect it
+    constexpr BasicMat4 normalMatrix() const {
+      BasicMat4 result;
+      normalMatrix(result);
+      return result;
+    }
+    // Returns false and writes identity when the upper 3x3 is singular
+    constexpr bool normalMatrix(BasicMat4& out) const {
+      BasicMat4 inv;
+      if (!inverseAffine(inv)) {
+        out = BasicMat4::identity();
+        return false;
+      }
 
-      for (int i = 0; i < 16; ++i) inv.models[i] *= det;
+      BasicMat4 result = BasicMat4::identity();
+      for (int col = 0; col < 3; ++col)
+        for (int row = 0; row < 3; ++row)
+          result.models[col * 4 + row] = inv.models[row * 4 + col];
+      out = result;
+      return true;
+    }
+    // normalMatrix() up to a positive scale, built from the cofactors of the upper 3x3 so it stays defined when that is singular
+    // A flattening scale maps every normal onto the flattened axis, rank one or lower gives a zero matrix
+    // Entries are scaled to at most 1 in magnitude, normals transformed by it need renormalizing
+    constexpr BasicMat4 normalCofactors() const {
+      const T* m = models;
+
+      BasicMat4 result = BasicMat4::identity();
+      T* c = result.models;
+      // Columns are b x c, c x a and a x b for the basis columns a, b, c
+      c[0] = m[5] * m[10] - m[6] * m[9]; c[1] = m[6] * m[8] - m[4] * m[10]; c[2] = m[4] * m[9] - m[5] * m[8];
+      c[4] = m[9] * m[2] - m[10] * m[1]; c[5] = m[10] * m[0] - m[8] * m[2]; c[6] = m[8] * m[1] - m[9] * m[0];
+      c[8] = m[1] * m[6] - m[2] * m[5]; c[9] = m[2] * m[4] - m[0] * m[6]; c[10] = m[0] * m[5] - m[1] * m[4];
+
+      // The adjugate is det times the inverse-transpose, a mirroring transform needs its sign flipped back
+      const T scale = Detail::maxAbs(c[0], c[1], c[2], c[4], c[5], c[6], c[8], c[9], c[10]);
+      const T det = m[0] * c[0] + m[1] * c[1] + m[2] * c[2];
+      const T k = scale == T(0) ? T(0) : (det < T(0) ? T(-1) : T(1)) / scale;
+      for (const int i : { 0, 1, 2, 4, 5, 6, 8, 9, 10 }) c[i] *= k;
+      return result;
+    }
+    // Rotation + translation only (e.g. lookAt), the inverse rotation is the transpose
+    constexpr BasicMat4 inverseRigid() const {
+      const T* m = models;
+
+      BasicMat4 inv;
+      inv.models[0] = m[0]; inv.models[1] = m[4]; inv.models[2] = m[8];
+      inv.models[4] = m[1]; inv.models[5] = m[5]; inv.models[6] = m[9];
+      inv.models[8] = m[2]; inv.models[9] = m[6]; inv.models[10] = m[10];
+
+      inv.models[12] = -(m[0] * m[12] + m[1] * m[13] + m[2] * m[14]);
+      inv.models[13] = -(m[4] * m[12] + m[5] * m[13] + m[6] * m[14]);
+      inv.models[14] = -(m[8] * m[12] + m[9] * m[13] + m[10] * m[14]);
+      inv.models[15] = T(1);
       return inv;
     }
-    static Mat4 translation(const Vec4<float>& t) {
-      Mat4 result = Mat4::identity();
+    // General inverse of n matrices with one matrix per SIMD lane: eight per pass on Avx2Fma, then four per pass on Sse2.
+    // Scalar, and whatever the wider passes leave over, goes through inverse() one matrix at a time.
+    // Singular matrices are written as identity, returns false if there were any.
+    static bool inverseBatch(const BasicMat4* in, BasicMat4* out, const size_t n, const Kernels::Isa isa = Kernels::activeIsa)
+      requires std::is_same_v<T, float> {
+      static_assert(sizeof(BasicMat4) == 16 * sizeof(float), "batch kernels step through matrices as packed float[16]");
+      using Simd::Float4;
+
+      bool allInvertible = true;
+      size_t i = 0;
+#ifdef STARLET_MATH_SSE
+      if (isa == Kernels::Isa::Avx2Fma)
+        for (; i + 8 <= n; i += 8)
+          if (!Detail::inverse8Avx2Fma(in[i].models, out[i].models)) allInvertible = false;
+#endif
+      for (; isa != Kernels::Isa::Scalar && i + 4 <= n; i += 4) {
+        Float4 m[16];
+        for (int col = 0; col < 4; ++col) {
+          Float4* c = m + col * 4;
+          for (int l = 0; l < 4; ++l) c[l] = Float4::load(in[i + l].models + col * 4);
+          Simd::transpose(c[0], c[1], c[2], c[3]);
+        }
+
+        Float4 inv[16];
+        const Float4 det = Detail::inverseCofactors(m, inv);
+        const Float4 singular = det == Float4::splat(0.0f);
+        const Float4 invDet = Float4::splat(1.0f) / Simd::select(singular, Float4::splat(1.0f), det);
+        if (Simd::moveMask(singular) != 0) allInvertible = false;
+
+        for (int k = 0; k < 16; ++k)
+          inv[k] = Simd::select(singular, Float4::splat(k % 5 == 0 ? 1.0f : 0.0f), inv[k] * invDet);
+
+        for (int col = 0; col < 4; ++col) {
+          Float4* c = inv + col * 4;
+          Simd::transpose(c[0], c[1], c[2], c[3]);
+          for (int l = 0; l < 4; ++l) c[l].store(out[i + l].models + col * 4);
+        }
+      }
+      for (; i < n; ++i)
+        if (!in[i].inverse(out[i])) allInvertible = false;
+
+      return allInvertible;
+    }
+    static constexpr BasicMat4 translation(const Vec4<T>& t) {
+      BasicMat4 result = BasicMat4::identity();
       result.models[12] = t.x;
       result.models[13] = t.y;
       result.models[14] = t.z;
       return result;
     }
-    static Mat4 size(const Vec3<float>& t) {
-      Mat4 result = Mat4::identity();
+    static constexpr BasicMat4 size(const Vec3<T>& t) {
+      BasicMat4 result = BasicMat4::identity();
       result.models[0] = t.x;
       result.models[5] = t.y;
       result.models[10] = t.z;
       return result;
     }
-    static Mat4 rotateX(const float angle) {
-      const float rad = radians(angle);
-      float c = cosf(rad);
-      float s = sinf(rad);
+    static constexpr BasicMat4 rotateX(const T angle) {
+      const T rad = Detail::toRadians(angle);
+      T c = Cx::cos(rad);
+      T s = Cx::sin(rad);
 
-      Mat4 result = Mat4::identity();
+      BasicMat4 result = BasicMat4::identity();
       result.models[5] = c;
       result.models[6] = s;
       result.models[9] = -s;
       result.models[10] = c;
       return result;
     }
-    static Mat4 rotateY(const float angle) {
-      const float rad = radians(angle);
-      float c = cosf(rad);
-      float s = sinf(rad);
+    static constexpr BasicMat4 rotateY(const T angle) {
+      const T rad = Detail::toRadians(angle);
+      T c = Cx::cos(rad);
+      T s = Cx::sin(rad);
 
-      Mat4 result = Mat4::identity();
+      BasicMat4 result = BasicMat4::identity();
       result.models[0] = c;
       result.models[2] = s;
       result.models[8] = -s;
       result.models[10] = c;
       return result;
     }
-    static Mat4 rotateZ(const float angle) {
-      const float rad = radians(angle);
-      float c = cosf(rad);
-      float s = sinf(rad);
+    static constexpr BasicMat4 rotateZ(const T angle) {
+      const T rad = Detail::toRadians(angle);
+      T c = Cx::cos(rad);
+      T s = Cx::sin(rad);
 
-      Mat4 result = Mat4::identity();
+      BasicMat4 result = BasicMat4::identity();
       result.models[0] = c;
       result.models[1] = s;
       result.models[4] = -s;
       result.models[5] = c;
       return result;
     }
-    static Mat4 lookAt(const Vec3<float>& pos, const Vec3<float>& front, const Vec3<float>& up = WORLD_UP) {
+    static constexpr BasicMat4 lookAt(const Vec3<T>& pos, const Vec3<T>& front, const Vec3<T>& up = Vec3<T>(T(0), T(1), T(0))) {
       const Vec3 forward = front.normalized();
       Vec3 right = forward.cross(up);
-      if (right.length() < 0.00001f) right = { 1.0f, 0.0f, 0.0f };
+      if (right.length() < T(0.00001)) right = { T(1), T(0), T(0) };
       else                          right = right.normalized();
       const Vec3 camUp = right.cross(forward);
 
-      Mat4 view{};
+      BasicMat4 view{};
       view.models[0] = right.x;
       view.models[1] = camUp.x;
       view.models[2] = -forward.x;
-      view.models[3] = 0.0f;
+      view.models[3] = T(0);
 
       view.models[4] = right.y;
       view.models[5] = camUp.y;
       view.models[6] = -forward.y;
-      view.models[7] = 0.0f;
+      view.models[7] = T(0);
 
       view.models[8] = right.z;
       view.models[9] = camUp.z;
       view.models[10] = -forward.z;
-      view.models[11] = 0.0f;
+      view.models[11] = T(0);
 
       view.models[12] = -right.dot(pos);
       view.models[13] = -camUp.dot(pos);
       view.models[14] = forward.dot(pos);
-      view.models[15] = 1.0f;
+      view.models[15] = T(1);
       return view;
     }
-    static Mat4 perspective(const float degFov, const float aspect, const float nearPlane, const float farPlane) {
-      const float tanHalfFov = tanf(radians(degFov) / 2.0f);
+    static constexpr BasicMat4 perspective(const T degFov, const T aspect, const T nearPlane, const T farPlane) {
+      const T tanHalfFov = Cx::tan(Detail::toRadians(degFov) / T(2));
 
-      Mat4 projection{};
-      projection.models[0] = 1.0f / (aspect * tanHalfFov);
-      projection.models[5] = 1.0f / tanHalfFov;
+      BasicMat4 projection{};
+      projection.models[0] = T(1) / (aspect * tanHalfFov);
+      projection.models[5] = T(1) / tanHalfFov;
       projection.models[10] = -(farPlane + nearPlane) / (farPlane - nearPlane);
-      projection.models[11] = -1.0f;
-      projection.models[14] = -(2.0f * farPlane * nearPlane) / (farPlane - nearPlane);
-      projection.models[15] = 0.0f;
+      projection.models[11] = -T(1);
+      projection.models[14] = -(T(2) * farPlane * nearPlane) / (farPlane - nearPlane);
+      projection.models[15] = T(0);
       return projection;
     }
 
-    Mat4 operator*(const Mat4& b) const {
-      Mat4 result{};
-
-      // Column 0
-      result.models[0] = models[0] * b.models[0] + models[4] * b.models[1] + models[8] * b.models[2] + models[12] * b.models[3];
-      result.models[1] = models[1] * b.models[0] + models[5] * b.models[1] + models[9] * b.models[2] + models[13] * b.models[3];
-      result.models[2] = models[2] * b.models[0] + models[6] * b.models[1] + models[10] * b.models[2] + models[14] * b.models[3];
-      result.models[3] = models[3] * b.models[0] + models[7] * b.models[1] + models[11] * b.models[2] + models[15] * b.models[3];
-
-      // Column 1
-      result.models[4] = models[0] * b.models[4] + models[4] * b.models[5] + models[8] * b.models[6] + models[12] * b.models[7];
-      result.models[5] = models[1] * b.models[4] + models[5] * b.models[5] + models[9] * b.models[6] + models[13] * b.models[7];
-      result.models[6] = models[2] * b.models[4] + models[6] * b.models[5] + models[10] * b.models[6] + models[14] * b.models[7];
-      result.models[7] = models[3] * b.models[4] + models[7] * b.models[5] + models[11] * b.models[6] + models[15] * b.models[7];
-
-      //// Column 2
-      result.models[8] = models[0] * b.models[8] + models[4] * b.models[9] + models[8] * b.models[10] + models[12] * b.models[11];
-      result.models[9] = models[1] * b.models[8] + models[5] * b.models[9] + models[9] * b.models[10] + models[13] * b.models[11];
-      result.models[10] = models[2] * b.models[8] + models[6] * b.models[9] + models[10] * b.models[10] + models[14] * b.models[11];
-      result.models[11] = models[3] * b.models[8] + models[7] * b.models[9] + models[11] * b.models[10] + models[15] * b.models[11];
-
-      //// Column 3
-      result.models[12] = models[0] * b.models[12] + models[4] * b.models[13] + models[8] * b.models[14] + models[12] * b.models[15];
-      result.models[13] = models[1] * b.models[12] + models[5] * b.models[13] + models[9] * b.models[14] + models[13] * b.models[15];
-      result.models[14] = models[2] * b.models[12] + models[6] * b.models[13] + models[10] * b.models[14] + models[14] * b.models[15];
-      result.models[15] = models[3] * b.models[12] + models[7] * b.models[13] + models[11] * b.models[14] + models[15] * b.models[15];
-
+    constexpr BasicMat4 operator*(const BasicMat4& b) const {
+      BasicMat4 result;
+      if constexpr (std::is_same_v<T, float>) {
+        if (!std::is_constant_evaluated()) {
+          Kernels::mul(models, b.models, result.models);
+          return result;
+        }
+      }
+      Kernels::mulScalar(models, b.models, result.models);
       return result;
     }
-    Vec4<float> operator*(const Vec4<float>& v) const {
-      Vec4<float> result;
-      result.x = models[0] * v.x + models[4] * v.y + models[8] * v.z + models[12] * v.w;
-      result.y = models[1] * v.x + models[5] * v.y + models[9] * v.z + models[13] * v.w;
-      result.z = models[2] * v.x + models[6] * v.y + models[10] * v.z + models[14] * v.w;
-      result.w = models[3] * v.x + models[7] * v.y + models[11] * v.z + models[15] * v.w;
-      return result;
+    constexpr Vec4<T> operator*(const Vec4<T>& v) const {
+      if constexpr (std::is_same_v<T, float>) {
+        // x, y, z, w are not an array as far as constant evaluation is concerned
+        if (!std::is_constant_evaluated()) {
+          Vec4<T> result;
+          Kernels::mulVec(models, &v.x, &result.x);
+          return result;
+        }
+      }
+      const T* m = models;
+      return {
+        m[0] * v.x + m[4] * v.y + m[8] * v.z + m[12] * v.w,
+        m[1] * v.x + m[5] * v.y + m[9] * v.z + m[13] * v.w,
+        m[2] * v.x + m[6] * v.y + m[10] * v.z + m[14] * v.w,
+        m[3] * v.x + m[7] * v.y + m[11] * v.z + m[15] * v.w
+      };
+    }
+
+    // Columns load straight from models into a register
+    Vec4f column(const int c) const requires std::is_same_v<T, float> { return Vec4f::load(models + c * 4); }
+    void setColumn(const int c, const Vec4f& col) requires std::is_same_v<T, float> { col.store(models + c * 4); }
+    Vec4f operator*(const Vec4f& v) const requires std::is_same_v<T, float> {
+      Vec4f result = column(0) * v.broadcast<0>();
+      result = madd(column(1), v.broadcast<1>(), result);
+      result = madd(column(2), v.broadcast<2>(), result);
+      return madd(column(3), v.broadcast<3>(), result);
     }
 
-    Mat4& operator*=(const Mat4& b) {
+    constexpr BasicMat4& operator*=(const BasicMat4& b) {
       *this = (*this) * b;
       return *this;
     }
-    bool operator==(const Mat4& b) const {
+    constexpr bool operator==(const BasicMat4& b) const {
       for (int i = 0; i < 16; ++i)
         if (models[i] != b.models[i])
           return false;
@@ -305,7 +603,7 @@ namespace Starlet::Math {
       return true;
     }
 
-    Transform decompose() const {
+    constexpr Transform decompose() const requires std::is_same_v<T, float> {
       Transform t;
 
       t.pos.x = models[12];
@@ -325,14 +623,14 @@ namespace Starlet::Math {
       if (t.size.y != 0) col1 = col1 / t.size.y;
       if (t.size.z != 0) col2 = col2 / t.size.z;
 
-      t.rot.y = asinf(-col0.z);  // Y-axis
-      if (cosf(t.rot.y) != 0.0f) {
-        t.rot.x = atan2f(col1.z, col2.z); // X-axis
-        t.rot.z = atan2f(col0.y, col0.x); // Z-axis
+      t.rot.y = Cx::asin(-col0.z);  // Y-axis
+      if (Cx::cos(t.rot.y) != T(0)) {
+        t.rot.x = Cx::atan2(col1.z, col2.z); // X-axis
+        t.rot.z = Cx::atan2(col0.y, col0.x); // Z-axis
       }
       else {
-        t.rot.x = atan2f(-col2.x, col1.y); // Gimbal lock case
-        t.rot.z = 0.0f;
+        t.rot.x = Cx::atan2(-col2.x, col1.y); // Gimbal lock case
+        t.rot.z = T(0);
       }
 
       t.rot.x = degrees(t.rot.x);
@@ -342,4 +640,7 @@ namespace Starlet::Math {
       return t;
     }
   };
+
+  using Mat4 = BasicMat4<float>;
+  using Mat4d = BasicMat4<double>;
 }
\ No newline at end of file
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "simd.hpp"
+
+#if defined(STARLET_MATH_SSE) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// GCC and Clang need the target attribute to emit AVX2/FMA code in a baseline build
+#if defined(STARLET_MATH_SSE) && (defined(__GNUC__) || defined(__clang__))
+#define STARLET_MATH_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+#else
+#define STARLET_MATH_TARGET_AVX2_FMA
+#endif
+
+namespace Starlet::Math::Kernels {
+  /*
+  Mat4 Kernels
+  * Column-major 4x4 matrix-matrix and matrix-vector products
+  * The instruction set is picked once at startup from CPUID
+  * Outputs must not alias the inputs
+  * STARLET_MATH_NO_SIMD forces Scalar, STARLET_MATH_NO_DISPATCH skips CPUID and uses the build baseline
+  */
+  enum class Isa { Scalar, Sse2, Avx2Fma };
+
+  template<typename T>
+  constexpr void mulScalar(const T* a, const T* b, T* out) {
+    for (int col = 0; col < 4; ++col)
+      for (int row = 0; row < 4; ++row)
+        out[col * 4 + row] = a[row] * b[col * 4] + a[4 + row] * b[col * 4 + 1] + a[8 + row] * b[col * 4 + 2] + a[12 + row] * b[col * 4 + 3];
+  }
+  template<typename T>
+  constexpr void mulVecScalar(const T* m, const T* v, T* out) {
+    for (int row = 0; row < 4; ++row)
+      out[row] = m[row] * v[0] + m[4 + row] * v[1] + m[8 + row] * v[2] + m[12 + row] * v[3];
+  }
+
+#ifdef STARLET_MATH_SSE
+  inline void mulSse2(const float* a, const float* b, float* out) {
+    const __m128 a0 = _mm_loadu_ps(a), a1 = _mm_loadu_ps(a + 4), a2 = _mm_loadu_ps(a + 8), a3 = _mm_loadu_ps(a + 12);
+    for (int col = 0; col < 4; ++col) {
+      const float* bc = b + col * 4;
+      __m128 r = _mm_mul_ps(a0, _mm_set1_ps(bc[0]));
+      r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(bc[1])));
+      r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(bc[2])));
+      r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(bc[3])));
+      _mm_storeu_ps(out + col * 4, r);
+    }
+  }
+  inline void mulVecSse2(const float* m, const float* v, float* out) {
+    __m128 r = _mm_mul_ps(_mm_loadu_ps(m), _mm_set1_ps(v[0]));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 4), _mm_set1_ps(v[1])));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 8), _mm_set1_ps(v[2])));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 12), _mm_set1_ps(v[3])));
+    _mm_storeu_ps(out, r);
+  }
+
+  // Two output columns per 256-bit register, each half broadcasting from its own column of b
+  STARLET_MATH_TARGET_AVX2_FMA inline void mulAvx2Fma(const float* a, const float* b, float* out) {
+    const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a));
+    const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+    const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+    const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+    for (int col = 0; col < 4; col += 2) {
+      const __m256 bc = _mm256_loadu_ps(b + col * 4);
+      __m256 r = _mm256_mul_ps(a0, _mm256_permute_ps(bc, 0x00));
+      r = _mm256_fmadd_ps(a1, _mm256_permute_ps(bc, 0x55), r);
+      r = _mm256_fmadd_ps(a2, _mm256_permute_ps(bc, 0xAA), r);
+      r = _mm256_fmadd_ps(a3, _mm256_permute_ps(bc, 0xFF), r);
+      _mm256_storeu_ps(out + col * 4, r);
+    }
+  }
+  STARLET_MATH_TARGET_AVX2_FMA inline void mulVecAvx2Fma(const float* m, const float* v, float* out) {
+    __m128 r = _mm_mul_ps(_mm_loadu_ps(m), _mm_set1_ps(v[0]));
+    r = _mm_fmadd_ps(_mm_loadu_ps(m + 4), _mm_set1_ps(v[1]), r);
+    r = _mm_fmadd_ps(_mm_loadu_ps(m + 8), _mm_set1_ps(v[2]), r);
+    r = _mm_fmadd_ps(_mm_loadu_ps(m + 12), _mm_set1_ps(v[3]), r);
+    _mm_storeu_ps(out, r);
+  }
+#endif
+
+  inline bool isaSupported(const Isa isa) {
+    switch (isa) {
+    case Isa::Scalar: return true;
+#ifdef STARLET_MATH_SSE
+    case Isa::Sse2: return true;
+    case Isa::Avx2Fma:
+#if defined(STARLET_MATH_NO_DISPATCH)
+  #if defined(__AVX2__) && defined(__FMA__)
+      return true;
+  #else
+      return false;
+  #endif
+#elif defined(_MSC_VER)
+    {
+      int info[4];
+      __cpuid(info, 1);
+      const bool fma = (info[2] & (1 << 12)) != 0;
+      const bool osxsave = (info[2] & (1 << 27)) != 0;
+      if (!fma || !osxsave || (_xgetbv(0) & 0x6) != 0x6) return false;
+      __cpuidex(info, 7, 0);
+      return (info[1] & (1 << 5)) != 0;
+    }
+#else
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+#endif
+    default: return false;
+    }
+  }
+  inline Isa detectIsa() {
+    if (isaSupported(Isa::Avx2Fma)) return Isa::Avx2Fma;
+    if (isaSupported(Isa::Sse2)) return Isa::Sse2;
+    return Isa::Scalar;
+  }
+
+  inline const Isa activeIsa = detectIsa();
+
+  inline void mul(const float* a, const float* b, float* out, const Isa isa = activeIsa) {
+    switch (isa) {
+#ifdef STARLET_MATH_SSE
+    case Isa::Avx2Fma: mulAvx2Fma(a, b, out); return;
+    case Isa::Sse2: mulSse2(a, b, out); return;
+#endif
+    default: mulScalar(a, b, out); return;
+    }
+  }
+  inline void mulVec(const float* m, const float* v, float* out, const Isa isa = activeIsa) {
+    switch (isa) {
+#ifdef STARLET_MATH_SSE
+    case Isa::Avx2Fma: mulVecAvx2Fma(m, v, out); return;
+    case Isa::Sse2: mulVecSse2(m, v, out); return;
+#endif
+    default: mulVecScalar(m, v, out); return;
+    }
+  }
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "fast_math.hpp"
+#include "parallel.hpp"
+#include "vec2.hpp"
+#include "vec3.hpp"
+#include "vec4.hpp"
+#include "vertex.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace Starlet::Math {
+  /*
+  VertexAdjacency
+  * Compressed vertex -> triangle corner lists, corner c is indices[c] of triangle c / 3
+  * Lets per-vertex passes gather from their own triangles instead of scattering into shared sums
+  * Each list is sorted, so results do not depend on thread timing
+  */
+  struct VertexAdjacency {
+    std::vector<std::uint32_t> offsets;  // vertexCount + 1 entries, corners of v are [offsets[v], offsets[v + 1])
+    std::vector<std::uint32_t> corners;
+
+    size_t vertexCount() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    std::span<const std::uint32_t> cornersOf(const size_t v) const {
+      return { corners.data() + offsets[v], corners.data() + offsets[v + 1] };
+    }
+
+    // A trailing partial triangle in indices is ignored
+    static VertexAdjacency build(const size_t vertexCount, std::span<const std::uint32_t> indices, const unsigned threads = 0) {
+      const size_t cornerCount = indices.size() / 3 * 3;
+      assert(cornerCount <= std::numeric_limits<std::uint32_t>::max());
+
+      // Counters are shared between threads, a single thread skips the locked adds
+      const bool concurrent = (threads == 0 ? defaultThreadCount() : threads) > 1 && cornerCount > Grain;
+      const auto bump = [concurrent](std::uint32_t& counter) {
+        return concurrent ? std::atomic_ref<std::uint32_t>(counter).fetch_add(1, std::memory_order_relaxed) : counter++;
+      };
+
+      VertexAdjacency adj;
+      std::vector<std::uint32_t> cursor(vertexCount, 0);
+      parallelFor(cornerCount, Grain, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+          assert(indices[c] < vertexCount);
+          bump(cursor[indices[c]]);
+        }
+      }, threads);
+
+      adj.offsets.resize(vertexCount + 1);
+      adj.offsets[0] = 0;
+      for (size_t v = 0; v < vertexCount; ++v) {
+        adj.offsets[v + 1] = adj.offsets[v] + cursor[v];
+        cursor[v] = adj.offsets[v];
+      }
+
+      adj.corners.resize(cornerCount);
+      parallelFor(cornerCount, Grain, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) adj.corners[bump(cursor[indices[c]])] = static_cast<std::uint32_t>(c);
+      }, threads);
+
+      parallelFor(vertexCount, 4096, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v)
+          std::sort(adj.corners.begin() + adj.offsets[v], adj.corners.begin() + adj.offsets[v + 1]);
+      }, threads);
+      return adj;
+    }
+
+  private:
+    static constexpr size_t Grain = 16384;
+  };
+
+  enum class NormalWeighting {
+    Area,   // larger triangles pull harder, cheapest
+    Angle,  // weighted by the corner angle, independent of how the surface is tessellated
+  };
+
+  namespace Detail {
+    // The corner's vertex followed by the other two in winding order
+    inline void cornerVertices(std::span<const std::uint32_t> indices, const std::uint32_t c, std::uint32_t& a, std::uint32_t& b, std::uint32_t& d) {
+      const std::uint32_t base = c - c % 3;
+      a = indices[c];
+      b = indices[base + (c + 1) % 3];
+      d = indices[base + (c + 2) % 3];
+    }
+
+    // Unit vector, or zero when v has no length at all (no Vec3::normalized cutoff, tiny meshes stay valid)
+    inline Vec3<float> unitOrZero(const Vec3<float>& v) {
+      const float lenSq = v.dot(v);
+      return lenSq > 0.0f ? v * (1.0f / std::sqrt(lenSq)) : Vec3<float>(0.0f);
+    }
+
+    // Some unit vector perpendicular to n
+    inline Vec3<float> anyPerpendicular(const Vec3<float>& n) {
+      const Vec3<float> axis = std::abs(n.x) < 0.9f ? Vec3<float>(1.0f, 0.0f, 0.0f) : Vec3<float>(0.0f, 1.0f, 0.0f);
+      return unitOrZero(axis - n * n.dot(axis));
+    }
+  }
+
+  /*
+  Smooth normals for an indexed triangle list, written to vertices[i].norm
+  * Counter-clockwise triangles face the viewer
+  * Smoothing follows the index buffer, vertices split at seams keep separate normals
+  * Vertices used by no (non-degenerate) triangle get a zero normal
+  */
+  inline void computeNormals(std::span<Vertex> vertices, std::span<const std::uint32_t> indices, const VertexAdjacency& adjacency,
+                             const NormalWeighting weighting = NormalWeighting::Angle, const unsigned threads = 0) {
+    assert(adjacency.vertexCount() == vertices.size());
+
+    parallelFor(vertices.size(), 2048, [&](size_t begin, size_t end) {
+      for (size_t v = begin; v < end; ++v) {
+        Vec3<float> sum(0.0f);
+        for (const std::uint32_t c : adjacency.cornersOf(v)) {
+          std::uint32_t a, b, d;
+          Detail::cornerVertices(indices, c, a, b, d);
+          const Vec3<float> e1 = vertices[b].pos - vertices[a].pos;
+          const Vec3<float> e2 = vertices[d].pos - vertices[a].pos;
+          const Vec3<float> n = e1.cross(e2);
+
+          if (weighting == NormalWeighting::Area) sum += n;
+          else {
+            // atan2 of |e1 x e2| and e1 . e2 stays accurate near 0 and pi where acos does not
+            const float len = std::sqrt(n.dot(n));
+            if (len > 0.0f) sum += n * (Fast::atan2(len, e1.dot(e2)) / len);
+          }
+        }
+        vertices[v].norm = Detail::unitOrZero(sum);
+      }
+    }, threads);
+  }
+  inline void computeNormals(std::span<Vertex> vertices, std::span<const std::uint32_t> indices,
+                             const NormalWeighting weighting = NormalWeighting::Angle, const unsigned threads = 0) {
+    computeNormals(vertices, indices, VertexAdjacency::build(vertices.size(), indices, threads), weighting, threads);
+  }
+
+  /*
+  Per-vertex tangents following the MikkTSpace conventions
+  * xyz is the unit tangent along +u, orthogonal to vertices[i].norm, w is the bitangent sign: bitangent = w * cross(norm, tangent)
+  * Face tangents are projected onto each vertex's tangent plane and angle weighted, triangles with degenerate UVs are skipped
+  * Normals must already be set, e.g. by computeNormals
+  * Unlike the reference implementation no vertices are split, so a vertex shared by mirrored UV islands gets one averaged frame
+  */
+  inline void computeTangents(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices, const VertexAdjacency& adjacency,
+                              std::span<Vec4<float>> tangents, const unsigned threads = 0) {
+    assert(adjacency.vertexCount() == vertices.size());
+    assert(tangents.size() == vertices.size());
+
+    parallelFor(vertices.size(), 2048, [&](size_t begin, size_t end) {
+      for (size_t v = begin; v < end; ++v) {
+        const Vec3<float> n = vertices[v].norm;
+        Vec3<float> tSum(0.0f), bSum(0.0f);
+
+        for (const std::uint32_t c : adjacency.cornersOf(v)) {
+          std::uint32_t a, b, d;
+          Detail::cornerVertices(indices, c, a, b, d);
+          const Vec3<float> e1 = vertices[b].pos - vertices[a].pos;
+          const Vec3<float> e2 = vertices[d].pos - vertices[a].pos;
+          const Vec2<float> uv1 = vertices[b].texCoord - vertices[a].texCoord;
+          const Vec2<float> uv2 = vertices[d].texCoord - vertices[a].texCoord;
+
+          const float uvArea = uv1.x * uv2.y - uv2.x * uv1.y;
+          if (uvArea == 0.0f) continue;
+          // Only the direction matters, the sign of the UV area stands in for dividing by it
+          const float orientation = uvArea > 0.0f ? 1.0f : -1.0f;
+          const Vec3<float> t = (e1 * uv2.y - e2 * uv1.y) * orientation;
+          const Vec3<float> bt = (e2 * uv1.x - e1 * uv2.x) * orientation;
+
+          const Vec3<float> crossed = e1.cross(e2);
+          const float angle = Fast::atan2(std::sqrt(crossed.dot(crossed)), e1.dot(e2));
+          tSum += Detail::unitOrZero(t - n * n.dot(t)) * angle;
+          bSum += Detail::unitOrZero(bt - n * n.dot(bt)) * angle;
+        }
+
+        Vec3<float> t = Detail::unitOrZero(tSum - n * n.dot(tSum));
+        if (t.dot(t) == 0.0f) t = Detail::anyPerpendicular(n);
+        const float w = n.cross(t).dot(bSum) < 0.0f ? -1.0f : 1.0f;
+        tangents[v] = { t.x, t.y, t.z, w };
+      }
+    }, threads);
+  }
+  inline void computeTangents(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices, std::span<Vec4<float>> tangents, const unsigned threads = 0) {
+    computeTangents(vertices, indices, VertexAdjacency::build(vertices.size(), indices, threads), tangents, threads);
+  }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace Starlet::Math {
+  inline unsigned defaultThreadCount() {
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : hw;
+  }
+
+  /*
+  parallelFor
+  * Splits [0, count) into one contiguous range per thread and calls fn(begin, end) on each
+  * Range boundaries are multiples of grain, the calling thread takes the last range
+  * threads == 0 uses every hardware thread
+  */
+  template<typename Fn>
+  void parallelFor(const size_t count, const size_t grain, Fn&& fn, unsigned threads = 0) {
+    if (count == 0) return;
+    if (threads == 0) threads = defaultThreadCount();
+
+    const size_t blocks = (count + grain - 1) / grain;
+    const size_t workers = std::min<size_t>(threads, blocks);
+    if (workers <= 1) {
+      fn(size_t(0), count);
+      return;
+    }
+
+    const size_t blocksPerWorker = (blocks + workers - 1) / workers;
+    const size_t chunk = blocksPerWorker * grain;
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+
+    size_t begin = 0;
+    for (; begin + chunk < count; begin += chunk)
+      pool.emplace_back([&fn, begin, chunk] { fn(begin, begin + chunk); });
+    fn(begin, count);
+
+    for (std::thread& t : pool) t.join();
+  }
+}
@@ -0,0 +1,421 @@
+#pragma once
+
+#include "fast_math.hpp"
+#include "mat4.hpp"
+#include "simd.hpp"
+#include "transform.hpp"
+#include "vec3.hpp"
+#include "vec4.hpp"
+#include "constants.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <type_traits>
+
+namespace Starlet::Math {
+  /*
+  Quat
+  * Rotation quaternion, x, y, z vector part and w scalar part
+  * Default constructed quaternions are the identity rotation
+  */
+  template<typename T>
+  struct Quat {
+    static_assert(std::is_floating_point_v<T>, "Quat needs a floating point type");
+
+    T x, y, z, w;
+
+    constexpr Quat() : x(T(0)), y(T(0)), z(T(0)), w(T(1)) {}
+    constexpr Quat(T xIn, T yIn, T zIn, T wIn) : x(xIn), y(yIn), z(zIn), w(wIn) {}
+    constexpr Quat(const Quat& other) = default;
+
+    Quat& operator=(const Quat& other) = default;
+
+    static Quat identity() { return Quat(); }
+    static Quat fromAxisAngle(const Vec3<T>& axis, const T degAngle) {
+      const Vec3<T> n = axis.normalized();
+      const T half = Detail::toRadians(degAngle) / T(2);
+      const T s = std::sin(half);
+      return { n.x * s, n.y * s, n.z * s, std::cos(half) };
+    }
+    // Same rotation as Mat4::rotateX(x) * Mat4::rotateY(y) * Mat4::rotateZ(z), angles in degrees
+    static Quat fromEuler(const Vec3<T>& deg) {
+      const T hx = Detail::toRadians(deg.x) / T(2);
+      // Mat4::rotateY turns the opposite way to a right-handed rotation about +y
+      const T hy = -Detail::toRadians(deg.y) / T(2);
+      const T hz = Detail::toRadians(deg.z) / T(2);
+
+      const Quat qx{ std::sin(hx), T(0), T(0), std::cos(hx) };
+      const Quat qy{ T(0), std::sin(hy), T(0), std::cos(hy) };
+      const Quat qz{ T(0), T(0), std::sin(hz), std::cos(hz) };
+      return qx * qy * qz;
+    }
+    // Rotation part of m, columns are normalized first so scale is ignored
+    static Quat fromMat4(const Mat4& m) {
+      Vec3<T> c0{ m.models[0], m.models[1], m.models[2] };
+      Vec3<T> c1{ m.models[4], m.models[5], m.models[6] };
+      Vec3<T> c2{ m.models[8], m.models[9], m.models[10] };
+      c0 = c0.normalized(); c1 = c1.normalized(); c2 = c2.normalized();
+
+      // r[row][col]
+      const T r00 = c0.x, r10 = c0.y, r20 = c0.z;
+      const T r01 = c1.x, r11 = c1.y, r21 = c1.z;
+      const T r02 = c2.x, r12 = c2.y, r22 = c2.z;
+
+      Quat q;
+      const T trace = r00 + r11 + r22;
+      if (trace > T(0)) {
+        const T s = std::sqrt(trace + T(1)) * T(2);
+        q = { (r21 - r12) / s, (r02 - r20) / s, (r10 - r01) / s, s / T(4) };
+      }
+      else if (r00 > r11 && r00 > r22) {
+        const T s = std::sqrt(T(1) + r00 - r11 - r22) * T(2);
+        q = { s / T(4), (r01 + r10) / s, (r02 + r20) / s, (r21 - r12) / s };
+      }
+      else if (r11 > r22) {
+        const T s = std::sqrt(T(1) + r11 - r00 - r22) * T(2);
+        q = { (r01 + r10) / s, s / T(4), (r12 + r21) / s, (r02 - r20) / s };
+      }
+      else {
+        const T s = std::sqrt(T(1) + r22 - r00 - r11) * T(2);
+        q = { (r02 + r20) / s, (r12 + r21) / s, s / T(4), (r10 - r01) / s };
+      }
+      return q.normalized();
+    }
+
+    Mat4 toMat4() const {
+      const T xx = x * x, yy = y * y, zz = z * z;
+      const T xy = x * y, xz = x * z, yz = y * z;
+      const T wx = w * x, wy = w * y, wz = w * z;
+
+      Mat4 result = Mat4::identity();
+      result.models[0] = static_cast<float>(T(1) - T(2) * (yy + zz));
+      result.models[1] = static_cast<float>(T(2) * (xy + wz));
+      result.models[2] = static_cast<float>(T(2) * (xz - wy));
+
+      result.models[4] = static_cast<float>(T(2) * (xy - wz));
+      result.models[5] = static_cast<float>(T(1) - T(2) * (xx + zz));
+      result.models[6] = static_cast<float>(T(2) * (yz + wx));
+
+      result.models[8] = static_cast<float>(T(2) * (xz + wy));
+      result.models[9] = static_cast<float>(T(2) * (yz - wx));
+      result.models[10] = static_cast<float>(T(1) - T(2) * (xx + yy));
+      return result;
+    }
+    // Inverse of fromEuler for a unit quaternion, y comes back in [-90, 90] degrees
+    // At y = +-90 only x + z is defined, z is reported as 0
+    Vec3<T> toEuler() const {
+      const T m0 = T(1) - T(2) * (y * y + z * z), m1 = T(2) * (x * y + w * z);
+      const T m4 = T(2) * (x * y - w * z), m5 = T(1) - T(2) * (x * x + z * z);
+      const T m8 = T(2) * (x * z + w * y), m9 = T(2) * (y * z - w * x), m10 = T(1) - T(2) * (x * x + y * y);
+
+      const T cosY = std::sqrt(m0 * m0 + m4 * m4);
+      Vec3<T> rad{ T(0), std::atan2(-m8, cosY), T(0) };
+      if (cosY > T(1e-6)) {
+        rad.x = std::atan2(-m9, m10);
+        rad.z = std::atan2(-m4, m0);
+      }
+      else rad.x = std::atan2(m1 * m8, m5);
+
+      const T toDegrees = static_cast<T>(RAD_TO_DEG);
+      return rad * toDegrees;
+    }
+
+    T lengthSquared() const { return x * x + y * y + z * z + w * w; }
+    T length() const { return std::sqrt(lengthSquared()); }
+    T dot(const Quat& rhs) const { return x * rhs.x + y * rhs.y + z * rhs.z + w * rhs.w; }
+
+    Quat normalized() const {
+      const T len = length();
+      return (len < T(1e-6)) ? Quat() : Quat(x / len, y / len, z / len, w / len);
+    }
+    Quat conjugate() const { return { -x, -y, -z, w }; }
+    Quat inverse() const {
+      const T lenSq = lengthSquared();
+      return (lenSq < T(1e-12)) ? Quat() : Quat(-x / lenSq, -y / lenSq, -z / lenSq, w / lenSq);
+    }
+
+    // Hamilton product, (a * b) applies b first then a
+    Quat operator*(const Quat& rhs) const {
+      return {
+        w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
+        w * rhs.y - x * rhs.z + y * rhs.w + z * rhs.x,
+        w * rhs.z + x * rhs.y - y * rhs.x + z * rhs.w,
+        w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z
+      };
+    }
+    Quat& operator*=(const Quat& rhs) { *this = *this * rhs; return *this; }
+
+    // Rotates v, assumes a unit quaternion
+    Vec3<T> operator*(const Vec3<T>& v) const {
+      const Vec3<T> u{ x, y, z };
+      const Vec3<T> t = u.cross(v) * T(2);
+      return v + t * w + u.cross(t);
+    }
+
+    bool operator==(const Quat& rhs) const { return x == rhs.x && y == rhs.y && z == rhs.z && w == rhs.w; }
+    bool operator!=(const Quat& rhs) const { return !(*this == rhs); }
+
+    // Normalized linear interpolation along the shorter arc
+    static Quat nlerp(const Quat& a, const Quat& b, const T t) {
+      const T sign = a.dot(b) < T(0) ? T(-1) : T(1);
+      return Quat(
+        a.x + (b.x * sign - a.x) * t,
+        a.y + (b.y * sign - a.y) * t,
+        a.z + (b.z * sign - a.z) * t,
+        a.w + (b.w * sign - a.w) * t
+      ).normalized();
+    }
+    // Constant angular velocity interpolation along the shorter arc
+    static Quat slerp(const Quat& a, const Quat& b, const T t) {
+      T cosTheta = a.dot(b);
+      Quat end = b;
+      if (cosTheta < T(0)) {
+        cosTheta = -cosTheta;
+        end = { -b.x, -b.y, -b.z, -b.w };
+      }
+      // Nearly parallel, sin(theta) is too small to divide by
+      if (cosTheta > T(0.9995)) return nlerp(a, end, t);
+
+      const T theta = std::acos(cosTheta);
+      const T sinTheta = std::sin(theta);
+      const T wa = std::sin((T(1) - t) * theta) / sinTheta;
+      const T wb = std::sin(t * theta) / sinTheta;
+      return { a.x * wa + end.x * wb, a.y * wa + end.y * wb, a.z * wa + end.z * wb, a.w * wa + end.w * wb };
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Quat& q) { return os << q.x << ' ' << q.y << ' ' << q.z << ' ' << q.w; }
+  };
+
+  /*
+  QuatTransform
+  * Transform with a quaternion rotation, model matrices need no trig
+  */
+  struct QuatTransform {
+    Vec4<float> pos{ 0.0f };
+    Quat<float> rot{};
+    Vec3<float> size{ 1.0f };
+
+    static QuatTransform fromTransform(const Transform& t) {
+      return { t.pos, Quat<float>::fromEuler(t.rot), t.size };
+    }
+
+    // translation * rotation * size
+    Mat4 modelMatrix() const {
+      Mat4 result = rot.toMat4();
+      for (int row = 0; row < 3; ++row) {
+        result.models[row] *= size.x;
+        result.models[4 + row] *= size.y;
+        result.models[8 + row] *= size.z;
+      }
+      result.models[12] = pos.x;
+      result.models[13] = pos.y;
+      result.models[14] = pos.z;
+      return result;
+    }
+  };
+
+  namespace Detail {
+    inline void loadQuats4(const Quat<float>* q, Simd::Float4& x, Simd::Float4& y, Simd::Float4& z, Simd::Float4& w) {
+      x = Simd::Float4::load(&q[0].x); y = Simd::Float4::load(&q[1].x);
+      z = Simd::Float4::load(&q[2].x); w = Simd::Float4::load(&q[3].x);
+      Simd::transpose(x, y, z, w);
+    }
+    inline void storeQuats4(Quat<float>* q, Simd::Float4 x, Simd::Float4 y, Simd::Float4 z, Simd::Float4 w) {
+      Simd::transpose(x, y, z, w);
+      x.store(&q[0].x); y.store(&q[1].x); z.store(&q[2].x); w.store(&q[3].x);
+    }
+    // Quat::normalized on four lanes, near-zero quaternions become the identity
+    inline void normalizeQuats4(Simd::Float4& x, Simd::Float4& y, Simd::Float4& z, Simd::Float4& w) {
+      using Simd::Float4;
+      const Float4 zero = Float4::splat(0.0f), one = Float4::splat(1.0f);
+      const Float4 len = Simd::sqrt(x * x + y * y + z * z + w * w);
+      const Float4 degenerate = len < Float4::splat(1e-6f);
+      const Float4 inv = one / Simd::select(degenerate, one, len);
+      x = Simd::select(degenerate, zero, x * inv); y = Simd::select(degenerate, zero, y * inv);
+      z = Simd::select(degenerate, zero, z * inv); w = Simd::select(degenerate, one, w * inv);
+    }
+    // Vec3::normalized on four lanes, near-zero vectors become zero
+    inline void normalizeColumns4(Simd::Float4& x, Simd::Float4& y, Simd::Float4& z) {
+      using Simd::Float4;
+      const Float4 lenSq = x * x + y * y + z * z;
+      const Float4 degenerate = lenSq < Float4::splat(1e-12f);
+      const Float4 inv = Simd::select(degenerate, Float4::splat(0.0f), Float4::splat(1.0f) / Simd::sqrt(Simd::select(degenerate, Float4::splat(1.0f), lenSq)));
+      x = x * inv; y = y * inv; z = z * inv;
+    }
+  }
+
+  /*
+  Batched quaternion kernels
+  * Four quaternions per pass, transposed into one SIMD lane per component
+  * All spans must be the same length
+  */
+  inline void multiplyBatch(std::span<const Quat<float>> a, std::span<const Quat<float>> b, std::span<Quat<float>> out) {
+    using Simd::Float4;
+    assert(a.size() == b.size() && a.size() == out.size());
+
+    size_t i = 0;
+    for (; i + 4 <= out.size(); i += 4) {
+      Float4 ax, ay, az, aw, bx, by, bz, bw;
+      Detail::loadQuats4(&a[i], ax, ay, az, aw);
+      Detail::loadQuats4(&b[i], bx, by, bz, bw);
+      Detail::storeQuats4(&out[i],
+        aw * bx + ax * bw + ay * bz - az * by,
+        aw * by - ax * bz + ay * bw + az * bx,
+        aw * bz + ax * by - ay * bx + az * bw,
+        aw * bw - ax * bx - ay * by - az * bz);
+    }
+    for (; i < out.size(); ++i) out[i] = a[i] * b[i];
+  }
+  inline void nlerpBatch(std::span<const Quat<float>> a, std::span<const Quat<float>> b, const float t, std::span<Quat<float>> out) {
+    using Simd::Float4;
+    assert(a.size() == b.size() && a.size() == out.size());
+
+    const Float4 zero = Float4::splat(0.0f), tt = Float4::splat(t);
+    size_t i = 0;
+    for (; i + 4 <= out.size(); i += 4) {
+      Float4 ax, ay, az, aw, bx, by, bz, bw;
+      Detail::loadQuats4(&a[i], ax, ay, az, aw);
+      Detail::loadQuats4(&b[i], bx, by, bz, bw);
+
+      // Flip b onto a's hemisphere so interpolation takes the shorter arc
+      const Float4 flip = (ax * bx + ay * by + az * bz + aw * bw) < zero;
+      bx = Simd::select(flip, -bx, bx); by = Simd::select(flip, -by, by);
+      bz = Simd::select(flip, -bz, bz); bw = Simd::select(flip, -bw, bw);
+
+      Float4 x = Simd::madd(bx - ax, tt, ax), y = Simd::madd(by - ay, tt, ay);
+      Float4 z = Simd::madd(bz - az, tt, az), w = Simd::madd(bw - aw, tt, aw);
+      Detail::normalizeQuats4(x, y, z, w);
+      Detail::storeQuats4(&out[i], x, y, z, w);
+    }
+    for (; i < out.size(); ++i) out[i] = Quat<float>::nlerp(a[i], b[i], t);
+  }
+  // Lanes closer than the scalar slerp's 0.9995 cutoff fall back to nlerp, the rest use the
+  // polynomial Fast::atan2 and Fast::sincos, so results agree with Quat::slerp to a few 1e-7
+  inline void slerpBatch(std::span<const Quat<float>> a, std::span<const Quat<float>> b, const float t, std::span<Quat<float>> out) {
+    using Simd::Float4;
+    assert(a.size() == b.size() && a.size() == out.size());
+
+    const Float4 zero = Float4::splat(0.0f), one = Float4::splat(1.0f), tt = Float4::splat(t);
+    size_t i = 0;
+    for (; i + 4 <= out.size(); i += 4) {
+      Float4 ax, ay, az, aw, bx, by, bz, bw;
+      Detail::loadQuats4(&a[i], ax, ay, az, aw);
+      Detail::loadQuats4(&b[i], bx, by, bz, bw);
+
+      Float4 cosTheta = ax * bx + ay * by + az * bz + aw * bw;
+      const Float4 flip = cosTheta < zero;
+      cosTheta = Simd::select(flip, -cosTheta, cosTheta);
+      bx = Simd::select(flip, -bx, bx); by = Simd::select(flip, -by, by);
+      bz = Simd::select(flip, -bz, bz); bw = Simd::select(flip, -bw, bw);
+
+      Float4 nx = Simd::madd(bx - ax, tt, ax), ny = Simd::madd(by - ay, tt, ay);
+      Float4 nz = Simd::madd(bz - az, tt, az), nw = Simd::madd(bw - aw, tt, aw);
+      Detail::normalizeQuats4(nx, ny, nz, nw);
+
+      const Float4 nearlyParallel = cosTheta > Float4::splat(0.9995f);
+      const Float4 sinTheta = Simd::sqrt(Simd::max(zero, one - cosTheta * cosTheta));
+      const Float4 theta = Fast::atan2(sinTheta, cosTheta);
+      Float4 sa, sb, unused;
+      Fast::sincos((one - tt) * theta, sa, unused);
+      Fast::sincos(tt * theta, sb, unused);
+      const Float4 invSin = one / Simd::select(nearlyParallel, one, sinTheta);
+      const Float4 wa = sa * invSin, wb = sb * invSin;
+
+      Detail::storeQuats4(&out[i],
+        Simd::select(nearlyParallel, nx, ax * wa + bx * wb),
+        Simd::select(nearlyParallel, ny, ay * wa + by * wb),
+        Simd::select(nearlyParallel, nz, az * wa + bz * wb),
+        Simd::select(nearlyParallel, nw, aw * wa + bw * wb));
+    }
+    for (; i < out.size(); ++i) out[i] = Quat<float>::slerp(a[i], b[i], t);
+  }
+  // in and out may alias
+  inline void normalizeBatch(std::span<const Quat<float>> in, std::span<Quat<float>> out) {
+    using Simd::Float4;
+    assert(in.size() == out.size());
+
+    size_t i = 0;
+    for (; i + 4 <= out.size(); i += 4) {
+      Float4 x, y, z, w;
+      Detail::loadQuats4(&in[i], x, y, z, w);
+      Detail::normalizeQuats4(x, y, z, w);
+      Detail::storeQuats4(&out[i], x, y, z, w);
+    }
+    for (; i < out.size(); ++i) out[i] = in[i].normalized();
+  }
+  // out must hold q.size() matrices
+  inline void toMat4Batch(std::span<const Quat<float>> q, Mat4* out) {
+    using Simd::Float4;
+
+    const Float4 one = Float4::splat(1.0f), two = Float4::splat(2.0f), zero = Float4::splat(0.0f);
+    size_t i = 0;
+    for (; i + 4 <= q.size(); i += 4) {
+      Float4 x, y, z, w;
+      Detail::loadQuats4(&q[i], x, y, z, w);
+
+      const Float4 xx = x * x, yy = y * y, zz = z * z;
+      const Float4 xy = x * y, xz = x * z, yz = y * z;
+      const Float4 wx = w * x, wy = w * y, wz = w * z;
+
+      Float4 e[16] = {
+        one - two * (yy + zz), two * (xy + wz), two * (xz - wy), zero,
+        two * (xy - wz), one - two * (xx + zz), two * (yz + wx), zero,
+        two * (xz + wy), two * (yz - wx), one - two * (xx + yy), zero,
+        zero, zero, zero, one
+      };
+      for (int col = 0; col < 4; ++col) {
+        Float4* c = e + col * 4;
+        Simd::transpose(c[0], c[1], c[2], c[3]);
+        for (int l = 0; l < 4; ++l) c[l].store(out[i + l].models + col * 4);
+      }
+    }
+    for (; i < q.size(); ++i) out[i] = q[i].toMat4();
+  }
+  // m must hold out.size() matrices; all four Quat::fromMat4 branches are computed and the lane's one selected
+  inline void fromMat4Batch(const Mat4* m, std::span<Quat<float>> out) {
+    using Simd::Float4;
+
+    const Float4 zero = Float4::splat(0.0f), one = Float4::splat(1.0f), two = Float4::splat(2.0f), quarter = Float4::splat(0.25f);
+    size_t i = 0;
+    for (; i + 4 <= out.size(); i += 4) {
+      // c[col][row] holds models[col * 4 + row] for all four matrices
+      Float4 c[3][4];
+      for (int col = 0; col < 3; ++col) {
+        for (int l = 0; l < 4; ++l) c[col][l] = Float4::load(m[i + l].models + col * 4);
+        Simd::transpose(c[col][0], c[col][1], c[col][2], c[col][3]);
+        Detail::normalizeColumns4(c[col][0], c[col][1], c[col][2]);
+      }
+      const Float4 r00 = c[0][0], r10 = c[0][1], r20 = c[0][2];
+      const Float4 r01 = c[1][0], r11 = c[1][1], r21 = c[1][2];
+      const Float4 r02 = c[2][0], r12 = c[2][1], r22 = c[2][2];
+
+      const Float4 trace = r00 + r11 + r22;
+      const Float4 useW = trace > zero;
+      const Float4 useX = (r00 > r11) & (r00 > r22);
+      const Float4 useY = r11 > r22;
+
+      // s = 4 * the largest component, the other three come from off-diagonal sums over s
+      const Float4 sw = Simd::sqrt(Simd::max(zero, trace + one)) * two;
+      const Float4 sx = Simd::sqrt(Simd::max(zero, one + r00 - r11 - r22)) * two;
+      const Float4 sy = Simd::sqrt(Simd::max(zero, one + r11 - r00 - r22)) * two;
+      const Float4 sz = Simd::sqrt(Simd::max(zero, one + r22 - r00 - r11)) * two;
+      const Float4 s = Simd::select(useW, sw, Simd::select(useX, sx, Simd::select(useY, sy, sz)));
+      const Float4 inv = one / Simd::select(s > zero, s, one);
+
+      const Float4 xw = (r21 - r12) * inv, yw = (r02 - r20) * inv, zw = (r10 - r01) * inv;
+      const Float4 xy = (r01 + r10) * inv, xz = (r02 + r20) * inv, yz = (r12 + r21) * inv;
+      const Float4 big = s * quarter;
+
+      Float4 x = Simd::select(useW, xw, Simd::select(useX, big, Simd::select(useY, xy, xz)));
+      Float4 y = Simd::select(useW, yw, Simd::select(useX, xy, Simd::select(useY, big, yz)));
+      Float4 z = Simd::select(useW, zw, Simd::select(useX, xz, Simd::select(useY, yz, big)));
+      Float4 w = Simd::select(useW, big, Simd::select(useX, xw, Simd::select(useY, yw, zw)));
+      Detail::normalizeQuats4(x, y, z, w);
+      Detail::storeQuats4(&out[i], x, y, z, w);
+    }
+    for (; i < out.size(); ++i) out[i] = Quat<float>::fromMat4(m[i]);
+  }
+}
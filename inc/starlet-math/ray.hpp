@@ -0,0 +1,480 @@
+#pragma once
+
+#include "bounds.hpp"
+#include "bvh.hpp"
+#include "mat4_kernels.hpp"
+#include "simd.hpp"
+#include "vec3.hpp"
+#include "vertex.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Starlet::Math {
+  /*
+  Ray
+  * dir need not be normalized, hit distances are in multiples of dir
+  * Only hits with tMin <= t < tMax count
+  */
+  struct Ray {
+    Vec3<float> origin{ 0.0f };
+    Vec3<float> dir{ 0.0f, 0.0f, -1.0f };
+    float tMin{ 0.0f };
+    float tMax{ FLT_MAX };
+
+    Vec3<float> at(const float t) const { return origin + dir * t; }
+    // Per-axis 1 / dir for slab tests, zero components give infinities
+    Vec3<float> invDir() const { return { 1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z }; }
+  };
+
+  /*
+  RayHit
+  * Nearest hit so far, t starts at the ray's tMax
+  * u, v are barycentrics of the triangle's second and third vertex
+  */
+  struct RayHit {
+    static constexpr std::uint32_t NoHit = 0xFFFFFFFFu;
+
+    float t{ FLT_MAX };
+    float u{ 0.0f }, v{ 0.0f };
+    std::uint32_t triangle{ NoHit };
+
+    bool hit() const { return triangle != NoHit; }
+  };
+
+  /*
+  TrianglePacket
+  * Eight triangles as structure-of-arrays, the first vertex plus both edges precomputed
+  * Unused lanes hold degenerate triangles that never hit
+  * id is the triangle index, triangle i covers indices [3i, 3i + 3)
+  */
+  struct alignas(32) TrianglePacket {
+    static constexpr int Width = 8;
+
+    float v0x[Width]{}, v0y[Width]{}, v0z[Width]{};
+    float e1x[Width]{}, e1y[Width]{}, e1z[Width]{};
+    float e2x[Width]{}, e2y[Width]{}, e2z[Width]{};
+    std::uint32_t id[Width]{ RayHit::NoHit, RayHit::NoHit, RayHit::NoHit, RayHit::NoHit, RayHit::NoHit, RayHit::NoHit, RayHit::NoHit, RayHit::NoHit };
+
+    void set(const int lane, const Vec3<float>& a, const Vec3<float>& b, const Vec3<float>& c, const std::uint32_t triangle) {
+      const Vec3<float> e1 = b - a, e2 = c - a;
+      v0x[lane] = a.x; v0y[lane] = a.y; v0z[lane] = a.z;
+      e1x[lane] = e1.x; e1y[lane] = e1.y; e1z[lane] = e1.z;
+      e2x[lane] = e2.x; e2y[lane] = e2.y; e2z[lane] = e2.z;
+      id[lane] = triangle;
+    }
+  };
+
+  /*
+  RayPacket4
+  * Four rays as structure-of-arrays for coherent queries (picking rectangles, shadow rays from one point)
+  */
+  struct alignas(16) RayPacket4 {
+    float ox[4]{}, oy[4]{}, oz[4]{};
+    float invX[4]{}, invY[4]{}, invZ[4]{};
+    float tMin[4]{}, tMax[4]{};
+
+    RayPacket4() = default;
+    // Lanes past rays.size() never hit
+    explicit RayPacket4(std::span<const Ray> rays) {
+      assert(rays.size() <= 4);
+      for (size_t i = 0; i < 4; ++i) {
+        if (i >= rays.size()) {
+          tMin[i] = 1.0f;
+          tMax[i] = 0.0f;
+          continue;
+        }
+        const Vec3<float> inv = rays[i].invDir();
+        ox[i] = rays[i].origin.x; oy[i] = rays[i].origin.y; oz[i] = rays[i].origin.z;
+        invX[i] = inv.x; invY[i] = inv.y; invZ[i] = inv.z;
+        tMin[i] = rays[i].tMin;
+        tMax[i] = rays[i].tMax;
+      }
+    }
+  };
+
+  /*
+  Moller-Trumbore, two-sided
+  * Returns true and fills t, u, v when the ray hits inside [tMin, tMax)
+  */
+  inline bool intersectTriangle(const Ray& ray, const Vec3<float>& a, const Vec3<float>& b, const Vec3<float>& c, float& t, float& u, float& v) {
+    const Vec3<float> e1 = b - a, e2 = c - a;
+    const Vec3<float> p = ray.dir.cross(e2);
+    const float det = e1.dot(p);
+    if (std::abs(det) <= 1e-20f) return false;
+
+    const float invDet = 1.0f / det;
+    const Vec3<float> s = ray.origin - a;
+    u = s.dot(p) * invDet;
+    if (u < 0.0f || u > 1.0f) return false;
+
+    const Vec3<float> q = s.cross(e1);
+    v = ray.dir.dot(q) * invDet;
+    if (v < 0.0f || u + v > 1.0f) return false;
+
+    t = e2.dot(q) * invDet;
+    return t >= ray.tMin && t < ray.tMax;
+  }
+
+  // Slab test, tNear is where the ray enters the box (clamped to tMin)
+  inline bool intersectAABB(const Ray& ray, const Vec3<float>& invDir, const AABB& box, float& tNear, const float tFarLimit) {
+    const float tx1 = (box.min.x - ray.origin.x) * invDir.x, tx2 = (box.max.x - ray.origin.x) * invDir.x;
+    const float ty1 = (box.min.y - ray.origin.y) * invDir.y, ty2 = (box.max.y - ray.origin.y) * invDir.y;
+    const float tz1 = (box.min.z - ray.origin.z) * invDir.z, tz2 = (box.max.z - ray.origin.z) * invDir.z;
+
+    tNear = std::max({ std::min(tx1, tx2), std::min(ty1, ty2), std::min(tz1, tz2), ray.tMin });
+    const float tFar = std::min({ std::max(tx1, tx2), std::max(ty1, ty2), std::max(tz1, tz2), tFarLimit });
+    return tNear <= tFar;
+  }
+  inline bool intersectAABB(const Ray& ray, const AABB& box) {
+    float tNear;
+    return intersectAABB(ray, ray.invDir(), box, tNear, ray.tMax);
+  }
+
+  // Bit i is set when ray i of the packet hits box before its tMax, tNear receives the entry distances
+  inline int intersectAABB(const RayPacket4& rays, const AABB& box, Simd::Float4& tNear) {
+    using Simd::Float4;
+    const Float4 ox = Float4::loadAligned(rays.ox), oy = Float4::loadAligned(rays.oy), oz = Float4::loadAligned(rays.oz);
+    const Float4 ix = Float4::loadAligned(rays.invX), iy = Float4::loadAligned(rays.invY), iz = Float4::loadAligned(rays.invZ);
+
+    const Float4 tx1 = (Float4::splat(box.min.x) - ox) * ix, tx2 = (Float4::splat(box.max.x) - ox) * ix;
+    const Float4 ty1 = (Float4::splat(box.min.y) - oy) * iy, ty2 = (Float4::splat(box.max.y) - oy) * iy;
+    const Float4 tz1 = (Float4::splat(box.min.z) - oz) * iz, tz2 = (Float4::splat(box.max.z) - oz) * iz;
+
+    tNear = Simd::max(Simd::max(Simd::min(tx1, tx2), Simd::min(ty1, ty2)), Simd::max(Simd::min(tz1, tz2), Float4::loadAligned(rays.tMin)));
+    const Float4 tFar = Simd::min(Simd::min(Simd::max(tx1, tx2), Simd::max(ty1, ty2)), Simd::min(Simd::max(tz1, tz2), Float4::loadAligned(rays.tMax)));
+    return Simd::moveMask(tNear <= tFar);
+  }
+
+  namespace Detail {
+    inline float maskedMin(const Simd::Float4& v, const int mask) {
+      float m = FLT_MAX;
+      for (int i = 0; i < 4; ++i)
+        if (mask & (1 << i)) m = std::min(m, v.lane(i));
+      return m;
+    }
+
+    // Takes the nearest lane of bits, t/u/v hold one value per lane starting at lane `base`
+    inline bool pickNearest(int bits, const float* t, const float* u, const float* v, const TrianglePacket& p, const int base, RayHit& hit) {
+      if (bits == 0) return false;
+      int best = -1;
+      while (bits) {
+        const int lane = std::countr_zero(static_cast<unsigned>(bits));
+        bits &= bits - 1;
+        if (best < 0 || t[lane] < t[best]) best = lane;
+      }
+      hit.t = t[best];
+      hit.u = u[best];
+      hit.v = v[best];
+      hit.triangle = p.id[base + best];
+      return true;
+    }
+
+    inline bool intersectPacketScalar(const Ray& ray, const TrianglePacket& p, RayHit& hit) {
+      bool found = false;
+      for (int i = 0; i < TrianglePacket::Width; ++i) {
+        if (p.id[i] == RayHit::NoHit) continue;
+        const Vec3<float> a{ p.v0x[i], p.v0y[i], p.v0z[i] };
+        const Vec3<float> b = a + Vec3<float>(p.e1x[i], p.e1y[i], p.e1z[i]);
+        const Vec3<float> c = a + Vec3<float>(p.e2x[i], p.e2y[i], p.e2z[i]);
+
+        Ray clipped = ray;
+        clipped.tMax = hit.t;
+        float t, u, v;
+        if (intersectTriangle(clipped, a, b, c, t, u, v)) {
+          hit = { t, u, v, p.id[i] };
+          found = true;
+        }
+      }
+      return found;
+    }
+
+    // Four lanes starting at base, in Float4 so the STARLET_MATH_NO_SIMD build shares the code
+    inline bool intersectQuad(const Ray& ray, const TrianglePacket& p, const int base, RayHit& hit) {
+      using Simd::Float4;
+      const Float4 dx = Float4::splat(ray.dir.x), dy = Float4::splat(ray.dir.y), dz = Float4::splat(ray.dir.z);
+      const Float4 e1x = Float4::loadAligned(p.e1x + base), e1y = Float4::loadAligned(p.e1y + base), e1z = Float4::loadAligned(p.e1z + base);
+      const Float4 e2x = Float4::loadAligned(p.e2x + base), e2y = Float4::loadAligned(p.e2y + base), e2z = Float4::loadAligned(p.e2z + base);
+
+      const Float4 px = dy * e2z - dz * e2y, py = dz * e2x - dx * e2z, pz = dx * e2y - dy * e2x;
+      const Float4 det = e1x * px + e1y * py + e1z * pz;
+      const Float4 invDet = Float4::splat(1.0f) / det;
+
+      const Float4 sx = Float4::splat(ray.origin.x) - Float4::loadAligned(p.v0x + base);
+      const Float4 sy = Float4::splat(ray.origin.y) - Float4::loadAligned(p.v0y + base);
+      const Float4 sz = Float4::splat(ray.origin.z) - Float4::loadAligned(p.v0z + base);
+      const Float4 u = (sx * px + sy * py + sz * pz) * invDet;
+
+      const Float4 qx = sy * e1z - sz * e1y, qy = sz * e1x - sx * e1z, qz = sx * e1y - sy * e1x;
+      const Float4 v = (dx * qx + dy * qy + dz * qz) * invDet;
+      const Float4 t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+
+      const Float4 zero = Float4::splat(0.0f);
+      const Float4 mask = (Simd::max(det, -det) > Float4::splat(1e-20f)) & (u >= zero) & (v >= zero) & (u + v <= Float4::splat(1.0f))
+                        & (t >= Float4::splat(ray.tMin)) & (t < Float4::splat(hit.t));
+      const int bits = Simd::moveMask(mask);
+      if (bits == 0) return false;
+
+      alignas(16) float tl[4], ul[4], vl[4];
+      t.storeAligned(tl);
+      u.storeAligned(ul);
+      v.storeAligned(vl);
+      return pickNearest(bits, tl, ul, vl, p, base, hit);
+    }
+
+#ifdef STARLET_MATH_SSE
+    STARLET_MATH_TARGET_AVX2_FMA inline bool intersectPacketAvx2(const Ray& ray, const TrianglePacket& p, RayHit& hit) {
+      const __m256 dx = _mm256_set1_ps(ray.dir.x), dy = _mm256_set1_ps(ray.dir.y), dz = _mm256_set1_ps(ray.dir.z);
+      const __m256 e1x = _mm256_load_ps(p.e1x), e1y = _mm256_load_ps(p.e1y), e1z = _mm256_load_ps(p.e1z);
+      const __m256 e2x = _mm256_load_ps(p.e2x), e2y = _mm256_load_ps(p.e2y), e2z = _mm256_load_ps(p.e2z);
+
+      const __m256 px = _mm256_fmsub_ps(dy, e2z, _mm256_mul_ps(dz, e2y));
+      const __m256 py = _mm256_fmsub_ps(dz, e2x, _mm256_mul_ps(dx, e2z));
+      const __m256 pz = _mm256_fmsub_ps(dx, e2y, _mm256_mul_ps(dy, e2x));
+      const __m256 det = _mm256_fmadd_ps(e1x, px, _mm256_fmadd_ps(e1y, py, _mm256_mul_ps(e1z, pz)));
+      const __m256 invDet = _mm256_div_ps(_mm256_set1_ps(1.0f), det);
+
+      const __m256 sx = _mm256_sub_ps(_mm256_set1_ps(ray.origin.x), _mm256_load_ps(p.v0x));
+      const __m256 sy = _mm256_sub_ps(_mm256_set1_ps(ray.origin.y), _mm256_load_ps(p.v0y));
+      const __m256 sz = _mm256_sub_ps(_mm256_set1_ps(ray.origin.z), _mm256_load_ps(p.v0z));
+      const __m256 u = _mm256_mul_ps(_mm256_fmadd_ps(sx, px, _mm256_fmadd_ps(sy, py, _mm256_mul_ps(sz, pz))), invDet);
+
+      const __m256 qx = _mm256_fmsub_ps(sy, e1z, _mm256_mul_ps(sz, e1y));
+      const __m256 qy = _mm256_fmsub_ps(sz, e1x, _mm256_mul_ps(sx, e1z));
+      const __m256 qz = _mm256_fmsub_ps(sx, e1y, _mm256_mul_ps(sy, e1x));
+      const __m256 v = _mm256_mul_ps(_mm256_fmadd_ps(dx, qx, _mm256_fmadd_ps(dy, qy, _mm256_mul_ps(dz, qz))), invDet);
+      const __m256 t = _mm256_mul_ps(_mm256_fmadd_ps(e2x, qx, _mm256_fmadd_ps(e2y, qy, _mm256_mul_ps(e2z, qz))), invDet);
+
+      const __m256 zero = _mm256_setzero_ps();
+      const __m256 absDet = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), det);
+      __m256 mask = _mm256_cmp_ps(absDet, _mm256_set1_ps(1e-20f), _CMP_GT_OQ);
+      mask = _mm256_and_ps(mask, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+      mask = _mm256_and_ps(mask, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+      mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_add_ps(u, v), _mm256_set1_ps(1.0f), _CMP_LE_OQ));
+      mask = _mm256_and_ps(mask, _mm256_cmp_ps(t, _mm256_set1_ps(ray.tMin), _CMP_GE_OQ));
+      mask = _mm256_and_ps(mask, _mm256_cmp_ps(t, _mm256_set1_ps(hit.t), _CMP_LT_OQ));
+      const int bits = _mm256_movemask_ps(mask);
+      if (bits == 0) return false;
+
+      alignas(32) float tl[8], ul[8], vl[8];
+      _mm256_store_ps(tl, t);
+      _mm256_store_ps(ul, u);
+      _mm256_store_ps(vl, v);
+      return pickNearest(bits, tl, ul, vl, p, 0, hit);
+    }
+#endif
+  }
+
+  /*
+  Nearest hit of ray against the packet's triangles, closer than hit.t
+  * Updates hit and returns true when something closer was found
+  * Avx2Fma tests all eight lanes at once, Sse2 two groups of four, Scalar one triangle at a time
+  */
+  inline bool intersect(const Ray& ray, const TrianglePacket& p, RayHit& hit, const Kernels::Isa isa = Kernels::activeIsa) {
+    switch (isa) {
+#ifdef STARLET_MATH_SSE
+    case Kernels::Isa::Avx2Fma: return Detail::intersectPacketAvx2(ray, p, hit);
+    case Kernels::Isa::Sse2: {
+      const bool low = Detail::intersectQuad(ray, p, 0, hit);
+      const bool high = Detail::intersectQuad(ray, p, 4, hit);
+      return low || high;
+    }
+#endif
+    default: return Detail::intersectPacketScalar(ray, p, hit);
+    }
+  }
+
+  // Packs triangles (or the subset listed in triangleIds) eight at a time
+  inline void packTriangles(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices, std::span<const std::uint32_t> triangleIds,
+                            std::vector<TrianglePacket>& out) {
+    for (size_t i = 0; i < triangleIds.size(); i += TrianglePacket::Width) {
+      TrianglePacket& p = out.emplace_back();
+      const size_t count = std::min<size_t>(TrianglePacket::Width, triangleIds.size() - i);
+      for (size_t k = 0; k < count; ++k) {
+        const std::uint32_t tri = triangleIds[i + k];
+        p.set(static_cast<int>(k), vertices[indices[tri * 3]].pos, vertices[indices[tri * 3 + 1]].pos, vertices[indices[tri * 3 + 2]].pos, tri);
+      }
+    }
+  }
+  inline std::vector<TrianglePacket> packTriangles(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices) {
+    std::vector<std::uint32_t> ids(indices.size() / 3);
+    for (size_t i = 0; i < ids.size(); ++i) ids[i] = static_cast<std::uint32_t>(i);
+    std::vector<TrianglePacket> out;
+    out.reserve((ids.size() + TrianglePacket::Width - 1) / TrianglePacket::Width);
+    packTriangles(vertices, indices, ids, out);
+    return out;
+  }
+
+  // Brute-force nearest hit over every packet, for small meshes or as a reference
+  inline RayHit raycast(std::span<const TrianglePacket> packets, const Ray& ray, const Kernels::Isa isa = Kernels::activeIsa) {
+    RayHit hit;
+    hit.t = ray.tMax;
+    for (const TrianglePacket& p : packets) intersect(ray, p, hit, isa);
+    return hit;
+  }
+
+  /*
+  MeshRaycaster
+  * Bvh over an indexed triangle mesh with each leaf's triangles stored as TrianglePackets
+  * Rebuild after moving vertices, the packets hold copies of the positions
+  */
+  struct MeshRaycaster {
+    Bvh bvh;
+    std::vector<TrianglePacket> packets;
+    std::vector<std::uint32_t> firstPacket;  // per node, leaves own ceil(count / Width) packets from here
+
+    // Leaves of up to one packet unless options say otherwise
+    static BvhBuildOptions defaultBuildOptions() {
+      BvhBuildOptions options;
+      options.maxLeafSize = TrianglePacket::Width;
+      return options;
+    }
+
+    static MeshRaycaster build(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices, const BvhBuildOptions& options = defaultBuildOptions()) {
+      MeshRaycaster rc;
+      rc.bvh = Bvh::buildTriangles(vertices, indices, options);
+      rc.firstPacket.assign(rc.bvh.nodes.size(), 0);
+      for (size_t i = 0; i < rc.bvh.nodes.size(); ++i) {
+        const BvhNode& node = rc.bvh.nodes[i];
+        if (!node.isLeaf()) continue;
+        rc.firstPacket[i] = static_cast<std::uint32_t>(rc.packets.size());
+        packTriangles(vertices, indices, std::span<const std::uint32_t>(rc.bvh.primitives).subspan(node.offset, node.count), rc.packets);
+      }
+      return rc;
+    }
+
+    // Nearest hit, hit.t is ray.tMax when nothing was hit
+    RayHit raycast(const Ray& ray, const Kernels::Isa isa = Kernels::activeIsa) const {
+      RayHit hit;
+      hit.t = ray.tMax;
+      traverse(ray, hit, false, isa);
+      return hit;
+    }
+    // Any hit in [tMin, tMax), stops at the first one (line of sight, shadow rays)
+    bool occluded(const Ray& ray, const Kernels::Isa isa = Kernels::activeIsa) const {
+      RayHit hit;
+      hit.t = ray.tMax;
+      traverse(ray, hit, true, isa);
+      return hit.hit();
+    }
+
+    /*
+    Nearest hits for many rays, four at a time
+    * Each group walks the tree once as a RayPacket4, best when the rays are coherent
+    */
+    void raycast(std::span<const Ray> rays, std::span<RayHit> hits, const Kernels::Isa isa = Kernels::activeIsa) const {
+      assert(rays.size() == hits.size());
+      for (size_t i = 0; i < rays.size(); i += 4) {
+        const size_t count = std::min<size_t>(4, rays.size() - i);
+        traversePacket(rays.subspan(i, count), hits.subspan(i, count), isa);
+      }
+    }
+
+  private:
+    // Leaf packet range of node
+    std::span<const TrianglePacket> leafPackets(const std::uint32_t index) const {
+      const std::uint32_t count = (bvh.nodes[index].count + TrianglePacket::Width - 1) / TrianglePacket::Width;
+      return { packets.data() + firstPacket[index], count };
+    }
+
+    void traverse(const Ray& ray, RayHit& hit, const bool anyHit, const Kernels::Isa isa) const {
+      if (bvh.empty()) return;
+      const Vec3<float> invDir = ray.invDir();
+
+      float rootNear;
+      if (!intersectAABB(ray, invDir, bvh.nodes[0].bounds, rootNear, hit.t)) return;
+
+      // Bvh depth is capped at Bvh::MaxDepth and the nearer child is never pushed, so this never overflows
+      std::uint32_t stack[Bvh::MaxDepth + 1];
+      float stackNear[Bvh::MaxDepth + 1];
+      int top = 0;
+      stack[top] = 0;
+      stackNear[top++] = rootNear;
+
+      while (top > 0) {
+        --top;
+        if (stackNear[top] > hit.t) continue;
+        std::uint32_t index = stack[top];
+
+        for (;;) {
+          const BvhNode& node = bvh.nodes[index];
+          if (node.isLeaf()) {
+            for (const TrianglePacket& p : leafPackets(index))
+              if (intersect(ray, p, hit, isa) && anyHit) return;
+            break;
+          }
+
+          const std::uint32_t left = index + 1, right = node.offset;
+          float nearL, nearR;
+          const bool hitL = intersectAABB(ray, invDir, bvh.nodes[left].bounds, nearL, hit.t);
+          const bool hitR = intersectAABB(ray, invDir, bvh.nodes[right].bounds, nearR, hit.t);
+          if (hitL && hitR) {
+            // Descend into the nearer child and come back for the other one
+            const bool leftFirst = nearL <= nearR;
+            stack[top] = leftFirst ? right : left;
+            stackNear[top++] = leftFirst ? nearR : nearL;
+            index = leftFirst ? left : right;
+          }
+          else if (hitL) index = left;
+          else if (hitR) index = right;
+          else break;
+        }
+      }
+    }
+
+    void traversePacket(std::span<const Ray> rays, std::span<RayHit> hits, const Kernels::Isa isa) const {
+      RayPacket4 packet(rays);
+      for (size_t i = 0; i < rays.size(); ++i) {
+        hits[i] = RayHit{};
+        hits[i].t = rays[i].tMax;
+      }
+      if (bvh.empty()) return;
+
+      // Each level pops one node and pushes at most two, so the stack never holds more than depth + 1
+      std::uint32_t stack[Bvh::MaxDepth + 1];
+      int top = 0;
+      stack[top++] = 0;
+      while (top > 0) {
+        const std::uint32_t index = stack[--top];
+        const BvhNode& node = bvh.nodes[index];
+
+        // Shrink each ray's far limit to its best hit so finished rays drop out of the mask
+        for (size_t i = 0; i < rays.size(); ++i) packet.tMax[i] = hits[i].t;
+        Simd::Float4 tNear;
+        int active = intersectAABB(packet, node.bounds, tNear);
+        if (active == 0) continue;
+
+        if (node.isLeaf()) {
+          while (active) {
+            const int lane = std::countr_zero(static_cast<unsigned>(active));
+            active &= active - 1;
+            for (const TrianglePacket& p : leafPackets(index)) intersect(rays[lane], p, hits[lane], isa);
+          }
+          continue;
+        }
+
+        // Visit the child the packet reaches first, judged by its closest active ray
+        const std::uint32_t left = index + 1, right = node.offset;
+        Simd::Float4 nearL, nearR;
+        const int maskL = intersectAABB(packet, bvh.nodes[left].bounds, nearL);
+        const int maskR = intersectAABB(packet, bvh.nodes[right].bounds, nearR);
+        const float closestL = maskL ? Detail::maskedMin(nearL, maskL) : FLT_MAX;
+        const float closestR = maskR ? Detail::maskedMin(nearR, maskR) : FLT_MAX;
+        const bool leftFirst = closestL <= closestR;
+        if (maskL && maskR) {
+          stack[top++] = leftFirst ? right : left;
+          stack[top++] = leftFirst ? left : right;
+        }
+        else if (maskL) stack[top++] = left;
+        else if (maskR) stack[top++] = right;
+      }
+    }
+  };
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <type_traits>
+
+namespace Starlet::Math {
+  // Result type of length()/lengthSquared(), floating vectors stay in their own precision and integer vectors widen to double
+  template<typename T>
+  using LengthType = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+  namespace Detail {
+    // Largest absolute component, the rescale factor when a float lengthSquared() overflows
+    template<typename T, typename... Rest>
+    constexpr T maxAbs(const T first, const Rest... rest) {
+      const T m = first < T(0) ? -first : first;
+      if constexpr (sizeof...(rest) > 0) {
+        const T r = maxAbs(rest...);
+        return r > m ? r : m;
+      }
+      return m;
+    }
+  }
+}
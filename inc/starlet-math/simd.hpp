@@ -0,0 +1,192 @@
+#pragma once
+
+#if !defined(STARLET_MATH_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define STARLET_MATH_SSE 1
+#include <immintrin.h>
+#endif
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+namespace Starlet::Math::Simd {
+  /*
+  Float4
+  * Four float lanes, backed by an SSE register when available
+  * Define STARLET_MATH_NO_SIMD to force the scalar fallback
+  */
+  struct Float4 {
+#ifdef STARLET_MATH_SSE
+    __m128 v;
+
+    static Float4 load(const float* p) { return { _mm_loadu_ps(p) }; }
+    static Float4 loadAligned(const float* p) { return { _mm_load_ps(p) }; }
+    static Float4 splat(const float s) { return { _mm_set1_ps(s) }; }
+    static Float4 set(float a, float b, float c, float d) { return { _mm_setr_ps(a, b, c, d) }; }
+
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+    void storeAligned(float* p) const { _mm_store_ps(p, v); }
+    float lane(const int i) const { alignas(16) float out[4]; _mm_store_ps(out, v); return out[i]; }
+#else
+    float v[4];
+
+    static Float4 load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+    static Float4 loadAligned(const float* p) { return load(p); }
+    static Float4 splat(const float s) { return { { s, s, s, s } }; }
+    static Float4 set(float a, float b, float c, float d) { return { { a, b, c, d } }; }
+
+    void store(float* p) const { for (int i = 0; i < 4; ++i) p[i] = v[i]; }
+    void storeAligned(float* p) const { store(p); }
+    float lane(const int i) const { return v[i]; }
+#endif
+  };
+
+#ifdef STARLET_MATH_SSE
+  inline Float4 operator+(const Float4& a, const Float4& b) { return { _mm_add_ps(a.v, b.v) }; }
+  inline Float4 operator-(const Float4& a, const Float4& b) { return { _mm_sub_ps(a.v, b.v) }; }
+  inline Float4 operator*(const Float4& a, const Float4& b) { return { _mm_mul_ps(a.v, b.v) }; }
+  inline Float4 operator/(const Float4& a, const Float4& b) { return { _mm_div_ps(a.v, b.v) }; }
+  inline Float4 operator-(const Float4& a) { return { _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)) }; }
+
+  inline Float4 min(const Float4& a, const Float4& b) { return { _mm_min_ps(a.v, b.v) }; }
+  inline Float4 max(const Float4& a, const Float4& b) { return { _mm_max_ps(a.v, b.v) }; }
+  inline Float4 sqrt(const Float4& a) { return { _mm_sqrt_ps(a.v) }; }
+
+  // a * b + c
+  inline Float4 madd(const Float4& a, const Float4& b, const Float4& c) {
+#ifdef __FMA__
+    return { _mm_fmadd_ps(a.v, b.v, c.v) };
+#else
+    return { _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v) };
+#endif
+  }
+
+  inline void transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3) { _MM_TRANSPOSE4_PS(r0.v, r1.v, r2.v, r3.v); }
+
+  // Comparisons produce all-ones / all-zeros lane masks
+  inline Float4 operator==(const Float4& a, const Float4& b) { return { _mm_cmpeq_ps(a.v, b.v) }; }
+  inline Float4 operator<(const Float4& a, const Float4& b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+  inline Float4 operator<=(const Float4& a, const Float4& b) { return { _mm_cmple_ps(a.v, b.v) }; }
+  inline Float4 operator>(const Float4& a, const Float4& b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+  inline Float4 operator>=(const Float4& a, const Float4& b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+  inline Float4 operator&(const Float4& a, const Float4& b) { return { _mm_and_ps(a.v, b.v) }; }
+  inline Float4 operator|(const Float4& a, const Float4& b) { return { _mm_or_ps(a.v, b.v) }; }
+
+  // Lanes of a where mask is set, b elsewhere
+  inline Float4 select(const Float4& mask, const Float4& a, const Float4& b) { return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) }; }
+  // One bit per lane, lane 0 in bit 0
+  inline int moveMask(const Float4& mask) { return _mm_movemask_ps(mask.v); }
+#else
+  namespace Detail {
+    template<typename Op>
+    inline Float4 map(const Float4& a, const Float4& b, Op op) {
+      return { { op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3]) } };
+    }
+  }
+
+  inline Float4 operator+(const Float4& a, const Float4& b) { return Detail::map(a, b, [](float x, float y) { return x + y; }); }
+  inline Float4 operator-(const Float4& a, const Float4& b) { return Detail::map(a, b, [](float x, float y) { return x - y; }); }
+  inline Float4 operator*(const Float4& a, const Float4& b) { return Detail::map(a, b, [](float x, float y) { return x * y; }); }
+  inline Float4 operator/(const Float4& a, const Float4& b) { return Detail::map(a, b, [](float x, float y) { return x / y; }); }
+  inline Float4 operator-(const Float4& a) { return { { -a.v[0], -a.v[1], -a.v[2], -a.v[3] } }; }
+
+  inline Float4 min(const Float4& a, const Float4& b) { return Detail::map(a, b, [](float x, float y) { return y < x ? y : x; }); }
+  inline Float4 max(const Float4& a, const Float4& b) { return Detail::map(a, b, [](float x, float y) { return y > x ? y : x; }); }
+  inline Float4 sqrt(const Float4& a) { return { { std::sqrt(a.v[0]), std::sqrt(a.v[1]), std::sqrt(a.v[2]), std::sqrt(a.v[3]) } }; }
+
+  // a * b + c
+  inline Float4 madd(const Float4& a, const Float4& b, const Float4& c) { return a * b + c; }
+
+  inline void transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3) {
+    Float4 t0{ { r0.v[0], r1.v[0], r2.v[0], r3.v[0] } };
+    Float4 t1{ { r0.v[1], r1.v[1], r2.v[1], r3.v[1] } };
+    Float4 t2{ { r0.v[2], r1.v[2], r2.v[2], r3.v[2] } };
+    Float4 t3{ { r0.v[3], r1.v[3], r2.v[3], r3.v[3] } };
+    r0 = t0; r1 = t1; r2 = t2; r3 = t3;
+  }
+
+  namespace Detail {
+    inline float maskLane(const bool set) { return std::bit_cast<float>(set ? 0xFFFFFFFFu : 0u); }
+    inline bool laneSet(const float lane) { return std::bit_cast<std::uint32_t>(lane) != 0u; }
+
+    template<typename Op>
+    inline Float4 compare(const Float4& a, const Float4& b, Op op) {
+      return { { maskLane(op(a.v[0], b.v[0])), maskLane(op(a.v[1], b.v[1])), maskLane(op(a.v[2], b.v[2])), maskLane(op(a.v[3], b.v[3])) } };
+    }
+  }
+
+  // Comparisons produce all-ones / all-zeros lane masks
+  inline Float4 operator==(const Float4& a, const Float4& b) { return Detail::compare(a, b, [](float x, float y) { return x == y; }); }
+  inline Float4 operator<(const Float4& a, const Float4& b) { return Detail::compare(a, b, [](float x, float y) { return x < y; }); }
+  inline Float4 operator<=(const Float4& a, const Float4& b) { return Detail::compare(a, b, [](float x, float y) { return x <= y; }); }
+  inline Float4 operator>(const Float4& a, const Float4& b) { return Detail::compare(a, b, [](float x, float y) { return x > y; }); }
+  inline Float4 operator>=(const Float4& a, const Float4& b) { return Detail::compare(a, b, [](float x, float y) { return x >= y; }); }
+  inline Float4 operator&(const Float4& a, const Float4& b) {
+    Float4 r;
+    for (int i = 0; i < 4; ++i) r.v[i] = std::bit_cast<float>(std::bit_cast<std::uint32_t>(a.v[i]) & std::bit_cast<std::uint32_t>(b.v[i]));
+    return r;
+  }
+  inline Float4 operator|(const Float4& a, const Float4& b) {
+    Float4 r;
+    for (int i = 0; i < 4; ++i) r.v[i] = std::bit_cast<float>(std::bit_cast<std::uint32_t>(a.v[i]) | std::bit_cast<std::uint32_t>(b.v[i]));
+    return r;
+  }
+
+  // Lanes of a where mask is set, b elsewhere
+  inline Float4 select(const Float4& mask, const Float4& a, const Float4& b) {
+    return { { Detail::laneSet(mask.v[0]) ? a.v[0] : b.v[0], Detail::laneSet(mask.v[1]) ? a.v[1] : b.v[1],
+               Detail::laneSet(mask.v[2]) ? a.v[2] : b.v[2], Detail::laneSet(mask.v[3]) ? a.v[3] : b.v[3] } };
+  }
+  // One bit per lane, lane 0 in bit 0
+  inline int moveMask(const Float4& mask) {
+    int bits = 0;
+    for (int i = 0; i < 4; ++i) bits |= (std::bit_cast<std::uint32_t>(mask.v[i]) >> 31) << i;
+    return bits;
+  }
+#endif
+
+  // Scalar madd so kernels can be written once for float and Float4
+  inline float madd(const float a, const float b, const float c) { return a * b + c; }
+
+  // Deinterleaves four packed xyz triples (12 floats) into one lane per component
+  inline void loadXYZ4(const float* p, Float4& x, Float4& y, Float4& z) {
+#ifdef STARLET_MATH_SSE
+    const __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4), c = _mm_loadu_ps(p + 8);
+    x.v = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+    y.v = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    z.v = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+#else
+    x = Float4::set(p[0], p[3], p[6], p[9]);
+    y = Float4::set(p[1], p[4], p[7], p[10]);
+    z = Float4::set(p[2], p[5], p[8], p[11]);
+#endif
+  }
+  // Inverse of loadXYZ4
+  inline void storeXYZ4(float* p, const Float4& x, const Float4& y, const Float4& z) {
+#ifdef STARLET_MATH_SSE
+    const __m128 a = _mm_shuffle_ps(_mm_shuffle_ps(x.v, y.v, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z.v, x.v, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 b = _mm_shuffle_ps(_mm_shuffle_ps(y.v, z.v, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x.v, y.v, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 c = _mm_shuffle_ps(_mm_shuffle_ps(z.v, x.v, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y.v, z.v, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    _mm_storeu_ps(p, a);
+    _mm_storeu_ps(p + 4, b);
+    _mm_storeu_ps(p + 8, c);
+#else
+    for (int i = 0; i < 4; ++i) {
+      p[i * 3] = x.v[i];
+      p[i * 3 + 1] = y.v[i];
+      p[i * 3 + 2] = z.v[i];
+    }
+#endif
+  }
+
+  inline float horizontalMin(const Float4& a) {
+    float m = a.lane(0);
+    for (int i = 1; i < 4; ++i) m = a.lane(i) < m ? a.lane(i) : m;
+    return m;
+  }
+  inline float horizontalMax(const Float4& a) {
+    float m = a.lane(0);
+    for (int i = 1; i < 4; ++i) m = a.lane(i) > m ? a.lane(i) : m;
+    return m;
+  }
+}
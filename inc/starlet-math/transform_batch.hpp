@@ -0,0 +1,131 @@
+#pragma once
+
+#include "fast_math.hpp"
+#include "mat4.hpp"
+#include "simd.hpp"
+#include "transform.hpp"
+#include "constants.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace Starlet::Math {
+  /*
+  TransformBatch
+  * Structure-of-arrays storage for many Transforms
+  * One lane per component so batched kernels can load four entities at once
+  */
+  struct TransformBatch {
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> rotX, rotY, rotZ;
+    std::vector<float> sizeX, sizeY, sizeZ;
+
+    size_t count() const { return posX.size(); }
+    bool empty() const { return posX.empty(); }
+
+    void reserve(const size_t n) {
+      for (std::vector<float>* lane : lanes()) lane->reserve(n);
+    }
+    void resize(const size_t n) {
+      posX.resize(n, 0.0f); posY.resize(n, 0.0f); posZ.resize(n, 0.0f);
+      rotX.resize(n, 0.0f); rotY.resize(n, 0.0f); rotZ.resize(n, 0.0f);
+      sizeX.resize(n, 1.0f); sizeY.resize(n, 1.0f); sizeZ.resize(n, 1.0f);
+    }
+    void clear() {
+      for (std::vector<float>* lane : lanes()) lane->clear();
+    }
+
+    void push(const Transform& t) {
+      posX.push_back(t.pos.x); posY.push_back(t.pos.y); posZ.push_back(t.pos.z);
+      rotX.push_back(t.rot.x); rotY.push_back(t.rot.y); rotZ.push_back(t.rot.z);
+      sizeX.push_back(t.size.x); sizeY.push_back(t.size.y); sizeZ.push_back(t.size.z);
+    }
+    void set(const size_t i, const Transform& t) {
+      posX[i] = t.pos.x; posY[i] = t.pos.y; posZ[i] = t.pos.z;
+      rotX[i] = t.rot.x; rotY[i] = t.rot.y; rotZ[i] = t.rot.z;
+      sizeX[i] = t.size.x; sizeY[i] = t.size.y; sizeZ[i] = t.size.z;
+    }
+    Transform get(const size_t i) const {
+      Transform t;
+      t.pos = { posX[i], posY[i], posZ[i], 1.0f };
+      t.rot = { rotX[i], rotY[i], rotZ[i] };
+      t.size = { sizeX[i], sizeY[i], sizeZ[i] };
+      return t;
+    }
+
+  private:
+    std::array<std::vector<float>*, 9> lanes() {
+      return { &posX, &posY, &posZ, &rotX, &rotY, &rotZ, &sizeX, &sizeY, &sizeZ };
+    }
+  };
+
+  namespace Detail {
+    // Builds four model matrices from four entities' worth of lane data.
+    // Same composition as Mat4::modelMatrix, with the polynomial Fast::sincos on all four lanes at once.
+    inline void buildModelMatrices4(const float* px, const float* py, const float* pz,
+                                    const float* rx, const float* ry, const float* rz,
+                                    const float* sx, const float* sy, const float* sz,
+                                    Mat4* out) {
+      using Simd::Float4;
+
+      const Float4 toRad = Float4::splat(DEG_TO_RAD);
+      Float4 snx, csx, sny, csy, snz, csz;
+      Fast::sincos(Float4::load(rx) * toRad, snx, csx);
+      Fast::sincos(Float4::load(ry) * toRad, sny, csy);
+      Fast::sincos(Float4::load(rz) * toRad, snz, csz);
+
+      // Column-major element lanes, e[k] holds models[k] for all four entities
+      Float4 e[16];
+      composeTRS(snx, csx, sny, csy, snz, csz, Float4::load(sx), Float4::load(sy), Float4::load(sz), e);
+      e[3] = e[7] = e[11] = Float4::splat(0.0f);
+
+      e[12] = Float4::load(px);
+      e[13] = Float4::load(py);
+      e[14] = Float4::load(pz);
+      e[15] = Float4::splat(1.0f);
+
+      // Transposing each group of four lanes yields one column per entity
+      for (int col = 0; col < 4; ++col) {
+        Float4* c = e + col * 4;
+        Simd::transpose(c[0], c[1], c[2], c[3]);
+        for (int l = 0; l < 4; ++l) c[l].store(out[l].models + col * 4);
+      }
+    }
+  }
+
+  // Writes batch.count() model matrices to out, matching Mat4::modelMatrix per entity to within Fast::SINCOS_MAX_ERROR
+  inline void buildModelMatrices(const TransformBatch& batch, Mat4* out) {
+    const size_t n = batch.count();
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+      Detail::buildModelMatrices4(
+        &batch.posX[i], &batch.posY[i], &batch.posZ[i],
+        &batch.rotX[i], &batch.rotY[i], &batch.rotZ[i],
+        &batch.sizeX[i], &batch.sizeY[i], &batch.sizeZ[i],
+        out + i);
+    }
+    if (i == n) return;
+
+    // Pad the remainder out to a full block of identity transforms
+    float lanes[9][4];
+    for (int k = 0; k < 9; ++k)
+      for (int l = 0; l < 4; ++l)
+        lanes[k][l] = k >= 6 ? 1.0f : 0.0f;
+
+    const std::vector<float>* src[9] = {
+      &batch.posX, &batch.posY, &batch.posZ,
+      &batch.rotX, &batch.rotY, &batch.rotZ,
+      &batch.sizeX, &batch.sizeY, &batch.sizeZ
+    };
+    for (size_t l = 0; i + l < n; ++l)
+      for (int k = 0; k < 9; ++k)
+        lanes[k][l] = (*src[k])[i + l];
+
+    Mat4 tail[4];
+    Detail::buildModelMatrices4(lanes[0], lanes[1], lanes[2], lanes[3], lanes[4], lanes[5], lanes[6], lanes[7], lanes[8], tail);
+    for (size_t l = 0; i + l < n; ++l) out[i + l] = tail[l];
+  }
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "mat4.hpp"
+#include "parallel.hpp"
+#include "transform.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Starlet::Math {
+  /*
+  TransformHierarchy
+  * Flat parent-index scene graph with cached world matrices
+  * Parents always precede their children, so one forward pass updates everything
+  * world = parentWorld * Mat4::modelMatrix(local)
+  */
+  struct TransformHierarchy {
+    static constexpr std::uint32_t NoParent = UINT32_MAX;
+
+    size_t size() const { return parents.size(); }
+    bool empty() const { return parents.empty(); }
+
+    // parent must already be in the hierarchy, returns the new node's index
+    std::uint32_t add(const Transform& local, const std::uint32_t parent = NoParent) {
+      assert(parent == NoParent || parent < size());
+
+      const std::uint32_t index = static_cast<std::uint32_t>(size());
+      const std::uint32_t depth = parent == NoParent ? 0 : depths[parent] + 1;
+      if (sorted && !depths.empty() && depth < depths.back()) sorted = false;
+
+      parents.push_back(parent);
+      depths.push_back(depth);
+      locals.push_back(local);
+      worlds.push_back(Mat4::identity());
+      dirty.push_back(1);
+      return index;
+    }
+    void clear() {
+      parents.clear(); depths.clear(); locals.clear(); worlds.clear(); dirty.clear();
+      sorted = true;
+    }
+
+    std::uint32_t parent(const std::uint32_t i) const { return parents[i]; }
+    std::uint32_t depth(const std::uint32_t i) const { return depths[i]; }
+    const Transform& local(const std::uint32_t i) const { return locals[i]; }
+    // Valid as of the last update()
+    const Mat4& world(const std::uint32_t i) const { return worlds[i]; }
+
+    void setLocal(const std::uint32_t i, const Transform& t) {
+      locals[i] = t;
+      dirty[i] = 1;
+    }
+    void markDirty(const std::uint32_t i) { dirty[i] = 1; }
+
+    // True when nodes are grouped by depth, which updateParallel needs
+    bool isBreadthFirst() const { return sorted; }
+
+    /*
+    Reorders nodes by depth, keeping insertion order within a level
+    * Returns remap where remap[oldIndex] is the node's new index
+    */
+    std::vector<std::uint32_t> sortBreadthFirst() {
+      const size_t n = size();
+      std::vector<std::uint32_t> remap(n);
+
+      std::vector<size_t> levelCount;
+      for (std::uint32_t d : depths) {
+        if (d >= levelCount.size()) levelCount.resize(d + 1, 0);
+        ++levelCount[d];
+      }
+      std::vector<size_t> next(levelCount.size(), 0);
+      for (size_t d = 1; d < levelCount.size(); ++d) next[d] = next[d - 1] + levelCount[d - 1];
+      for (size_t i = 0; i < n; ++i) remap[i] = static_cast<std::uint32_t>(next[depths[i]]++);
+
+      std::vector<std::uint32_t> newParents(n), newDepths(n);
+      std::vector<Transform> newLocals(n);
+      std::vector<Mat4> newWorlds(n);
+      std::vector<std::uint8_t> newDirty(n);
+      for (size_t i = 0; i < n; ++i) {
+        const std::uint32_t j = remap[i];
+        newParents[j] = parents[i] == NoParent ? NoParent : remap[parents[i]];
+        newDepths[j] = depths[i];
+        newLocals[j] = locals[i];
+        newWorlds[j] = worlds[i];
+        newDirty[j] = dirty[i];
+      }
+
+      parents = std::move(newParents);
+      depths = std::move(newDepths);
+      locals = std::move(newLocals);
+      worlds = std::move(newWorlds);
+      dirty = std::move(newDirty);
+      sorted = true;
+      return remap;
+    }
+
+    // Recomputes dirty nodes and their descendants, returns how many were recomputed
+    size_t update() {
+      const size_t n = size();
+      size_t recomputed = 0;
+      for (size_t i = 0; i < n; ++i) {
+        if (updateNode(i)) ++recomputed;
+      }
+      std::fill(dirty.begin(), dirty.end(), std::uint8_t(0));
+      return recomputed;
+    }
+    /*
+    Same as update(), one level at a time with each level split across threads
+    * Falls back to update() unless the hierarchy is breadth-first sorted
+    */
+    size_t updateParallel(const unsigned threads = 0) {
+      if (!sorted) return update();
+
+      const size_t n = size();
+      std::atomic<size_t> recomputed{ 0 };
+      size_t begin = 0;
+      while (begin < n) {
+        size_t end = begin;
+        while (end < n && depths[end] == depths[begin]) ++end;
+
+        parallelFor(end - begin, 256, [&](size_t first, size_t last) {
+          size_t local = 0;
+          for (size_t i = begin + first; i < begin + last; ++i)
+            if (updateNode(i)) ++local;
+          recomputed += local;
+        }, threads);
+        begin = end;
+      }
+      std::fill(dirty.begin(), dirty.end(), std::uint8_t(0));
+      return recomputed;
+    }
+
+  private:
+    std::vector<std::uint32_t> parents;
+    std::vector<std::uint32_t> depths;
+    std::vector<Transform> locals;
+    std::vector<Mat4> worlds;
+    std::vector<std::uint8_t> dirty;
+    bool sorted{ true };
+
+    // Parent is already final when this runs, its dirty flag says whether it moved this update
+    bool updateNode(const size_t i) {
+      const std::uint32_t p = parents[i];
+      if (p != NoParent && dirty[p]) dirty[i] = 1;
+      if (!dirty[i]) return false;
+
+      const Mat4 local = Mat4::modelMatrix(locals[i]);
+      worlds[i] = p == NoParent ? local : worlds[p] * local;
+      return true;
+    }
+  };
+}
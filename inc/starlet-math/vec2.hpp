@@ -1,6 +1,10 @@
 #pragma once
 
+#include "constexpr_math.hpp"
+#include "scalar_traits.hpp"
+
 #include <cmath>
+#include <limits>
 #include <type_traits>
 
 namespace Starlet::Math {
@@ -18,45 +22,61 @@ namespace Starlet::Math {
     constexpr Vec2(T xVal, T yVal) : x(xVal), y(yVal) {}
     constexpr Vec2(const Vec2& other) = default;
 
-    Vec2& operator=(const Vec2& other) = default;
+    constexpr Vec2& operator=(const Vec2& other) = default;
 
-    T length() const { return std::sqrt(x * x + y * y); }
-    T lengthSquared() const { return x * x + y * y; }
+    constexpr LengthType<T> length() const {
+      const LengthType<T> lenSq = lengthSquared();
+      // Components past ~1.8e19 overflow a float lengthSquared(), measure a rescaled copy instead
+      if constexpr (std::is_floating_point_v<T>) {
+        if (lenSq > std::numeric_limits<T>::max()) {
+          const T scale = Detail::maxAbs(x, y);
+          if (scale <= std::numeric_limits<T>::max()) return scale * (*this / scale).length();
+        }
+      }
+      return Cx::sqrt(lenSq);
+    }
+    constexpr LengthType<T> lengthSquared() const { return static_cast<LengthType<T>>(x) * x + static_cast<LengthType<T>>(y) * y; }
 
-    Vec2<double> normalized() const requires std::is_integral_v<T> {
+    constexpr Vec2<double> normalized() const requires std::is_integral_v<T> {
       double len = length();
       return (len < 1e-6) ? Vec2<double>(0) : Vec2<double>(x / len, y / len);
     }
-    Vec2<T> normalized() const requires std::is_floating_point_v<T> {
-      T len = static_cast<T>(length());
-      return (len < 1e-6) ? Vec2<T>(0) : Vec2<T>(x / len, y / len);
+    constexpr Vec2<T> normalized() const requires std::is_floating_point_v<T> {
+      const T lenSq = lengthSquared();
+      if (lenSq < T(1e-12)) return Vec2<T>(T(0));
+      if (lenSq > std::numeric_limits<T>::max()) {
+        const T scale = Detail::maxAbs(x, y);
+        if (scale <= std::numeric_limits<T>::max()) return (*this / scale).normalized();
+      }
+      const T inv = T(1) / Cx::sqrt(lenSq);
+      return Vec2<T>(x * inv, y * inv);
     }
 
-    T dot(const Vec2& rhs) const { return x * rhs.x + y * rhs.y; }
+    constexpr T dot(const Vec2& rhs) const { return x * rhs.x + y * rhs.y; }
 
-    Vec2 operator-() const { return Vec2(-x, -y); }
+    constexpr Vec2 operator-() const { return Vec2(-x, -y); }
 
-    Vec2 operator+(const Vec2& rhs) const { return Vec2(x + rhs.x, y + rhs.y); }
-    Vec2 operator-(const Vec2& rhs) const { return Vec2(x - rhs.x, y - rhs.y); }
-    Vec2 operator*(const Vec2& rhs) const { return Vec2(x * rhs.x, y * rhs.y); }
-    Vec2 operator/(const Vec2& rhs) const { return Vec2(x / rhs.x, y / rhs.y); }
+    constexpr Vec2 operator+(const Vec2& rhs) const { return Vec2(x + rhs.x, y + rhs.y); }
+    constexpr Vec2 operator-(const Vec2& rhs) const { return Vec2(x - rhs.x, y - rhs.y); }
+    constexpr Vec2 operator*(const Vec2& rhs) const { return Vec2(x * rhs.x, y * rhs.y); }
+    constexpr Vec2 operator/(const Vec2& rhs) const { return Vec2(x / rhs.x, y / rhs.y); }
 
-    Vec2 operator+(const T rhs) const { return Vec2(x + rhs, y + rhs); }
-    Vec2 operator-(const T rhs) const { return Vec2(x - rhs, y - rhs); }
-    Vec2 operator*(const T rhs) const { return Vec2(x * rhs, y * rhs); }
-    Vec2 operator/(const T rhs) const { return Vec2(x / rhs, y / rhs); }
+    constexpr Vec2 operator+(const T rhs) const { return Vec2(x + rhs, y + rhs); }
+    constexpr Vec2 operator-(const T rhs) const { return Vec2(x - rhs, y - rhs); }
+    constexpr Vec2 operator*(const T rhs) const { return Vec2(x * rhs, y * rhs); }
+    constexpr Vec2 operator/(const T rhs) const { return Vec2(x / rhs, y / rhs); }
 
-    Vec2& operator+=(const Vec2& rhs) { x += rhs.x; y += rhs.y; return *this; }
-    Vec2& operator-=(const Vec2& rhs) { x -= rhs.x; y -= rhs.y; return *this; }
-    Vec2& operator*=(const Vec2& rhs) { x *= rhs.x; y *= rhs.y; return *this; }
-    Vec2& operator/=(const Vec2& rhs) { x /= rhs.x; y /= rhs.y; return *this; }
+    constexpr Vec2& operator+=(const Vec2& rhs) { x += rhs.x; y += rhs.y; return *this; }
+    constexpr Vec2& operator-=(const Vec2& rhs) { x -= rhs.x; y -= rhs.y; return *this; }
+    constexpr Vec2& operator*=(const Vec2& rhs) { x *= rhs.x; y *= rhs.y; return *this; }
+    constexpr Vec2& operator/=(const Vec2& rhs) { x /= rhs.x; y /= rhs.y; return *this; }
 
-    Vec2& operator+=(const T rhs) { x += rhs; y += rhs; return *this; }
-    Vec2& operator-=(const T rhs) { x -= rhs; y -= rhs; return *this; }
-    Vec2& operator*=(const T rhs) { x *= rhs; y *= rhs; return *this; }
-    Vec2& operator/=(const T rhs) { x /= rhs; y /= rhs; return *this; }
+    constexpr Vec2& operator+=(const T rhs) { x += rhs; y += rhs; return *this; }
+    constexpr Vec2& operator-=(const T rhs) { x -= rhs; y -= rhs; return *this; }
+    constexpr Vec2& operator*=(const T rhs) { x *= rhs; y *= rhs; return *this; }
+    constexpr Vec2& operator/=(const T rhs) { x /= rhs; y /= rhs; return *this; }
 
-    bool operator==(const Vec2& rhs) const { return x == rhs.x && y == rhs.y; }
-    bool operator!=(const Vec2& rhs) const { return !(*this == rhs); }
+    constexpr bool operator==(const Vec2& rhs) const { return x == rhs.x && y == rhs.y; }
+    constexpr bool operator!=(const Vec2& rhs) const { return !(*this == rhs); }
   };
 }
\ No newline at end of file
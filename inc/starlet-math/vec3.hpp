@@ -1,6 +1,10 @@
 #pragma once
 
+#include "constexpr_math.hpp"
+#include "scalar_traits.hpp"
+
 #include <cmath>
+#include <limits>
 #include <type_traits>
 #include <ostream>
 
@@ -22,47 +26,63 @@ namespace Starlet::Math {
 		constexpr Vec3(T xIn, T yIn, T zIn) : x(xIn), y(yIn), z(zIn) {}
 		constexpr Vec3(const Vec3& other) = default;
 
-		Vec3& operator=(const Vec3& other) = default;
+		constexpr Vec3& operator=(const Vec3& other) = default;
 
-		double length() const { return std::sqrt(static_cast<double>(x) * x + static_cast<double>(y) * y + static_cast<double>(z) * z); }
-		double lengthSquared() const { return static_cast<double>(x) * x + static_cast<double>(y) * y + static_cast<double>(z) * z; }
+		constexpr LengthType<T> length() const {
+			const LengthType<T> lenSq = lengthSquared();
+			// Components past ~1.8e19 overflow a float lengthSquared(), measure a rescaled copy instead
+			if constexpr (std::is_floating_point_v<T>) {
+				if (lenSq > std::numeric_limits<T>::max()) {
+					const T scale = Detail::maxAbs(x, y, z);
+					if (scale <= std::numeric_limits<T>::max()) return scale * (*this / scale).length();
+				}
+			}
+			return Cx::sqrt(lenSq);
+		}
+		constexpr LengthType<T> lengthSquared() const { return static_cast<LengthType<T>>(x) * x + static_cast<LengthType<T>>(y) * y + static_cast<LengthType<T>>(z) * z; }
 
-		Vec3<double> normalized() const requires std::is_integral_v<T> {
+		constexpr Vec3<double> normalized() const requires std::is_integral_v<T> {
 			double len = length();
 			return (len < 1e-6) ? Vec3<double>(0.0) : Vec3<double>(x / len, y / len, z / len);
 		}
-		Vec3<T> normalized() const requires std::is_floating_point_v<T> {
-			T len = static_cast<T>(length());
-			return (len < 1e-6) ? Vec3<T>(T(0)) : Vec3<T>(x / len, y / len, z / len);
+		constexpr Vec3<T> normalized() const requires std::is_floating_point_v<T> {
+			const T lenSq = lengthSquared();
+			if (lenSq < T(1e-12)) return Vec3<T>(T(0));
+			if (lenSq > std::numeric_limits<T>::max()) {
+				const T scale = Detail::maxAbs(x, y, z);
+				if (scale <= std::numeric_limits<T>::max()) return (*this / scale).normalized();
+			}
+			const T inv = T(1) / Cx::sqrt(lenSq);
+			return Vec3<T>(x * inv, y * inv, z * inv);
 		}
 
-		Vec3 cross(const Vec3& rhs) const { return { y * rhs.z - z * rhs.y, z * rhs.x - x * rhs.z, x * rhs.y - y * rhs.x }; }
-		T dot(const Vec3& rhs) const { return x * rhs.x + y * rhs.y + z * rhs.z; }
+		constexpr Vec3 cross(const Vec3& rhs) const { return { y * rhs.z - z * rhs.y, z * rhs.x - x * rhs.z, x * rhs.y - y * rhs.x }; }
+		constexpr T dot(const Vec3& rhs) const { return x * rhs.x + y * rhs.y + z * rhs.z; }
 
-		Vec3 operator-() const { return Vec3(-x, -y, -z); }
+		constexpr Vec3 operator-() const { return Vec3(-x, -y, -z); }
 
-		Vec3 operator+(const Vec3& rhs) const { return Vec3{ x + rhs.x, y + rhs.y, z + rhs.z }; }
-		Vec3 operator-(const Vec3& rhs) const { return Vec3{ x - rhs.x, y - rhs.y, z - rhs.z }; }
-		Vec3 operator*(const Vec3& rhs) const { return Vec3{ x * rhs.x, y * rhs.y, z * rhs.z }; }
-		Vec3 operator/(const Vec3& rhs) const { return Vec3{ x / rhs.x, y / rhs.y, z / rhs.z }; }
+		constexpr Vec3 operator+(const Vec3& rhs) const { return Vec3{ x + rhs.x, y + rhs.y, z + rhs.z }; }
+		constexpr Vec3 operator-(const Vec3& rhs) const { return Vec3{ x - rhs.x, y - rhs.y, z - rhs.z }; }
+		constexpr Vec3 operator*(const Vec3& rhs) const { return Vec3{ x * rhs.x, y * rhs.y, z * rhs.z }; }
+		constexpr Vec3 operator/(const Vec3& rhs) const { return Vec3{ x / rhs.x, y / rhs.y, z / rhs.z }; }
 
-		Vec3 operator+(const T rhs) const { return Vec3{ x + rhs, y + rhs, z + rhs }; }
-		Vec3 operator-(const T rhs) const { return Vec3{ x - rhs, y - rhs, z - rhs }; }
-		Vec3 operator*(const T rhs) const { return Vec3{ x * rhs, y * rhs, z * rhs }; }
-		Vec3 operator/(const T rhs) const { return Vec3{ x / rhs, y / rhs, z / rhs }; }
+		constexpr Vec3 operator+(const T rhs) const { return Vec3{ x + rhs, y + rhs, z + rhs }; }
+		constexpr Vec3 operator-(const T rhs) const { return Vec3{ x - rhs, y - rhs, z - rhs }; }
+		constexpr Vec3 operator*(const T rhs) const { return Vec3{ x * rhs, y * rhs, z * rhs }; }
+		constexpr Vec3 operator/(const T rhs) const { return Vec3{ x / rhs, y / rhs, z / rhs }; }
 
-		Vec3& operator+=(const Vec3& rhs) { x += rhs.x; y += rhs.y; z += rhs.z; return *this; }
-		Vec3& operator-=(const Vec3& rhs) { x -= rhs.x; y -= rhs.y; z -= rhs.z; return *this; }
-		Vec3& operator*=(const Vec3& rhs) { x *= rhs.x; y *= rhs.y; z *= rhs.z; return *this; }
-		Vec3& operator/=(const Vec3& rhs) { x /= rhs.x; y /= rhs.y; z /= rhs.z; return *this; }
+		constexpr Vec3& operator+=(const Vec3& rhs) { x += rhs.x; y += rhs.y; z += rhs.z; return *this; }
+		constexpr Vec3& operator-=(const Vec3& rhs) { x -= rhs.x; y -= rhs.y; z -= rhs.z; return *this; }
+		constexpr Vec3& operator*=(const Vec3& rhs) { x *= rhs.x; y *= rhs.y; z *= rhs.z; return *this; }
+		constexpr Vec3& operator/=(const Vec3& rhs) { x /= rhs.x; y /= rhs.y; z /= rhs.z; return *this; }
 
-		Vec3& operator+=(const T rhs) { x += rhs; y += rhs; z += rhs; return *this; }
-		Vec3& operator*=(const T rhs) { x *= rhs; y *= rhs; z *= rhs; return *this; }
-		Vec3& operator-=(const T rhs) { x -= rhs; y -= rhs; z -= rhs; return *this; }
-		Vec3& operator/=(const T rhs) { x /= rhs; y /= rhs; z /= rhs; return *this; }
+		constexpr Vec3& operator+=(const T rhs) { x += rhs; y += rhs; z += rhs; return *this; }
+		constexpr Vec3& operator*=(const T rhs) { x *= rhs; y *= rhs; z *= rhs; return *this; }
+		constexpr Vec3& operator-=(const T rhs) { x -= rhs; y -= rhs; z -= rhs; return *this; }
+		constexpr Vec3& operator/=(const T rhs) { x /= rhs; y /= rhs; z /= rhs; return *this; }
 
-		bool operator==(const Vec3& rhs) const { return x == rhs.x && y == rhs.y && z == rhs.z; }
-		bool operator!=(const Vec3& rhs) const { return !(*this == rhs); }
+		constexpr bool operator==(const Vec3& rhs) const { return x == rhs.x && y == rhs.y && z == rhs.z; }
+		constexpr bool operator!=(const Vec3& rhs) const { return !(*this == rhs); }
 
 		friend std::ostream& operator<<(std::ostream& os, const Vec3& v) { return os << v.x << ' ' << v.y << ' ' << v.z; }
 	};
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "vec3.hpp"
+#include "constexpr_math.hpp"
+#include "scalar_traits.hpp"
 
 #include <cmath>
+#include <limits>
 #include <type_traits>
 #include <ostream>
 
@@ -23,48 +26,64 @@ namespace Starlet::Math {
 		constexpr Vec4(T v) : x(v), y(v), z(v), w(v) {}
 		constexpr Vec4(T xIn, T yIn, T zIn, T wIn) : x(xIn), y(yIn), z(zIn), w(wIn) {}
 		constexpr Vec4(const Vec3<T>& v, T wIn) : x(v.x), y(v.y), z(v.z), w(wIn) {}
-		constexpr Vec4(const Vec4<T>& v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
+		constexpr Vec4(const Vec4<T>& v) = default;
 
-		Vec4& operator=(const Vec4& other) = default;
+		constexpr Vec4& operator=(const Vec4& other) = default;
 
-		double length() const { return std::sqrt(static_cast<double>(x) * x + static_cast<double>(y) * y + static_cast<double>(z) * z + static_cast<double>(w) * w); }
-		double lengthSquared() const { return static_cast<double>(x) * x + static_cast<double>(y) * y + static_cast<double>(z) * z + static_cast<double>(w) * w; }
+		constexpr LengthType<T> length() const {
+			const LengthType<T> lenSq = lengthSquared();
+			// Components past ~1.8e19 overflow a float lengthSquared(), measure a rescaled copy instead
+			if constexpr (std::is_floating_point_v<T>) {
+				if (lenSq > std::numeric_limits<T>::max()) {
+					const T scale = Detail::maxAbs(x, y, z, w);
+					if (scale <= std::numeric_limits<T>::max()) return scale * (*this / scale).length();
+				}
+			}
+			return Cx::sqrt(lenSq);
+		}
+		constexpr LengthType<T> lengthSquared() const { return static_cast<LengthType<T>>(x) * x + static_cast<LengthType<T>>(y) * y + static_cast<LengthType<T>>(z) * z + static_cast<LengthType<T>>(w) * w; }
 
-		Vec4<double> normalized() const requires std::is_integral_v<T> {
+		constexpr Vec4<double> normalized() const requires std::is_integral_v<T> {
 			double len = length();
 			return (len < 1e-6) ? Vec4<double>(0.0) : Vec4<double>(x / len, y / len, z / len, w / len);
 		}
-		Vec4<T> normalized() const requires std::is_floating_point_v<T> {
-			T len = static_cast<T>(length());
-			return (len < 1e-6) ? Vec4<T>(T(0)) : Vec4<T>(x / len, y / len, z / len, w / len);
+		constexpr Vec4<T> normalized() const requires std::is_floating_point_v<T> {
+			const T lenSq = lengthSquared();
+			if (lenSq < T(1e-12)) return Vec4<T>(T(0));
+			if (lenSq > std::numeric_limits<T>::max()) {
+				const T scale = Detail::maxAbs(x, y, z, w);
+				if (scale <= std::numeric_limits<T>::max()) return (*this / scale).normalized();
+			}
+			const T inv = T(1) / Cx::sqrt(lenSq);
+			return Vec4<T>(x * inv, y * inv, z * inv, w * inv);
 		}
 
-		T dot(const Vec4& rhs) const { return x * rhs.x + y * rhs.y + z * rhs.z + w * rhs.w; }
+		constexpr T dot(const Vec4& rhs) const { return x * rhs.x + y * rhs.y + z * rhs.z + w * rhs.w; }
 
-		Vec4 operator-() const { return Vec4(-x, -y, -z, -w); }
+		constexpr Vec4 operator-() const { return Vec4(-x, -y, -z, -w); }
 
-		Vec4 operator+(const Vec4& rhs) const { return { x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w }; }
-		Vec4 operator-(const Vec4& rhs) const { return { x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w }; }
-		Vec4 operator*(const Vec4& rhs) const { return { x * rhs.x, y * rhs.y, z * rhs.z, w * rhs.w }; }
-		Vec4 operator/(const Vec4& rhs) const { return { x / rhs.x, y / rhs.y, z / rhs.z, w / rhs.w }; }
+		constexpr Vec4 operator+(const Vec4& rhs) const { return { x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w }; }
+		constexpr Vec4 operator-(const Vec4& rhs) const { return { x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w }; }
+		constexpr Vec4 operator*(const Vec4& rhs) const { return { x * rhs.x, y * rhs.y, z * rhs.z, w * rhs.w }; }
+		constexpr Vec4 operator/(const Vec4& rhs) const { return { x / rhs.x, y / rhs.y, z / rhs.z, w / rhs.w }; }
 
-		Vec4 operator+(const T rhs) const { return { x + rhs, y + rhs, z + rhs, w + rhs }; }
-		Vec4 operator-(const T rhs) const { return { x - rhs, y - rhs, z - rhs, w - rhs }; }
-		Vec4 operator*(const T rhs) const { return { x * rhs, y * rhs, z * rhs, w * rhs }; }
-		Vec4 operator/(const T rhs) const { return { x / rhs, y / rhs, z / rhs, w / rhs }; }
+		constexpr Vec4 operator+(const T rhs) const { return { x + rhs, y + rhs, z + rhs, w + rhs }; }
+		constexpr Vec4 operator-(const T rhs) const { return { x - rhs, y - rhs, z - rhs, w - rhs }; }
+		constexpr Vec4 operator*(const T rhs) const { return { x * rhs, y * rhs, z * rhs, w * rhs }; }
+		constexpr Vec4 operator/(const T rhs) const { return { x / rhs, y / rhs, z / rhs, w / rhs }; }
 
-		Vec4& operator+=(const Vec4& rhs) { x += rhs.x, y += rhs.y, z += rhs.z, w += rhs.w; return *this; }
-		Vec4& operator-=(const Vec4& rhs) { x -= rhs.x, y -= rhs.y, z -= rhs.z, w -= rhs.w; return *this; }
-		Vec4& operator*=(const Vec4& rhs) { x *= rhs.x, y *= rhs.y, z *= rhs.z, w *= rhs.w; return *this; }
-		Vec4& operator/=(const Vec4& rhs) { x /= rhs.x, y /= rhs.y, z /= rhs.z, w /= rhs.w; return *this; }
+		constexpr Vec4& operator+=(const Vec4& rhs) { x += rhs.x, y += rhs.y, z += rhs.z, w += rhs.w; return *this; }
+		constexpr Vec4& operator-=(const Vec4& rhs) { x -= rhs.x, y -= rhs.y, z -= rhs.z, w -= rhs.w; return *this; }
+		constexpr Vec4& operator*=(const Vec4& rhs) { x *= rhs.x, y *= rhs.y, z *= rhs.z, w *= rhs.w; return *this; }
+		constexpr Vec4& operator/=(const Vec4& rhs) { x /= rhs.x, y /= rhs.y, z /= rhs.z, w /= rhs.w; return *this; }
 
-		Vec4& operator+=(const T rhs) { x += rhs, y += rhs, z += rhs, w += rhs; return *this; }
-		Vec4& operator-=(const T rhs) { x -= rhs, y -= rhs, z -= rhs, w -= rhs; return *this; }
-		Vec4& operator*=(const T rhs) { x *= rhs, y *= rhs, z *= rhs, w *= rhs; return *this; }
-		Vec4& operator/=(const T rhs) { x /= rhs, y /= rhs, z /= rhs, w /= rhs; return *this; }
+		constexpr Vec4& operator+=(const T rhs) { x += rhs, y += rhs, z += rhs, w += rhs; return *this; }
+		constexpr Vec4& operator-=(const T rhs) { x -= rhs, y -= rhs, z -= rhs, w -= rhs; return *this; }
+		constexpr Vec4& operator*=(const T rhs) { x *= rhs, y *= rhs, z *= rhs, w *= rhs; return *this; }
+		constexpr Vec4& operator/=(const T rhs) { x /= rhs, y /= rhs, z /= rhs, w /= rhs; return *this; }
 
-		bool operator==(const Vec4& rhs) { return x == rhs.x && y == rhs.y && z == rhs.z && w == rhs.w; }
-		bool operator!=(const Vec4& rhs) { return !(*this == rhs); }
+		constexpr bool operator==(const Vec4& rhs) const { return x == rhs.x && y == rhs.y && z == rhs.z && w == rhs.w; }
+		constexpr bool operator!=(const Vec4& rhs) const { return !(*this == rhs); }
 
 		friend std::ostream& operator<<(std::ostream& os, const Vec4& v) { return os << v.x << ' ' << v.y << ' ' << v.z << ' ' << v.w; }
 	};
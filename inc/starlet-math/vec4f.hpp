@@ -0,0 +1,112 @@
+#pragma once
+
+#include "simd.hpp"
+#include "vec3.hpp"
+#include "vec4.hpp"
+
+#include <ostream>
+
+namespace Starlet::Math {
+  /*
+  Vec4f
+  * 16-byte aligned float x, y, z, w held in one SIMD register
+  * Register-resident counterpart of Vec4<float>, which stays a plain packed struct for vertex layouts
+  * Converts implicitly to and from Vec4<float>
+  */
+  struct alignas(16) Vec4f {
+    Simd::Float4 v;
+
+    Vec4f() : v(Simd::Float4::splat(0.0f)) {}
+    explicit Vec4f(const float s) : v(Simd::Float4::splat(s)) {}
+    Vec4f(const float x, const float y, const float z, const float w) : v(Simd::Float4::set(x, y, z, w)) {}
+    Vec4f(const Vec3<float>& xyz, const float w) : v(Simd::Float4::set(xyz.x, xyz.y, xyz.z, w)) {}
+    Vec4f(const Vec4<float>& other) : v(Simd::Float4::load(&other.x)) {}
+    Vec4f(const Simd::Float4& f) : v(f) {}
+
+    operator Vec4<float>() const {
+      Vec4<float> result;
+      v.store(&result.x);
+      return result;
+    }
+
+    static Vec4f load(const float* p) { return { Simd::Float4::load(p) }; }
+    // p must be 16-byte aligned
+    static Vec4f loadAligned(const float* p) { return { Simd::Float4::loadAligned(p) }; }
+    void store(float* p) const { v.store(p); }
+    void storeAligned(float* p) const { v.storeAligned(p); }
+
+    float x() const { return v.lane(0); }
+    float y() const { return v.lane(1); }
+    float z() const { return v.lane(2); }
+    float w() const { return v.lane(3); }
+    Vec3<float> xyz() const {
+      alignas(16) float out[4];
+      v.storeAligned(out);
+      return { out[0], out[1], out[2] };
+    }
+
+    // Lane indices 0-3 pick from x, y, z, w, e.g. swizzle<2, 1, 0, 3>() is zyxw
+    template<int X, int Y, int Z, int W>
+    Vec4f swizzle() const {
+      static_assert(X >= 0 && X < 4 && Y >= 0 && Y < 4 && Z >= 0 && Z < 4 && W >= 0 && W < 4, "swizzle lanes must be 0-3");
+#ifdef STARLET_MATH_SSE
+      return { Simd::Float4{ _mm_shuffle_ps(v.v, v.v, _MM_SHUFFLE(W, Z, Y, X)) } };
+#else
+      return { Simd::Float4::set(v.v[X], v.v[Y], v.v[Z], v.v[W]) };
+#endif
+    }
+    // The same component in all four lanes
+    template<int I>
+    Vec4f broadcast() const { return swizzle<I, I, I, I>(); }
+
+    // Dot product splatted across all four lanes, keeps chained math in registers
+    Vec4f dot4(const Vec4f& rhs) const {
+      const Vec4f p{ v * rhs.v };
+      const Vec4f s{ p.v + p.swizzle<1, 0, 3, 2>().v };
+      return { s.v + s.swizzle<2, 3, 0, 1>().v };
+    }
+    float dot(const Vec4f& rhs) const { return dot4(rhs).x(); }
+
+    float lengthSquared() const { return dot(*this); }
+    float length() const { return Simd::sqrt(dot4(*this).v).lane(0); }
+
+    // Same zero-length cutoff as Vec4<float>::normalized
+    Vec4f normalized() const {
+      const Simd::Float4 lenSq = dot4(*this).v;
+      if (lenSq.lane(0) < 1e-12f) return Vec4f();
+      return { v * (Simd::Float4::splat(1.0f) / Simd::sqrt(lenSq)) };
+    }
+
+    Vec4f operator-() const { return { -v }; }
+
+    Vec4f operator+(const Vec4f& rhs) const { return { v + rhs.v }; }
+    Vec4f operator-(const Vec4f& rhs) const { return { v - rhs.v }; }
+    Vec4f operator*(const Vec4f& rhs) const { return { v * rhs.v }; }
+    Vec4f operator/(const Vec4f& rhs) const { return { v / rhs.v }; }
+
+    Vec4f operator+(const float rhs) const { return { v + Simd::Float4::splat(rhs) }; }
+    Vec4f operator-(const float rhs) const { return { v - Simd::Float4::splat(rhs) }; }
+    Vec4f operator*(const float rhs) const { return { v * Simd::Float4::splat(rhs) }; }
+    Vec4f operator/(const float rhs) const { return { v / Simd::Float4::splat(rhs) }; }
+
+    Vec4f& operator+=(const Vec4f& rhs) { v = v + rhs.v; return *this; }
+    Vec4f& operator-=(const Vec4f& rhs) { v = v - rhs.v; return *this; }
+    Vec4f& operator*=(const Vec4f& rhs) { v = v * rhs.v; return *this; }
+    Vec4f& operator/=(const Vec4f& rhs) { v = v / rhs.v; return *this; }
+
+    Vec4f& operator+=(const float rhs) { v = v + Simd::Float4::splat(rhs); return *this; }
+    Vec4f& operator-=(const float rhs) { v = v - Simd::Float4::splat(rhs); return *this; }
+    Vec4f& operator*=(const float rhs) { v = v * Simd::Float4::splat(rhs); return *this; }
+    Vec4f& operator/=(const float rhs) { v = v / Simd::Float4::splat(rhs); return *this; }
+
+    bool operator==(const Vec4f& rhs) const { return Simd::moveMask(v == rhs.v) == 0xF; }
+    bool operator!=(const Vec4f& rhs) const { return !(*this == rhs); }
+
+    friend std::ostream& operator<<(std::ostream& os, const Vec4f& a) { return os << a.x() << ' ' << a.y() << ' ' << a.z() << ' ' << a.w(); }
+  };
+
+  inline Vec4f min(const Vec4f& a, const Vec4f& b) { return { Simd::min(a.v, b.v) }; }
+  inline Vec4f max(const Vec4f& a, const Vec4f& b) { return { Simd::max(a.v, b.v) }; }
+  // a * b + c
+  inline Vec4f madd(const Vec4f& a, const Vec4f& b, const Vec4f& c) { return { Simd::madd(a.v, b.v, c.v) }; }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "simd.hpp"
+#include "vec3.hpp"
+#include "vec4.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <span>
+
+namespace Starlet::Math {
+  static_assert(sizeof(Vec3<float>) == 12, "bulk Vec3 kernels assume tightly packed xyz floats");
+  static_assert(sizeof(Vec4<float>) == 16, "bulk Vec4 kernels assume tightly packed xyzw floats");
+
+  // Deviation from the scalar Vec3/Vec4 results when the compiler contracts the lane math into FMAs, zero otherwise
+  // Relative error of lengthAll against length()
+  constexpr float LENGTH_ALL_MAX_REL_ERROR = 2.5e-7f;
+  // Absolute error per component of normalizeAll against normalized()
+  constexpr float NORMALIZE_ALL_MAX_ERROR = 4e-7f;
+
+  namespace Detail {
+    // 1 / sqrt(lenSq), zero where the vector is below the Vec::normalized cutoff
+    inline Simd::Float4 invLengthOrZero(const Simd::Float4& lenSq) {
+      using Simd::Float4;
+      const Float4 degenerate = lenSq < Float4::splat(1e-12f);
+      const Float4 inv = Float4::splat(1.0f) / Simd::sqrt(Simd::select(degenerate, Float4::splat(1.0f), lenSq));
+      return Simd::select(degenerate, Float4::splat(0.0f), inv);
+    }
+    // Any lane whose float lengthSquared() overflowed, those groups go through the rescaling scalar path
+    inline bool anyOverflow(const Simd::Float4& lenSq) {
+      return Simd::moveMask(lenSq > Simd::Float4::splat(std::numeric_limits<float>::max())) != 0;
+    }
+  }
+
+  /*
+  Bulk vector kernels
+  * Four vectors per pass, deinterleaved so each SIMD lane holds one vector
+  * Results agree with Vec3/Vec4 length() and normalized() to within the error constants above
+  * in and out may be the same span
+  */
+  inline void lengthAll(std::span<const Vec3<float>> v, std::span<float> out) {
+    assert(v.size() == out.size());
+
+    size_t i = 0;
+    for (; i + 4 <= v.size(); i += 4) {
+      Simd::Float4 x, y, z;
+      Simd::loadXYZ4(&v[i].x, x, y, z);
+      const Simd::Float4 lenSq = x * x + y * y + z * z;
+      if (Detail::anyOverflow(lenSq)) {
+        for (size_t j = i; j < i + 4; ++j) out[j] = v[j].length();
+        continue;
+      }
+      Simd::sqrt(lenSq).store(&out[i]);
+    }
+    for (; i < v.size(); ++i) out[i] = v[i].length();
+  }
+  inline void lengthAll(std::span<const Vec4<float>> v, std::span<float> out) {
+    assert(v.size() == out.size());
+
+    size_t i = 0;
+    for (; i + 4 <= v.size(); i += 4) {
+      Simd::Float4 x = Simd::Float4::load(&v[i].x), y = Simd::Float4::load(&v[i + 1].x);
+      Simd::Float4 z = Simd::Float4::load(&v[i + 2].x), w = Simd::Float4::load(&v[i + 3].x);
+      Simd::transpose(x, y, z, w);
+      const Simd::Float4 lenSq = x * x + y * y + z * z + w * w;
+      if (Detail::anyOverflow(lenSq)) {
+        for (size_t j = i; j < i + 4; ++j) out[j] = v[j].length();
+        continue;
+      }
+      Simd::sqrt(lenSq).store(&out[i]);
+    }
+    for (; i < v.size(); ++i) out[i] = v[i].length();
+  }
+
+  inline void normalizeAll(std::span<const Vec3<float>> in, std::span<Vec3<float>> out) {
+    assert(in.size() == out.size());
+
+    size_t i = 0;
+    for (; i + 4 <= in.size(); i += 4) {
+      Simd::Float4 x, y, z;
+      Simd::loadXYZ4(&in[i].x, x, y, z);
+      const Simd::Float4 lenSq = x * x + y * y + z * z;
+      if (Detail::anyOverflow(lenSq)) {
+        for (size_t j = i; j < i + 4; ++j) out[j] = in[j].normalized();
+        continue;
+      }
+      const Simd::Float4 inv = Detail::invLengthOrZero(lenSq);
+      Simd::storeXYZ4(&out[i].x, x * inv, y * inv, z * inv);
+    }
+    for (; i < in.size(); ++i) out[i] = in[i].normalized();
+  }
+  inline void normalizeAll(std::span<Vec3<float>> v) { normalizeAll(std::span<const Vec3<float>>(v), v); }
+
+  inline void normalizeAll(std::span<const Vec4<float>> in, std::span<Vec4<float>> out) {
+    assert(in.size() == out.size());
+
+    size_t i = 0;
+    for (; i + 4 <= in.size(); i += 4) {
+      Simd::Float4 x = Simd::Float4::load(&in[i].x), y = Simd::Float4::load(&in[i + 1].x);
+      Simd::Float4 z = Simd::Float4::load(&in[i + 2].x), w = Simd::Float4::load(&in[i + 3].x);
+      Simd::transpose(x, y, z, w);
+
+      const Simd::Float4 lenSq = x * x + y * y + z * z + w * w;
+      if (Detail::anyOverflow(lenSq)) {
+        for (size_t j = i; j < i + 4; ++j) out[j] = in[j].normalized();
+        continue;
+      }
+      const Simd::Float4 inv = Detail::invLengthOrZero(lenSq);
+      x = x * inv; y = y * inv; z = z * inv; w = w * inv;
+
+      Simd::transpose(x, y, z, w);
+      x.store(&out[i].x); y.store(&out[i + 1].x); z.store(&out[i + 2].x); w.store(&out[i + 3].x);
+    }
+    for (; i < in.size(); ++i) out[i] = in[i].normalized();
+  }
+  inline void normalizeAll(std::span<Vec4<float>> v) { normalizeAll(std::span<const Vec4<float>>(v), v); }
+}
@@ -0,0 +1,287 @@
+#pragma once
+
+#include "simd.hpp"
+#include "vec2.hpp"
+#include "vec3.hpp"
+#include "vec4.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace Starlet::Math::Expr {
+  /*
+  Expr
+  * Opt-in expression templates over Vec2/Vec3/Vec4 and spans of them, the plain operators are untouched
+  * Start an expression with lazy(), finish it with eval() for one vector or assign() for arrays:
+      Vec3<float> r = Expr::eval(Expr::lazy(a) + b * s - c / d);
+      Expr::assign(out, Expr::lazy(positions) * dt + velocities);
+  * Nothing is computed until eval/assign, which walks the whole tree once per component
+  * x * y + z (and x * y - z, z - x * y) become one fused multiply-add when the target has FMA,
+    so results can differ from the plain operators in the last bit
+  * Once one side is an expression, plain vectors, scalars and std::vector/std::span arrays join it directly
+  * Operands are held by value (arrays as spans), so an expression can be stored and evaluated later while its arrays live
+  */
+
+  template<typename V> struct VecTraits;
+  template<typename T> struct VecTraits<Vec2<T>> { using Scalar = T; static constexpr size_t Size = 2; };
+  template<typename T> struct VecTraits<Vec3<T>> { using Scalar = T; static constexpr size_t Size = 3; };
+  template<typename T> struct VecTraits<Vec4<T>> { using Scalar = T; static constexpr size_t Size = 4; };
+
+  template<typename T, size_t N> struct VecOfImpl;
+  template<typename T> struct VecOfImpl<T, 2> { using Type = Vec2<T>; };
+  template<typename T> struct VecOfImpl<T, 3> { using Type = Vec3<T>; };
+  template<typename T> struct VecOfImpl<T, 4> { using Type = Vec4<T>; };
+  template<typename T, size_t N> using VecOf = typename VecOfImpl<T, N>::Type;
+
+  template<typename E> concept Node = requires { typename E::IsExprNode; };
+  template<typename V> concept Vector = requires { VecTraits<V>::Size; };
+
+  /*
+  Node interface
+  * Scalar, Size (components, 0 for a broadcast scalar)
+  * IsArray when a span is involved, IsFlat when every leaf can be read as one flat run of scalars
+  * at(i, c) is component c of element i, flat(k) and lanes(k) read flat scalar k (lanes: k to k + 3, float only)
+  */
+  namespace Detail {
+    template<typename T>
+    inline T fusedMulAdd(const T a, const T b, const T c) {
+#ifdef __FMA__
+      return std::fma(a, b, c);
+#else
+      return a * b + c;
+#endif
+    }
+
+    inline constexpr size_t count(const size_t a, const size_t b) {
+      assert(a == 0 || b == 0 || a == b);
+      return std::max(a, b);
+    }
+  }
+
+  template<typename T>
+  struct ScalarNode {
+    using IsExprNode = void;
+    using Scalar = T;
+    static constexpr size_t Size = 0;
+    static constexpr bool IsArray = false, IsFlat = true;
+
+    T value;
+
+    size_t count() const { return 0; }
+    T at(size_t, size_t) const { return value; }
+    T flat(size_t) const { return value; }
+    Simd::Float4 lanes(size_t) const { return Simd::Float4::splat(value); }
+  };
+
+  template<typename V>
+  struct VecNode {
+    using IsExprNode = void;
+    using Scalar = typename VecTraits<V>::Scalar;
+    static constexpr size_t Size = VecTraits<V>::Size;
+    static constexpr bool IsArray = false, IsFlat = false;
+
+    V value;
+
+    size_t count() const { return 0; }
+    Scalar at(size_t, const size_t c) const { return (&value.x)[c]; }
+  };
+
+  template<typename V>
+  struct SpanNode {
+    using IsExprNode = void;
+    using Scalar = typename VecTraits<V>::Scalar;
+    static constexpr size_t Size = VecTraits<V>::Size;
+    static constexpr bool IsArray = true, IsFlat = true;
+    static_assert(sizeof(V) == Size * sizeof(Scalar), "span expressions read vectors as packed scalars");
+
+    std::span<const V> values;
+
+    size_t count() const { return values.size(); }
+    Scalar at(const size_t i, const size_t c) const { return (&values[i].x)[c]; }
+    Scalar flat(const size_t k) const { return (&values.data()->x)[k]; }
+    Simd::Float4 lanes(const size_t k) const { return Simd::Float4::load(&values.data()->x + k); }
+  };
+
+  struct Add { template<typename T> static T apply(const T& a, const T& b) { return a + b; } };
+  struct Sub { template<typename T> static T apply(const T& a, const T& b) { return a - b; } };
+  struct Mul { template<typename T> static T apply(const T& a, const T& b) { return a * b; } };
+  struct Div { template<typename T> static T apply(const T& a, const T& b) { return a / b; } };
+
+  template<typename Op, typename L, typename R>
+  struct Binary {
+    using IsExprNode = void;
+    using Scalar = std::conditional_t<L::Size != 0, typename L::Scalar, typename R::Scalar>;
+    static constexpr size_t Size = std::max(L::Size, R::Size);
+    static constexpr bool IsArray = L::IsArray || R::IsArray, IsFlat = L::IsFlat && R::IsFlat;
+    static_assert(L::Size == 0 || R::Size == 0 || L::Size == R::Size, "vector sizes differ");
+    static_assert(std::is_same_v<typename L::Scalar, typename R::Scalar>, "scalar types differ");
+
+    L l;
+    R r;
+
+    size_t count() const { return Detail::count(l.count(), r.count()); }
+    Scalar at(const size_t i, const size_t c) const { return Op::apply(l.at(i, c), r.at(i, c)); }
+    Scalar flat(const size_t k) const { return Op::apply(l.flat(k), r.flat(k)); }
+    Simd::Float4 lanes(const size_t k) const { return Op::apply(l.lanes(k), r.lanes(k)); }
+  };
+
+  // a * b + c
+  template<typename A, typename B, typename C>
+  struct FusedMulAdd {
+    using IsExprNode = void;
+    using Scalar = typename Binary<Mul, A, B>::Scalar;
+    static constexpr size_t Size = std::max({ A::Size, B::Size, C::Size });
+    static constexpr bool IsArray = A::IsArray || B::IsArray || C::IsArray, IsFlat = A::IsFlat && B::IsFlat && C::IsFlat;
+    static_assert(C::Size == 0 || Size == 0 || C::Size == Size, "vector sizes differ");
+    static_assert(std::is_same_v<Scalar, typename C::Scalar>, "scalar types differ");
+
+    A a;
+    B b;
+    C c;
+
+    size_t count() const { return Detail::count(Detail::count(a.count(), b.count()), c.count()); }
+    Scalar at(const size_t i, const size_t n) const { return Detail::fusedMulAdd(a.at(i, n), b.at(i, n), c.at(i, n)); }
+    Scalar flat(const size_t k) const { return Detail::fusedMulAdd(a.flat(k), b.flat(k), c.flat(k)); }
+    Simd::Float4 lanes(const size_t k) const { return Simd::madd(a.lanes(k), b.lanes(k), c.lanes(k)); }
+  };
+
+  template<typename E>
+  struct Negate {
+    using IsExprNode = void;
+    using Scalar = typename E::Scalar;
+    static constexpr size_t Size = E::Size;
+    static constexpr bool IsArray = E::IsArray, IsFlat = E::IsFlat;
+
+    E e;
+
+    size_t count() const { return e.count(); }
+    Scalar at(const size_t i, const size_t c) const { return -e.at(i, c); }
+    Scalar flat(const size_t k) const { return -e.flat(k); }
+    Simd::Float4 lanes(const size_t k) const { return -e.lanes(k); }
+  };
+
+  template<typename V> requires Vector<V>
+  VecNode<V> lazy(const V& v) { return { v }; }
+  template<typename V> requires Vector<V>
+  SpanNode<V> lazy(std::span<const V> v) { return { v }; }
+  template<typename V> requires Vector<V>
+  SpanNode<V> lazy(std::span<V> v) { return { v }; }
+  template<typename V> requires Vector<V>
+  SpanNode<V> lazy(const std::vector<V>& v) { return { v }; }
+
+  namespace Detail {
+    template<typename E> struct IsMul : std::false_type {};
+    template<typename L, typename R> struct IsMul<Binary<Mul, L, R>> : std::true_type {};
+
+    // std::vector or std::span of vectors, read through a SpanNode once an expression has started
+    template<typename X> struct ArrayElement { using Type = void; };
+    template<typename V, typename A> struct ArrayElement<std::vector<V, A>> { using Type = V; };
+    template<typename V, size_t E> struct ArrayElement<std::span<V, E>> { using Type = std::remove_const_t<V>; };
+    template<typename X> concept Array = Vector<typename ArrayElement<X>::Type>;
+
+    template<typename X> struct ScalarOfImpl { using Type = typename VecTraits<X>::Scalar; };
+    template<Node X> struct ScalarOfImpl<X> { using Type = typename X::Scalar; };
+    template<Array X> struct ScalarOfImpl<X> { using Type = typename VecTraits<typename ArrayElement<X>::Type>::Scalar; };
+
+    // Arithmetic operands take the scalar type of the expression side, so 2.0 next to floats stays float
+    template<typename S, typename X>
+    auto wrap(const X& x) {
+      if constexpr (Node<X>) return x;
+      else if constexpr (std::is_arithmetic_v<X>) return ScalarNode<S>{ static_cast<S>(x) };
+      else if constexpr (Array<X>) return SpanNode<typename ArrayElement<X>::Type>{ x };
+      else return VecNode<X>{ x };
+    }
+
+    template<typename L, typename R>
+    using ScalarOf = typename ScalarOfImpl<std::conditional_t<std::is_arithmetic_v<L>, R, L>>::Type;
+
+    template<typename L, typename R>
+    auto add(const L& l, const R& r) {
+      if constexpr (IsMul<L>::value) return FusedMulAdd<decltype(l.l), decltype(l.r), R>{ l.l, l.r, r };
+      else if constexpr (IsMul<R>::value) return FusedMulAdd<decltype(r.l), decltype(r.r), L>{ r.l, r.r, l };
+      else return Binary<Add, L, R>{ l, r };
+    }
+    template<typename L, typename R>
+    auto sub(const L& l, const R& r) {
+      if constexpr (IsMul<L>::value) return FusedMulAdd<decltype(l.l), decltype(l.r), Negate<R>>{ l.l, l.r, { r } };
+      else if constexpr (IsMul<R>::value) return FusedMulAdd<Negate<decltype(r.l)>, decltype(r.r), L>{ { r.l }, r.r, l };
+      else return Binary<Sub, L, R>{ l, r };
+    }
+  }
+
+  template<typename X>
+  concept Operand = Node<X> || Vector<X> || Detail::Array<X> || std::is_arithmetic_v<X>;
+  template<typename L, typename R>
+  concept Operands = (Node<L> || Node<R>) && Operand<L> && Operand<R>;
+
+  template<typename L, typename R> requires Operands<L, R>
+  auto operator+(const L& l, const R& r) {
+    using S = Detail::ScalarOf<L, R>;
+    return Detail::add(Detail::wrap<S>(l), Detail::wrap<S>(r));
+  }
+  template<typename L, typename R> requires Operands<L, R>
+  auto operator-(const L& l, const R& r) {
+    using S = Detail::ScalarOf<L, R>;
+    return Detail::sub(Detail::wrap<S>(l), Detail::wrap<S>(r));
+  }
+  template<typename L, typename R> requires Operands<L, R>
+  auto operator*(const L& l, const R& r) {
+    using S = Detail::ScalarOf<L, R>;
+    auto wl = Detail::wrap<S>(l);
+    auto wr = Detail::wrap<S>(r);
+    return Binary<Mul, decltype(wl), decltype(wr)>{ wl, wr };
+  }
+  template<typename L, typename R> requires Operands<L, R>
+  auto operator/(const L& l, const R& r) {
+    using S = Detail::ScalarOf<L, R>;
+    auto wl = Detail::wrap<S>(l);
+    auto wr = Detail::wrap<S>(r);
+    return Binary<Div, decltype(wl), decltype(wr)>{ wl, wr };
+  }
+  template<Node E>
+  Negate<E> operator-(const E& e) { return { e }; }
+
+  // Evaluates an expression without spans into a vector
+  template<Node E>
+  VecOf<typename E::Scalar, E::Size> eval(const E& e) {
+    static_assert(!E::IsArray, "array expressions need assign()");
+    VecOf<typename E::Scalar, E::Size> out;
+    for (size_t c = 0; c < E::Size; ++c) (&out.x)[c] = e.at(0, c);
+    return out;
+  }
+
+  /*
+  out[i] = e evaluated at element i, in one pass over the arrays
+  * Expressions of spans and scalars run flat over the packed components, four floats per SIMD step
+  * out may be one of the input spans, every element only reads its own inputs
+  */
+  template<typename V, Node E> requires Vector<V>
+  void assign(std::span<V> out, const E& e) {
+    using S = typename VecTraits<V>::Scalar;
+    constexpr size_t N = VecTraits<V>::Size;
+    static_assert(E::Size == N, "expression and output sizes differ");
+    static_assert(std::is_same_v<typename E::Scalar, S>, "expression and output scalar types differ");
+    assert(!E::IsArray || e.count() == out.size());
+
+    if constexpr (E::IsFlat && E::IsArray) {
+      static_assert(sizeof(V) == N * sizeof(S), "flat assignment writes vectors as packed scalars");
+      S* dst = &out.data()->x;
+      const size_t total = out.size() * N;
+      size_t k = 0;
+      if constexpr (std::is_same_v<S, float>)
+        for (; k + 4 <= total; k += 4) e.lanes(k).store(dst + k);
+      for (; k < total; ++k) dst[k] = e.flat(k);
+    }
+    else {
+      for (size_t i = 0; i < out.size(); ++i)
+        for (size_t c = 0; c < N; ++c) (&out[i].x)[c] = e.at(i, c);
+    }
+  }
+  template<typename V, Node E> requires Vector<V>
+  void assign(std::vector<V>& out, const E& e) { assign(std::span<V>(out), e); }
+}
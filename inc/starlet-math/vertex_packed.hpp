@@ -0,0 +1,454 @@
+#pragma once
+
+#include "bounds.hpp"
+#include "simd.hpp"
+#include "vec2.hpp"
+#include "vec3.hpp"
+#include "vec4.hpp"
+#include "vertex.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace Starlet::Math {
+  /*
+  PackedVertex
+  * 24-byte Vertex: float position, RGBA8 colour, octahedral snorm16 normal, half-float UV
+  * col holds r in its lowest byte, so it reads as R8G8B8A8_UNORM on little-endian targets
+  */
+  struct PackedVertex {
+    Vec3<float> pos{ 0.0f };
+    std::uint32_t col{ 0xFFFFFFFFu };
+    std::int16_t norm[2]{};
+    std::uint16_t texCoord[2]{};
+  };
+
+  /*
+  QuantizedVertex
+  * 20-byte PackedVertex with the position stored as unorm16 inside the mesh AABB
+  * Dequantize with bounds.min + pos / 65535 * bounds.extent(), the same AABB must be kept alongside
+  */
+  struct QuantizedVertex {
+    std::uint16_t pos[3]{};
+    std::int16_t norm[2]{};
+    std::uint16_t texCoord[2]{};
+    std::uint16_t pad{ 0 };
+    std::uint32_t col{ 0xFFFFFFFFu };
+  };
+
+  static_assert(sizeof(PackedVertex) == 24, "PackedVertex must stay 24 bytes");
+  static_assert(sizeof(QuantizedVertex) == 20, "QuantizedVertex must stay 20 bytes");
+
+  namespace Packing {
+    // Worst-case errors of a pack/unpack round trip, checked by tests/vertex_packed_test.cpp
+    constexpr float OCT_MAX_ANGLE_ERROR = 8e-5f;   // radians between input and decoded unit normal
+    constexpr float RGBA8_MAX_ERROR = 0.5f / 255.0f;
+    constexpr float HALF_MAX_REL_ERROR = 1.0f / 2048.0f;
+
+    // Round to nearest even, overflow goes to infinity and NaN stays NaN
+    inline std::uint16_t floatToHalf(const float x) {
+      std::uint32_t f = std::bit_cast<std::uint32_t>(x);
+      const std::uint32_t sign = f & 0x80000000u;
+      f ^= sign;
+
+      std::uint32_t h;
+      if (f >= 0x47800000u) h = f > 0x7F800000u ? 0x7E00u : 0x7C00u;
+      else if (f < 0x38800000u) {
+        // Adding 0.5 lines the half denormal mantissa up with the float mantissa and rounds it
+        h = std::bit_cast<std::uint32_t>(std::bit_cast<float>(f) + 0.5f) - 0x3F000000u;
+      }
+      else {
+        const std::uint32_t mantOdd = (f >> 13) & 1u;
+        h = (f + 0xC8000FFFu + mantOdd) >> 13;
+      }
+      return static_cast<std::uint16_t>(h | (sign >> 16));
+    }
+    inline float halfToFloat(const std::uint16_t h) {
+      const std::uint32_t expMant = h & 0x7FFFu;
+      // Rebiasing by 2^112 handles normals and denormals alike
+      std::uint32_t f = std::bit_cast<std::uint32_t>(std::bit_cast<float>(expMant << 13) * 0x1p112f);
+      if (expMant >= 0x7C00u) f |= 0x7F800000u;
+      return std::bit_cast<float>(f | (static_cast<std::uint32_t>(h & 0x8000u) << 16));
+    }
+
+    // Components clamped to [0, 1]
+    inline std::uint32_t packRGBA8(const Vec4<float>& c) {
+      const auto byte = [](const float v) { return static_cast<std::uint32_t>(std::lrint(std::clamp(v, 0.0f, 1.0f) * 255.0f)); };
+      return byte(c.r) | (byte(c.g) << 8) | (byte(c.b) << 16) | (byte(c.a) << 24);
+    }
+    inline Vec4<float> unpackRGBA8(const std::uint32_t c) {
+      constexpr float inv = 1.0f / 255.0f;
+      return { static_cast<float>(c & 0xFFu) * inv, static_cast<float>((c >> 8) & 0xFFu) * inv,
+               static_cast<float>((c >> 16) & 0xFFu) * inv, static_cast<float>(c >> 24) * inv };
+    }
+
+    /*
+    Octahedral normal encoding
+    * Projects the unit sphere onto an octahedron and unfolds it into [-1, 1]^2, stored as snorm16
+    * n need not be normalized, a zero vector encodes as (0, 0) and decodes to +Z
+    */
+    inline void octEncode(const Vec3<float>& n, std::int16_t out[2]) {
+      const float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+      const float inv = l1 > 0.0f ? 1.0f / l1 : 0.0f;
+      float px = n.x * inv, py = n.y * inv;
+      if (n.z < 0.0f) {
+        const float fx = (1.0f - std::abs(py)) * (px >= 0.0f ? 1.0f : -1.0f);
+        const float fy = (1.0f - std::abs(px)) * (py >= 0.0f ? 1.0f : -1.0f);
+        px = fx;
+        py = fy;
+      }
+      out[0] = static_cast<std::int16_t>(std::lrint(std::clamp(px, -1.0f, 1.0f) * 32767.0f));
+      out[1] = static_cast<std::int16_t>(std::lrint(std::clamp(py, -1.0f, 1.0f) * 32767.0f));
+    }
+    inline Vec3<float> octDecode(const std::int16_t in[2]) {
+      constexpr float inv = 1.0f / 32767.0f;
+      float x = std::max(static_cast<float>(in[0]) * inv, -1.0f);
+      float y = std::max(static_cast<float>(in[1]) * inv, -1.0f);
+      const float z = 1.0f - std::abs(x) - std::abs(y);
+      const float t = std::max(-z, 0.0f);
+      x += x >= 0.0f ? -t : t;
+      y += y >= 0.0f ? -t : t;
+      const float invLen = 1.0f / std::sqrt(x * x + y * y + z * z);
+      return { x * invLen, y * invLen, z * invLen };
+    }
+
+    // Maps bounds onto [0, 65535] per axis, flat axes quantize to 0
+    struct PositionQuantizer {
+      Vec3<float> min{ 0.0f };
+      Vec3<float> scale{ 0.0f };     // 65535 / extent
+      Vec3<float> invScale{ 0.0f };  // extent / 65535
+
+      explicit PositionQuantizer(const AABB& bounds) : min(bounds.min) {
+        const Vec3<float> e = bounds.extent();
+        const auto axis = [](const float extent, float& s, float& inv) {
+          s = extent > 0.0f ? 65535.0f / extent : 0.0f;
+          inv = extent > 0.0f ? extent / 65535.0f : 0.0f;
+        };
+        axis(e.x, scale.x, invScale.x);
+        axis(e.y, scale.y, invScale.y);
+        axis(e.z, scale.z, invScale.z);
+      }
+
+      static std::uint16_t quantize(const float p, const float lo, const float s) {
+        return static_cast<std::uint16_t>(std::lrint(std::clamp((p - lo) * s, 0.0f, 65535.0f)));
+      }
+      void encode(const Vec3<float>& p, std::uint16_t out[3]) const {
+        out[0] = quantize(p.x, min.x, scale.x);
+        out[1] = quantize(p.y, min.y, scale.y);
+        out[2] = quantize(p.z, min.z, scale.z);
+      }
+      Vec3<float> decode(const std::uint16_t in[3]) const {
+        return { min.x + static_cast<float>(in[0]) * invScale.x,
+                 min.y + static_cast<float>(in[1]) * invScale.y,
+                 min.z + static_cast<float>(in[2]) * invScale.z };
+      }
+    };
+
+    inline PackedVertex pack(const Vertex& v) {
+      PackedVertex p;
+      p.pos = v.pos;
+      p.col = packRGBA8(v.col);
+      octEncode(v.norm, p.norm);
+      p.texCoord[0] = floatToHalf(v.texCoord.x);
+      p.texCoord[1] = floatToHalf(v.texCoord.y);
+      return p;
+    }
+    inline Vertex unpack(const PackedVertex& p) {
+      Vertex v;
+      v.pos = p.pos;
+      v.col = unpackRGBA8(p.col);
+      v.norm = octDecode(p.norm);
+      v.texCoord = { halfToFloat(p.texCoord[0]), halfToFloat(p.texCoord[1]) };
+      return v;
+    }
+    inline QuantizedVertex pack(const Vertex& v, const PositionQuantizer& q) {
+      QuantizedVertex p;
+      q.encode(v.pos, p.pos);
+      p.col = packRGBA8(v.col);
+      octEncode(v.norm, p.norm);
+      p.texCoord[0] = floatToHalf(v.texCoord.x);
+      p.texCoord[1] = floatToHalf(v.texCoord.y);
+      return p;
+    }
+    inline Vertex unpack(const QuantizedVertex& p, const PositionQuantizer& q) {
+      Vertex v;
+      v.pos = q.decode(p.pos);
+      v.col = unpackRGBA8(p.col);
+      v.norm = octDecode(p.norm);
+      v.texCoord = { halfToFloat(p.texCoord[0]), halfToFloat(p.texCoord[1]) };
+      return v;
+    }
+
+#ifdef STARLET_MATH_SSE
+    namespace Detail {
+      using Simd::Float4;
+
+      // Lane order matches the float order inside Vertex
+      enum Lane { PosX, PosY, PosZ, ColR, ColG, ColB, ColA, NormX, NormY, NormZ, U, V };
+
+      static_assert(sizeof(Vertex) == 12 * sizeof(float), "loadLanes/storeLanes read a Vertex as 12 packed floats");
+
+      // Four vertices are twelve 16-byte chunks, three 4x4 transposes give one register per component
+      inline void loadLanes(const Vertex* v, Float4 (&lanes)[12]) {
+        const float* src = reinterpret_cast<const float*>(v);
+        for (int chunk = 0; chunk < 3; ++chunk) {
+          Float4* l = lanes + chunk * 4;
+          l[0] = Float4::load(src + chunk * 4);
+          l[1] = Float4::load(src + 12 + chunk * 4);
+          l[2] = Float4::load(src + 24 + chunk * 4);
+          l[3] = Float4::load(src + 36 + chunk * 4);
+          Simd::transpose(l[0], l[1], l[2], l[3]);
+        }
+      }
+      inline void storeLanes(Vertex* v, Float4 (&lanes)[12]) {
+        float* dst = reinterpret_cast<float*>(v);
+        for (int chunk = 0; chunk < 3; ++chunk) {
+          Float4* l = lanes + chunk * 4;
+          Simd::transpose(l[0], l[1], l[2], l[3]);
+          l[0].store(dst + chunk * 4);
+          l[1].store(dst + 12 + chunk * 4);
+          l[2].store(dst + 24 + chunk * 4);
+          l[3].store(dst + 36 + chunk * 4);
+        }
+      }
+
+      inline Float4 abs(const Float4& a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+      inline Float4 clamp(const Float4& a, const float lo, const float hi) { return Simd::min(Simd::max(a, Float4::splat(lo)), Float4::splat(hi)); }
+      inline Float4 toFloat(const __m128i a) { return { _mm_cvtepi32_ps(a) }; }
+      // Round to nearest even, like std::lrint
+      inline __m128i toInt(const Float4& a) { return _mm_cvtps_epi32(a.v); }
+
+      inline __m128i floatToHalf(const Float4& x) {
+#ifdef __F16C__
+        // vcvtps2ph keeps the NaN payload, the scalar codec always writes the quiet NaN 0x7E00
+        const __m128i h = _mm_cvtepu16_epi32(_mm_cvtps_ph(x.v, _MM_FROUND_TO_NEAREST_INT));
+        const __m128i nan = _mm_castps_si128(_mm_cmpunord_ps(x.v, x.v));
+        const __m128i canonical = _mm_or_si128(_mm_set1_epi32(0x7E00), _mm_and_si128(h, _mm_set1_epi32(0x8000)));
+        return _mm_or_si128(_mm_andnot_si128(nan, h), _mm_and_si128(nan, canonical));
+#else
+        const __m128i bits = _mm_castps_si128(x.v);
+        const __m128i sign = _mm_and_si128(bits, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+        const __m128i f = _mm_xor_si128(bits, sign);
+
+        const __m128i overflow = _mm_cmpgt_epi32(f, _mm_set1_epi32(0x477FFFFF));
+        const __m128i nan = _mm_cmpgt_epi32(f, _mm_set1_epi32(0x7F800000));
+        const __m128i infNan = _mm_or_si128(_mm_set1_epi32(0x7C00), _mm_and_si128(nan, _mm_set1_epi32(0x0200)));
+
+        const __m128i denormal = _mm_cmplt_epi32(f, _mm_set1_epi32(0x38800000));
+        const __m128i denormalBits = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(f), _mm_set1_ps(0.5f))), _mm_set1_epi32(0x3F000000));
+
+        const __m128i mantOdd = _mm_and_si128(_mm_srli_epi32(f, 13), _mm_set1_epi32(1));
+        const __m128i normalBits = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(f, _mm_set1_epi32(static_cast<int>(0xC8000FFFu))), mantOdd), 13);
+
+        __m128i h = _mm_or_si128(_mm_and_si128(denormal, denormalBits), _mm_andnot_si128(denormal, normalBits));
+        h = _mm_or_si128(_mm_and_si128(overflow, infNan), _mm_andnot_si128(overflow, h));
+        return _mm_or_si128(h, _mm_srli_epi32(sign, 16));
+#endif
+      }
+      // Halves in the low 16 bits of each lane
+      inline Float4 halfToFloat(const __m128i h) {
+#ifdef __F16C__
+        return { _mm_cvtph_ps(_mm_packus_epi32(h, h)) };
+#else
+        const __m128i expMant = _mm_and_si128(h, _mm_set1_epi32(0x7FFF));
+        const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(expMant, 13)), _mm_set1_ps(0x1p112f));
+        const __m128i infNan = _mm_and_si128(_mm_cmpgt_epi32(expMant, _mm_set1_epi32(0x7BFF)), _mm_set1_epi32(0x7F800000));
+        const __m128i sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+        return { _mm_or_ps(scaled, _mm_castsi128_ps(_mm_or_si128(infNan, sign))) };
+#endif
+      }
+
+      inline __m128i packRGBA8(const Float4& r, const Float4& g, const Float4& b, const Float4& a) {
+        const Float4 k = Float4::splat(255.0f);
+        const __m128i ri = toInt(clamp(r, 0.0f, 1.0f) * k), gi = toInt(clamp(g, 0.0f, 1.0f) * k);
+        const __m128i bi = toInt(clamp(b, 0.0f, 1.0f) * k), ai = toInt(clamp(a, 0.0f, 1.0f) * k);
+        return _mm_or_si128(_mm_or_si128(ri, _mm_slli_epi32(gi, 8)), _mm_or_si128(_mm_slli_epi32(bi, 16), _mm_slli_epi32(ai, 24)));
+      }
+      inline void unpackRGBA8(const __m128i c, Float4& r, Float4& g, Float4& b, Float4& a) {
+        const __m128i byte = _mm_set1_epi32(0xFF);
+        const Float4 inv = Float4::splat(1.0f / 255.0f);
+        r = toFloat(_mm_and_si128(c, byte)) * inv;
+        g = toFloat(_mm_and_si128(_mm_srli_epi32(c, 8), byte)) * inv;
+        b = toFloat(_mm_and_si128(_mm_srli_epi32(c, 16), byte)) * inv;
+        a = toFloat(_mm_srli_epi32(c, 24)) * inv;
+      }
+
+      // Packs x into the low and y into the high 16 bits of each lane
+      inline __m128i octEncode(const Float4& nx, const Float4& ny, const Float4& nz) {
+        const Float4 zero = Float4::splat(0.0f), one = Float4::splat(1.0f);
+        const Float4 l1 = abs(nx) + abs(ny) + abs(nz);
+        const Float4 inv = Simd::select(l1 > zero, one / Simd::select(l1 > zero, l1, one), zero);
+        const Float4 px = nx * inv, py = ny * inv;
+
+        const Float4 signX = Simd::select(px >= zero, one, -one), signY = Simd::select(py >= zero, one, -one);
+        const Float4 lower = nz < zero;
+        const Float4 ox = Simd::select(lower, (one - abs(py)) * signX, px);
+        const Float4 oy = Simd::select(lower, (one - abs(px)) * signY, py);
+
+        const Float4 k = Float4::splat(32767.0f);
+        const __m128i x = toInt(clamp(ox, -1.0f, 1.0f) * k), y = toInt(clamp(oy, -1.0f, 1.0f) * k);
+        return _mm_or_si128(_mm_and_si128(x, _mm_set1_epi32(0xFFFF)), _mm_slli_epi32(y, 16));
+      }
+      inline void octDecode(const __m128i packed, Float4& nx, Float4& ny, Float4& nz) {
+        const Float4 inv = Float4::splat(1.0f / 32767.0f), zero = Float4::splat(0.0f), one = Float4::splat(1.0f);
+        Float4 x = Simd::max(toFloat(_mm_srai_epi32(_mm_slli_epi32(packed, 16), 16)) * inv, -one);
+        Float4 y = Simd::max(toFloat(_mm_srai_epi32(packed, 16)) * inv, -one);
+        const Float4 z = one - abs(x) - abs(y);
+        const Float4 t = Simd::max(-z, zero);
+        x = x + Simd::select(x >= zero, -t, t);
+        y = y + Simd::select(y >= zero, -t, t);
+        const Float4 invLen = one / Simd::sqrt(x * x + y * y + z * z);
+        nx = x * invLen;
+        ny = y * invLen;
+        nz = z * invLen;
+      }
+
+      // Colour, normal and UV words of four vertices
+      struct Attributes {
+        alignas(16) std::uint32_t col[4];
+        alignas(16) std::uint32_t norm[4];
+        alignas(16) std::uint32_t texCoord[4];
+      };
+      inline void encodeAttributes(const Float4 (&l)[12], Attributes& out) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(out.col), packRGBA8(l[ColR], l[ColG], l[ColB], l[ColA]));
+        _mm_store_si128(reinterpret_cast<__m128i*>(out.norm), octEncode(l[NormX], l[NormY], l[NormZ]));
+        const __m128i uv = _mm_or_si128(floatToHalf(l[U]), _mm_slli_epi32(floatToHalf(l[V]), 16));
+        _mm_store_si128(reinterpret_cast<__m128i*>(out.texCoord), uv);
+      }
+      inline void decodeAttributes(const Attributes& in, Float4 (&l)[12]) {
+        unpackRGBA8(_mm_load_si128(reinterpret_cast<const __m128i*>(in.col)), l[ColR], l[ColG], l[ColB], l[ColA]);
+        octDecode(_mm_load_si128(reinterpret_cast<const __m128i*>(in.norm)), l[NormX], l[NormY], l[NormZ]);
+        const __m128i uv = _mm_load_si128(reinterpret_cast<const __m128i*>(in.texCoord));
+        l[U] = halfToFloat(_mm_and_si128(uv, _mm_set1_epi32(0xFFFF)));
+        l[V] = halfToFloat(_mm_srli_epi32(uv, 16));
+      }
+
+      // norm and texCoord are two 16-bit halves of one word in both packed layouts
+      template<typename P>
+      inline void storeAttributes(P& p, const Attributes& a, const int k) {
+        p.col = a.col[k];
+        std::memcpy(p.norm, &a.norm[k], 4);
+        std::memcpy(p.texCoord, &a.texCoord[k], 4);
+      }
+      template<typename P>
+      inline void loadAttributes(const P& p, Attributes& a, const int k) {
+        a.col[k] = p.col;
+        std::memcpy(&a.norm[k], p.norm, 4);
+        std::memcpy(&a.texCoord[k], p.texCoord, 4);
+      }
+
+      inline __m128i quantize(const Float4& p, const float lo, const float s) {
+        return toInt(clamp((p - Float4::splat(lo)) * Float4::splat(s), 0.0f, 65535.0f));
+      }
+    }
+#endif
+  }
+
+  /*
+  Bulk vertex packing
+  * Four vertices per pass, transposed so each SIMD lane holds one vertex
+  * Results match Packing::pack / Packing::unpack element for element
+  */
+  inline void packVertices(std::span<const Vertex> in, std::span<PackedVertex> out) {
+    assert(in.size() == out.size());
+
+    size_t i = 0;
+#ifdef STARLET_MATH_SSE
+    using namespace Packing::Detail;
+    for (; i + 4 <= in.size(); i += 4) {
+      Simd::Float4 lanes[12];
+      loadLanes(&in[i], lanes);
+      Attributes a;
+      encodeAttributes(lanes, a);
+      for (int k = 0; k < 4; ++k) {
+        out[i + k].pos = in[i + k].pos;
+        storeAttributes(out[i + k], a, k);
+      }
+    }
+#endif
+    for (; i < in.size(); ++i) out[i] = Packing::pack(in[i]);
+  }
+  inline void unpackVertices(std::span<const PackedVertex> in, std::span<Vertex> out) {
+    assert(in.size() == out.size());
+
+    size_t i = 0;
+#ifdef STARLET_MATH_SSE
+    using namespace Packing::Detail;
+    for (; i + 4 <= in.size(); i += 4) {
+      Attributes a;
+      for (int k = 0; k < 4; ++k) loadAttributes(in[i + k], a, k);
+
+      Simd::Float4 lanes[12];
+      lanes[PosX] = Simd::Float4::set(in[i].pos.x, in[i + 1].pos.x, in[i + 2].pos.x, in[i + 3].pos.x);
+      lanes[PosY] = Simd::Float4::set(in[i].pos.y, in[i + 1].pos.y, in[i + 2].pos.y, in[i + 3].pos.y);
+      lanes[PosZ] = Simd::Float4::set(in[i].pos.z, in[i + 1].pos.z, in[i + 2].pos.z, in[i + 3].pos.z);
+      decodeAttributes(a, lanes);
+      storeLanes(&out[i], lanes);
+    }
+#endif
+    for (; i < in.size(); ++i) out[i] = Packing::unpack(in[i]);
+  }
+
+  // bounds should enclose every position, e.g. AABB::fromVertices(in), positions outside it are clamped
+  inline void packVertices(std::span<const Vertex> in, const AABB& bounds, std::span<QuantizedVertex> out) {
+    assert(in.size() == out.size());
+    const Packing::PositionQuantizer q(bounds);
+
+    size_t i = 0;
+#ifdef STARLET_MATH_SSE
+    using namespace Packing::Detail;
+    for (; i + 4 <= in.size(); i += 4) {
+      Simd::Float4 lanes[12];
+      loadLanes(&in[i], lanes);
+      Attributes a;
+      encodeAttributes(lanes, a);
+
+      alignas(16) std::int32_t px[4], py[4], pz[4];
+      _mm_store_si128(reinterpret_cast<__m128i*>(px), quantize(lanes[PosX], q.min.x, q.scale.x));
+      _mm_store_si128(reinterpret_cast<__m128i*>(py), quantize(lanes[PosY], q.min.y, q.scale.y));
+      _mm_store_si128(reinterpret_cast<__m128i*>(pz), quantize(lanes[PosZ], q.min.z, q.scale.z));
+      for (int k = 0; k < 4; ++k) {
+        QuantizedVertex& v = out[i + k];
+        v.pos[0] = static_cast<std::uint16_t>(px[k]);
+        v.pos[1] = static_cast<std::uint16_t>(py[k]);
+        v.pos[2] = static_cast<std::uint16_t>(pz[k]);
+        v.pad = 0;
+        storeAttributes(v, a, k);
+      }
+    }
+#endif
+    for (; i < in.size(); ++i) out[i] = Packing::pack(in[i], q);
+  }
+  inline void unpackVertices(std::span<const QuantizedVertex> in, const AABB& bounds, std::span<Vertex> out) {
+    assert(in.size() == out.size());
+    const Packing::PositionQuantizer q(bounds);
+
+    size_t i = 0;
+#ifdef STARLET_MATH_SSE
+    using namespace Packing::Detail;
+    using Simd::Float4;
+    for (; i + 4 <= in.size(); i += 4) {
+      Attributes a;
+      for (int k = 0; k < 4; ++k) loadAttributes(in[i + k], a, k);
+
+      const auto axis = [&](const int c, const float lo, const float inv) {
+        const __m128i p = _mm_setr_epi32(in[i].pos[c], in[i + 1].pos[c], in[i + 2].pos[c], in[i + 3].pos[c]);
+        return Float4::splat(lo) + toFloat(p) * Float4::splat(inv);
+      };
+      Float4 lanes[12];
+      lanes[PosX] = axis(0, q.min.x, q.invScale.x);
+      lanes[PosY] = axis(1, q.min.y, q.invScale.y);
+      lanes[PosZ] = axis(2, q.min.z, q.invScale.z);
+      decodeAttributes(a, lanes);
+      storeLanes(&out[i], lanes);
+    }
+#endif
+    for (; i < in.size(); ++i) out[i] = Packing::unpack(in[i], q);
+  }
+}
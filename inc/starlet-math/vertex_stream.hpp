@@ -0,0 +1,112 @@
+#pragma once
+
+#include "aligned_allocator.hpp"
+#include "simd.hpp"
+#include "vertex.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+
+namespace Starlet::Math {
+  /*
+  VertexStreamSoA
+  * One 64-byte aligned float array per Vertex component
+  * Convert from Vertex spans to do math on single attributes, convert back to upload
+  */
+  struct VertexStreamSoA {
+    AlignedVector<float> posX, posY, posZ;
+    AlignedVector<float> colR, colG, colB, colA;
+    AlignedVector<float> normX, normY, normZ;
+    AlignedVector<float> u, v;
+
+    VertexStreamSoA() = default;
+    explicit VertexStreamSoA(std::span<const Vertex> vertices) { deinterleave(vertices); }
+
+    size_t size() const { return posX.size(); }
+    bool empty() const { return posX.empty(); }
+
+    void resize(const size_t n) {
+      for (AlignedVector<float>* lane : lanes()) lane->resize(n);
+    }
+    void clear() {
+      for (AlignedVector<float>* lane : lanes()) lane->clear();
+    }
+
+    Vertex get(const size_t i) const {
+      Vertex vert;
+      vert.pos = { posX[i], posY[i], posZ[i] };
+      vert.col = { colR[i], colG[i], colB[i], colA[i] };
+      vert.norm = { normX[i], normY[i], normZ[i] };
+      vert.texCoord = { u[i], v[i] };
+      return vert;
+    }
+    void set(const size_t i, const Vertex& vert) {
+      posX[i] = vert.pos.x; posY[i] = vert.pos.y; posZ[i] = vert.pos.z;
+      colR[i] = vert.col.r; colG[i] = vert.col.g; colB[i] = vert.col.b; colA[i] = vert.col.a;
+      normX[i] = vert.norm.x; normY[i] = vert.norm.y; normZ[i] = vert.norm.z;
+      u[i] = vert.texCoord.x; v[i] = vert.texCoord.y;
+    }
+
+    // AoS -> SoA, resizes the stream to match
+    void deinterleave(std::span<const Vertex> vertices) {
+      static_assert(sizeof(Vertex) == 12 * sizeof(float), "Vertex must be twelve packed floats");
+      resize(vertices.size());
+
+      const std::array<AlignedVector<float>*, 12> dst = lanes();
+      const size_t n = vertices.size();
+      size_t i = 0;
+
+      // Four vertices are twelve 16-byte chunks, three 4x4 transposes turn them into lanes
+      for (; i + 4 <= n; i += 4) {
+        const float* src = reinterpret_cast<const float*>(vertices.data() + i);
+        for (int chunk = 0; chunk < 3; ++chunk) {
+          Simd::Float4 r0 = Simd::Float4::load(src + chunk * 4);
+          Simd::Float4 r1 = Simd::Float4::load(src + 12 + chunk * 4);
+          Simd::Float4 r2 = Simd::Float4::load(src + 24 + chunk * 4);
+          Simd::Float4 r3 = Simd::Float4::load(src + 36 + chunk * 4);
+          Simd::transpose(r0, r1, r2, r3);
+          r0.storeAligned(dst[chunk * 4]->data() + i);
+          r1.storeAligned(dst[chunk * 4 + 1]->data() + i);
+          r2.storeAligned(dst[chunk * 4 + 2]->data() + i);
+          r3.storeAligned(dst[chunk * 4 + 3]->data() + i);
+        }
+      }
+      for (; i < n; ++i) set(i, vertices[i]);
+    }
+    // SoA -> AoS, out must hold exactly size() vertices
+    void interleave(std::span<Vertex> out) const {
+      assert(out.size() == size());
+
+      const std::array<const AlignedVector<float>*, 12> src = lanes();
+      const size_t n = out.size();
+      size_t i = 0;
+
+      for (; i + 4 <= n; i += 4) {
+        float* dst = reinterpret_cast<float*>(out.data() + i);
+        for (int chunk = 0; chunk < 3; ++chunk) {
+          Simd::Float4 r0 = Simd::Float4::loadAligned(src[chunk * 4]->data() + i);
+          Simd::Float4 r1 = Simd::Float4::loadAligned(src[chunk * 4 + 1]->data() + i);
+          Simd::Float4 r2 = Simd::Float4::loadAligned(src[chunk * 4 + 2]->data() + i);
+          Simd::Float4 r3 = Simd::Float4::loadAligned(src[chunk * 4 + 3]->data() + i);
+          Simd::transpose(r0, r1, r2, r3);
+          r0.store(dst + chunk * 4);
+          r1.store(dst + 12 + chunk * 4);
+          r2.store(dst + 24 + chunk * 4);
+          r3.store(dst + 36 + chunk * 4);
+        }
+      }
+      for (; i < n; ++i) out[i] = get(i);
+    }
+
+  private:
+    // Component order matches the float order inside Vertex
+    std::array<AlignedVector<float>*, 12> lanes() {
+      return { &posX, &posY, &posZ, &colR, &colG, &colB, &colA, &normX, &normY, &normZ, &u, &v };
+    }
+    std::array<const AlignedVector<float>*, 12> lanes() const {
+      return { &posX, &posY, &posZ, &colR, &colG, &colB, &colA, &normX, &normY, &normZ, &u, &v };
+    }
+  };
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "mat4.hpp"
+#include "simd.hpp"
+#include "vertex.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace Starlet::Math {
+  static_assert(sizeof(Vertex) == 48, "vertex kernels assume a tightly packed 48-byte Vertex");
+
+  // Outputs at least this large bypass the cache with non-temporal stores
+  constexpr size_t STREAMING_STORE_BYTES{ size_t(4) << 20 };
+
+  namespace Detail {
+    inline void transformVertexScalar(const Mat4& m, const Mat4& normalMat, const Vertex& in, Vertex& out) {
+      const Vec4<float> p = m * Vec4<float>(in.pos, 1.0f);
+      const Vec4<float> n = normalMat * Vec4<float>(in.norm, 0.0f);
+
+      out.col = in.col;
+      out.texCoord = in.texCoord;
+      out.pos = { p.x, p.y, p.z };
+      out.norm = Vec3<float>(n.x, n.y, n.z).normalized();
+    }
+
+#ifdef STARLET_MATH_SSE
+    template<bool Streaming>
+    inline void transformVerticesSse(const Mat4& m, const Mat4& normalMat, const Vertex* in, Vertex* out, const size_t n) {
+      const __m128 m0 = _mm_loadu_ps(m.models), m1 = _mm_loadu_ps(m.models + 4);
+      const __m128 m2 = _mm_loadu_ps(m.models + 8), m3 = _mm_loadu_ps(m.models + 12);
+      const __m128 n0 = _mm_loadu_ps(normalMat.models), n1 = _mm_loadu_ps(normalMat.models + 4);
+      const __m128 n2 = _mm_loadu_ps(normalMat.models + 8);
+
+      for (size_t i = 0; i < n; ++i) {
+        // A Vertex is three 16-byte chunks: [pos.xyz col.r] [col.gba norm.x] [norm.yz uv]
+        const float* src = reinterpret_cast<const float*>(in + i);
+        const __m128 in0 = _mm_loadu_ps(src), in1 = _mm_loadu_ps(src + 4), in2 = _mm_loadu_ps(src + 8);
+
+        __m128 p = _mm_mul_ps(m0, _mm_shuffle_ps(in0, in0, _MM_SHUFFLE(0, 0, 0, 0)));
+        p = _mm_add_ps(p, _mm_mul_ps(m1, _mm_shuffle_ps(in0, in0, _MM_SHUFFLE(1, 1, 1, 1))));
+        p = _mm_add_ps(p, _mm_mul_ps(m2, _mm_shuffle_ps(in0, in0, _MM_SHUFFLE(2, 2, 2, 2))));
+        p = _mm_add_ps(p, m3);
+
+        __m128 nv = _mm_mul_ps(n0, _mm_shuffle_ps(in1, in1, _MM_SHUFFLE(3, 3, 3, 3)));
+        nv = _mm_add_ps(nv, _mm_mul_ps(n1, _mm_shuffle_ps(in2, in2, _MM_SHUFFLE(0, 0, 0, 0))));
+        nv = _mm_add_ps(nv, _mm_mul_ps(n2, _mm_shuffle_ps(in2, in2, _MM_SHUFFLE(1, 1, 1, 1))));
+
+        // Normal matrix columns have w = 0, so a four-lane sum is the xyz length
+        __m128 sq = _mm_mul_ps(nv, nv);
+        sq = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 3, 0, 1)));
+        sq = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 0, 3, 2)));
+        const __m128 len = _mm_sqrt_ps(sq);
+        nv = _mm_cvtss_f32(len) < 1e-6f ? _mm_setzero_ps() : _mm_div_ps(nv, len);
+
+        const __m128 t0 = _mm_shuffle_ps(p, in0, _MM_SHUFFLE(3, 3, 2, 2));
+        const __m128 out0 = _mm_shuffle_ps(p, t0, _MM_SHUFFLE(2, 0, 1, 0));
+        const __m128 t1 = _mm_shuffle_ps(in1, nv, _MM_SHUFFLE(0, 0, 2, 2));
+        const __m128 out1 = _mm_shuffle_ps(in1, t1, _MM_SHUFFLE(2, 0, 1, 0));
+        const __m128 out2 = _mm_shuffle_ps(nv, in2, _MM_SHUFFLE(3, 2, 2, 1));
+
+        float* dst = reinterpret_cast<float*>(out + i);
+        if constexpr (Streaming) {
+          _mm_stream_ps(dst, out0);
+          _mm_stream_ps(dst + 4, out1);
+          _mm_stream_ps(dst + 8, out2);
+        }
+        else {
+          _mm_storeu_ps(dst, out0);
+          _mm_storeu_ps(dst + 4, out1);
+          _mm_storeu_ps(dst + 8, out2);
+        }
+      }
+      if constexpr (Streaming) _mm_sfence();
+    }
+#endif
+  }
+
+  /*
+  transformVertices
+  * Positions by m (w dropped, no perspective divide), normals by m.normalCofactors() and renormalized
+  * A singular upper 3x3 still gives the right normals: a flattening scale points them along the flattened axis
+  * Colour and texture coordinates are copied through
+  * in and out may be the same array
+  */
+  inline void transformVertices(const Mat4& m, const Vertex* in, Vertex* out, const size_t n) {
+    const Mat4 normalMat = m.normalCofactors();
+
+#ifdef STARLET_MATH_SSE
+    const bool aligned = (reinterpret_cast<std::uintptr_t>(out) & 15) == 0;
+    if (in != out && aligned && n * sizeof(Vertex) >= STREAMING_STORE_BYTES)
+      Detail::transformVerticesSse<true>(m, normalMat, in, out, n);
+    else
+      Detail::transformVerticesSse<false>(m, normalMat, in, out, n);
+#else
+    for (size_t i = 0; i < n; ++i)
+      Detail::transformVertexScalar(m, normalMat, in[i], out[i]);
+#endif
+  }
+  inline void transformVertices(const Mat4& m, Vertex* vertices, const size_t n) {
+    transformVertices(m, vertices, vertices, n);
+  }
+}
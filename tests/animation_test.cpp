@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "starlet-math/animation.hpp"
+#include "test_helpers.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	// Channels with different key counts and spacing, so cursors advance independently
+	SMath::AnimationTrack randomTrack(std::mt19937& rng) {
+		std::uniform_real_distribution<float> pos(-10.0f, 10.0f), angle(-180.0f, 180.0f), size(0.5f, 2.0f), step(0.05f, 0.5f);
+		SMath::AnimationTrack track;
+		float t = 0.0f;
+		for (int k = 0; k < 12; ++k, t += step(rng)) track.addPosition(t, { pos(rng), pos(rng), pos(rng) });
+		t = 0.0f;
+		for (int k = 0; k < 9; ++k, t += step(rng)) track.addRotation(t, SMath::Quat<float>::fromEuler({ angle(rng), angle(rng), angle(rng) }));
+		t = 0.0f;
+		for (int k = 0; k < 5; ++k, t += step(rng)) track.addSize(t, { size(rng), size(rng), size(rng) });
+		return track;
+	}
+
+	// Straightforward per-instance evaluation: binary search every channel, lerp and nlerp
+	SMath::QuatTransform referenceSample(const SMath::AnimationTrack& track, float time) {
+		const auto locate = [time](const std::vector<float>& times, size_t& a, size_t& b, float& alpha) {
+			if (time <= times.front()) { a = b = 0; alpha = 0.0f; return; }
+			if (time >= times.back()) { a = b = times.size() - 1; alpha = 0.0f; return; }
+			b = std::upper_bound(times.begin(), times.end(), time) - times.begin();
+			a = b - 1;
+			alpha = (time - times[a]) / (times[b] - times[a]);
+		};
+
+		SMath::QuatTransform out;
+		size_t a, b;
+		float alpha;
+		locate(track.position.times, a, b, alpha);
+		const auto& p = track.position.values;
+		out.pos = { p[0][a] + (p[0][b] - p[0][a]) * alpha, p[1][a] + (p[1][b] - p[1][a]) * alpha, p[2][a] + (p[2][b] - p[2][a]) * alpha, 1.0f };
+
+		locate(track.rotation.times, a, b, alpha);
+		const auto& r = track.rotation.values;
+		out.rot = SMath::Quat<float>::nlerp({ r[0][a], r[1][a], r[2][a], r[3][a] }, { r[0][b], r[1][b], r[2][b], r[3][b] }, alpha);
+
+		locate(track.size.times, a, b, alpha);
+		const auto& s = track.size.values;
+		out.size = { s[0][a] + (s[0][b] - s[0][a]) * alpha, s[1][a] + (s[1][b] - s[1][a]) * alpha, s[2][a] + (s[2][b] - s[2][a]) * alpha };
+		return out;
+	}
+}
+
+TEST(AnimationTest, EmptyTrackIsIdentity) {
+	const SMath::AnimationTrack track;
+	SMath::TrackCursor cursor;
+	const SMath::QuatTransform t = SMath::sample(track, 1.5f, cursor);
+	expectMatNear(t.modelMatrix(), SMath::Mat4::identity(), 0.0f);
+	EXPECT_EQ(track.duration(), 0.0f);
+}
+TEST(AnimationTest, SampleInterpolatesAndClamps) {
+	SMath::AnimationTrack track;
+	track.addPosition(0.0f, { 0.0f, 0.0f, 0.0f });
+	track.addPosition(2.0f, { 4.0f, -2.0f, 6.0f });
+	track.addRotation(1.0f, SMath::Quat<float>::fromEuler({ 0.0f, 0.0f, 90.0f }));
+	track.addSize(0.0f, { 1.0f, 1.0f, 1.0f });
+	track.addSize(1.0f, { 3.0f, 3.0f, 3.0f });
+	EXPECT_EQ(track.duration(), 2.0f);
+
+	SMath::TrackCursor cursor;
+	const SMath::QuatTransform mid = SMath::sample(track, 0.5f, cursor);
+	EXPECT_NEAR(mid.pos.x, 1.0f, 1e-6f);
+	EXPECT_NEAR(mid.pos.y, -0.5f, 1e-6f);
+	EXPECT_NEAR(mid.size.z, 2.0f, 1e-6f);
+	EXPECT_NEAR(std::abs(mid.rot.dot(SMath::Quat<float>::fromEuler({ 0.0f, 0.0f, 90.0f }))), 1.0f, 1e-6f);
+
+	const SMath::QuatTransform before = SMath::sample(track, -1.0f, cursor);
+	EXPECT_EQ(before.pos.x, 0.0f);
+	const SMath::QuatTransform after = SMath::sample(track, 5.0f, cursor);
+	EXPECT_EQ(after.pos.z, 6.0f);
+	EXPECT_EQ(after.size.x, 3.0f);
+}
+TEST(AnimationTest, RotationKeysShareHemisphere) {
+	SMath::AnimationTrack track;
+	const SMath::Quat<float> q = SMath::Quat<float>::fromEuler({ 10.0f, 20.0f, 30.0f });
+	track.addRotation(0.0f, q);
+	track.addRotation(1.0f, { -q.x, -q.y, -q.z, -q.w });
+
+	// Without the flip the halfway blend would collapse towards zero
+	SMath::TrackCursor cursor;
+	EXPECT_NEAR(std::abs(SMath::sample(track, 0.5f, cursor).rot.dot(q)), 1.0f, 1e-6f);
+}
+TEST(AnimationTest, CursorMatchesFreshSearch) {
+	std::mt19937 rng(11);
+	const SMath::AnimationTrack track = randomTrack(rng);
+	std::uniform_real_distribution<float> jump(-1.0f, 4.0f);
+
+	// Forward playback, then random seeks in both directions
+	SMath::TrackCursor cursor;
+	std::vector<float> times;
+	for (float t = -0.1f; t < track.duration() + 0.2f; t += 1.0f / 60.0f) times.push_back(t);
+	for (int i = 0; i < 200; ++i) times.push_back(jump(rng));
+
+	for (const float t : times) {
+		SMath::TrackCursor fresh;
+		const SMath::QuatTransform coherent = SMath::sample(track, t, cursor);
+		expectMatNear(coherent.modelMatrix(), SMath::sample(track, t, fresh).modelMatrix(), 0.0f);
+		expectMatNear(coherent.modelMatrix(), referenceSample(track, t).modelMatrix(), 1e-4f);
+	}
+}
+TEST(AnimationTest, BatchedMatchesSample) {
+	std::mt19937 rng(3);
+	std::vector<SMath::AnimationTrack> tracks;
+	for (int i = 0; i < 7; ++i) tracks.push_back(randomTrack(rng));
+
+	// 1030 instances sharing 7 tracks, not a multiple of four, split over several threads
+	std::uniform_real_distribution<float> time(-0.5f, 5.0f);
+	std::vector<SMath::AnimationInstance> instances(1030);
+	for (size_t i = 0; i < instances.size(); ++i) instances[i] = { &tracks[i % tracks.size()], time(rng), {} };
+
+	for (const unsigned threads : { 1u, 3u }) {
+		std::vector<SMath::AnimationInstance> a = instances, b = instances;
+		std::vector<SMath::Mat4> matrices(instances.size());
+		std::vector<SMath::Transform> transforms(instances.size());
+		SMath::evaluate(a, matrices.data(), threads);
+		SMath::evaluate(b, transforms.data(), threads);
+
+		for (size_t i = 0; i < instances.size(); ++i) {
+			SMath::TrackCursor cursor;
+			const SMath::QuatTransform expected = SMath::sample(*instances[i].track, instances[i].time, cursor);
+			expectMatNear(matrices[i], expected.modelMatrix(), 1e-4f);
+			expectMatNear(SMath::Mat4::fromTRS(transforms[i]), expected.modelMatrix(), 1e-3f);
+			EXPECT_EQ(a[i].cursor.position, cursor.position);
+			EXPECT_EQ(a[i].cursor.rotation, cursor.rotation);
+		}
+	}
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "starlet-math/binary_archive.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	std::string tempPath(const char* name) {
+		return (std::filesystem::temp_directory_path() / name).string();
+	}
+
+	std::vector<SMath::Vertex> makeVertices(const size_t n) {
+		std::vector<SMath::Vertex> out(n);
+		for (size_t i = 0; i < n; ++i) {
+			const float f = static_cast<float>(i);
+			out[i].pos = { f, f * 2.0f, -f };
+			out[i].col = { 0.25f, 0.5f, 0.75f, 1.0f };
+			out[i].norm = { 0.0f, 1.0f, 0.0f };
+			out[i].texCoord = { f / n, 1.0f - f / n };
+		}
+		return out;
+	}
+
+	bool sameBytes(const void* a, const void* b, const size_t bytes) { return std::memcmp(a, b, bytes) == 0; }
+}
+
+TEST(BinaryArchiveTest, RoundTripsEveryChunkType) {
+	const std::string path = tempPath("starlet_archive_roundtrip.smb");
+	const auto vertices = makeVertices(37);
+	const std::vector<std::uint32_t> indices = { 0, 1, 2, 2, 1, 3 };
+	const std::vector<std::uint16_t> shortIndices = { 3, 2, 1 };
+	std::vector<SMath::Transform> transforms(5);
+	for (size_t i = 0; i < transforms.size(); ++i) transforms[i].pos = { static_cast<float>(i), 0.0f, 0.0f, 1.0f };
+	const std::vector<SMath::Mat4> matrices = { SMath::Mat4::identity(), SMath::Mat4::translation({ 1.0f, 2.0f, 3.0f, 1.0f }) };
+
+	{
+		SMath::ArchiveWriter writer(path);
+		ASSERT_TRUE(writer.good());
+		EXPECT_TRUE(writer.writeChunk(vertices));
+		EXPECT_TRUE(writer.writeChunk(indices));
+		EXPECT_TRUE(writer.writeChunk(shortIndices, 1));
+		EXPECT_TRUE(writer.writeChunk(transforms));
+		EXPECT_TRUE(writer.writeChunk(matrices));
+		EXPECT_TRUE(writer.finish());
+	}
+
+	SMath::MappedArchive archive(path);
+	ASSERT_TRUE(archive.isOpen());
+	ASSERT_EQ(archive.chunkCount(), 5u);
+
+	const auto v = archive.get<SMath::Vertex>(archive.find<SMath::Vertex>());
+	ASSERT_EQ(v.size(), vertices.size());
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.data()) % 64, 0u);
+	EXPECT_TRUE(sameBytes(v.data(), vertices.data(), v.size_bytes()));
+
+	const auto idx = archive.get<std::uint32_t>(archive.find<std::uint32_t>());
+	EXPECT_TRUE(std::equal(idx.begin(), idx.end(), indices.begin(), indices.end()));
+	const auto shortIdx = archive.get<std::uint16_t>(archive.find<std::uint16_t>(1));
+	EXPECT_TRUE(std::equal(shortIdx.begin(), shortIdx.end(), shortIndices.begin(), shortIndices.end()));
+
+	const auto t = archive.get<SMath::Transform>(3);
+	ASSERT_EQ(t.size(), transforms.size());
+	EXPECT_EQ(t[4].pos.x, 4.0f);
+	const auto m = archive.get<SMath::Mat4>(4);
+	ASSERT_EQ(m.size(), 2u);
+	EXPECT_EQ(m[1], matrices[1]);
+
+	// Wrong type, unknown tag and out of range all come back empty
+	EXPECT_TRUE(archive.get<SMath::Mat4>(0).empty());
+	EXPECT_EQ(archive.find<std::uint16_t>(7), archive.chunkCount());
+	EXPECT_TRUE(archive.view<SMath::Vertex>(archive.chunkCount()).empty());
+
+	archive.close();
+	std::filesystem::remove(path);
+}
+TEST(BinaryArchiveTest, StreamedPiecesMatchOneWrite) {
+	const std::string streamed = tempPath("starlet_archive_streamed.smb");
+	const std::string whole = tempPath("starlet_archive_whole.smb");
+	const auto vertices = makeVertices(1000);
+
+	{
+		SMath::ArchiveWriter writer(streamed);
+		ASSERT_TRUE(writer.beginChunk<SMath::Vertex>());
+		// Uneven pieces so the checksum sees blocks split across appends
+		for (size_t begin = 0; begin < vertices.size();) {
+			const size_t count = std::min<size_t>(begin % 7 + 1, vertices.size() - begin);
+			ASSERT_TRUE(writer.append(std::span<const SMath::Vertex>(vertices.data() + begin, count)));
+			begin += count;
+		}
+		// Appending a different element type into an open chunk is rejected
+		SMath::ArchiveWriter other(whole);
+		ASSERT_TRUE(other.beginChunk<SMath::Vertex>());
+		EXPECT_FALSE(other.append(std::vector<SMath::Mat4>(1)));
+		EXPECT_FALSE(other.good());
+		EXPECT_TRUE(writer.endChunk());
+		EXPECT_TRUE(writer.finish());
+	}
+	{
+		SMath::ArchiveWriter writer(whole);
+		EXPECT_TRUE(writer.writeChunk(vertices));
+		EXPECT_TRUE(writer.finish());
+	}
+
+	SMath::MappedArchive a(streamed), b(whole);
+	ASSERT_TRUE(a.isOpen());
+	ASSERT_TRUE(b.isOpen());
+	EXPECT_EQ(a.chunk(0).checksum, b.chunk(0).checksum);
+	EXPECT_EQ(a.chunk(0).checksum, SMath::Checksum::of(vertices.data(), vertices.size() * sizeof(SMath::Vertex)));
+	EXPECT_EQ(a.get<SMath::Vertex>(0).size(), vertices.size());
+
+	a.close();
+	b.close();
+	std::filesystem::remove(streamed);
+	std::filesystem::remove(whole);
+}
+TEST(BinaryArchiveTest, CorruptChunkFailsOnlyWhenTouched) {
+	const std::string path = tempPath("starlet_archive_corrupt.smb");
+	const auto vertices = makeVertices(64);
+	const std::vector<SMath::Mat4> matrices(3, SMath::Mat4::identity());
+	{
+		SMath::ArchiveWriter writer(path);
+		writer.writeChunk(vertices);
+		writer.writeChunk(matrices);
+		ASSERT_TRUE(writer.finish());
+	}
+
+	size_t vertexOffset = 0;
+	{
+		SMath::MappedArchive archive(path);
+		ASSERT_TRUE(archive.isOpen());
+		vertexOffset = static_cast<size_t>(archive.chunk(0).offset);
+	}
+	{
+		std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+		f.seekp(static_cast<std::streamoff>(vertexOffset + 5));
+		f.put('\x7f');
+	}
+
+	// The directory is intact, so the archive opens and the untouched chunk is fine
+	SMath::MappedArchive archive(path);
+	ASSERT_TRUE(archive.isOpen());
+	EXPECT_EQ(archive.get<SMath::Mat4>(1).size(), 3u);
+	EXPECT_EQ(archive.view<SMath::Vertex>(0).size(), vertices.size());
+	EXPECT_FALSE(archive.verify(0));
+	EXPECT_TRUE(archive.get<SMath::Vertex>(0).empty());
+
+	archive.close();
+	std::filesystem::remove(path);
+}
+TEST(BinaryArchiveTest, RejectsTruncatedOrUnfinishedFiles) {
+	const std::string path = tempPath("starlet_archive_truncated.smb");
+	{
+		SMath::ArchiveWriter writer(path);
+		writer.writeChunk(makeVertices(16));
+		ASSERT_TRUE(writer.finish());
+	}
+	const auto size = std::filesystem::file_size(path);
+	std::filesystem::resize_file(path, size - 8);
+	EXPECT_FALSE(SMath::MappedArchive(path).isOpen());
+
+	// A writer that never finishes leaves a zeroed header behind
+	{
+		std::ofstream(path, std::ios::binary | std::ios::trunc).write(std::string(256, '\0').data(), 256);
+	}
+	EXPECT_FALSE(SMath::MappedArchive(path).isOpen());
+	EXPECT_FALSE(SMath::MappedArchive(tempPath("starlet_archive_missing.smb")).isOpen());
+
+	std::filesystem::remove(path);
+}
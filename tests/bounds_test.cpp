@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "starlet-math/bounds.hpp"
+
+#include <random>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+TEST(BoundsTest, EmptyAABB) {
+	SMath::AABB box;
+	ASSERT_TRUE(box.empty());
+	ASSERT_FLOAT_EQ(box.surfaceArea(), 0.0f);
+
+	box.expand(SMath::Vec3<float>(1.0f, 2.0f, 3.0f));
+	ASSERT_FALSE(box.empty());
+	ASSERT_TRUE(box.min == SMath::Vec3<float>(1.0f, 2.0f, 3.0f));
+	ASSERT_TRUE(box.max == SMath::Vec3<float>(1.0f, 2.0f, 3.0f));
+}
+TEST(BoundsTest, AABBQueries) {
+	SMath::AABB box({ 0.0f, 0.0f, 0.0f }, { 2.0f, 4.0f, 6.0f });
+	ASSERT_TRUE(box.center() == SMath::Vec3<float>(1.0f, 2.0f, 3.0f));
+	ASSERT_FLOAT_EQ(box.surfaceArea(), 2.0f * (8.0f + 24.0f + 12.0f));
+	ASSERT_EQ(box.longestAxis(), 2);
+	ASSERT_TRUE(box.contains({ 1.0f, 1.0f, 1.0f }));
+	ASSERT_FALSE(box.contains({ 3.0f, 1.0f, 1.0f }));
+	ASSERT_TRUE(box.intersects(SMath::AABB({ 1.0f, 1.0f, 1.0f }, { 5.0f, 5.0f, 5.0f })));
+	ASSERT_FALSE(box.intersects(SMath::AABB({ 3.0f, 1.0f, 1.0f }, { 5.0f, 5.0f, 5.0f })));
+}
+TEST(BoundsTest, FromPointsMatchesScalar) {
+	std::mt19937 rng(5);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	for (size_t n : { 1u, 3u, 4u, 5u, 101u }) {
+		std::vector<SMath::Vec3<float>> points;
+		std::vector<SMath::Vertex> vertices(n);
+		SMath::AABB expected;
+		for (size_t i = 0; i < n; ++i) {
+			points.push_back({ dist(rng), dist(rng), dist(rng) });
+			vertices[i].pos = points.back();
+			expected.expand(points.back());
+		}
+
+		const SMath::AABB fromPoints = SMath::AABB::fromPoints(points);
+		const SMath::AABB fromVertices = SMath::AABB::fromVertices(vertices);
+		ASSERT_TRUE(fromPoints.min == expected.min); ASSERT_TRUE(fromPoints.max == expected.max);
+		ASSERT_TRUE(fromVertices.min == expected.min); ASSERT_TRUE(fromVertices.max == expected.max);
+	}
+	ASSERT_TRUE(SMath::AABB::fromPoints({}).empty());
+	ASSERT_TRUE(SMath::AABB::fromVertices({}).empty());
+}
+TEST(BoundsTest, SphereEnclosesPoints) {
+	std::mt19937 rng(6);
+	std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+
+	std::vector<SMath::Vec3<float>> points;
+	std::vector<SMath::Vertex> vertices(37);
+	for (SMath::Vertex& v : vertices) {
+		v.pos = { dist(rng), dist(rng), dist(rng) };
+		points.push_back(v.pos);
+	}
+
+	const SMath::BoundingSphere a = SMath::BoundingSphere::fromPoints(points);
+	const SMath::BoundingSphere b = SMath::BoundingSphere::fromVertices(vertices);
+	ASSERT_NEAR(a.radius, b.radius, 1e-5f);
+	for (const SMath::Vec3<float>& p : points) {
+		ASSERT_LE((p - a.center).length(), a.radius + 1e-4f);
+	}
+	ASSERT_TRUE(a.intersects(SMath::BoundingSphere{ a.center + SMath::Vec3<float>(a.radius + 1.0f, 0.0f, 0.0f), 1.5f }));
+	ASSERT_FALSE(a.intersects(SMath::BoundingSphere{ a.center + SMath::Vec3<float>(a.radius + 1.0f, 0.0f, 0.0f), 0.5f }));
+	ASSERT_EQ(sizeof(SMath::BoundingSphere), 16u);
+}
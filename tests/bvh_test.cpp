@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "starlet-math/bvh.hpp"
+
+#include <random>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	struct Soup {
+		std::vector<SMath::Vertex> vertices;
+		std::vector<std::uint32_t> indices;
+	};
+
+	Soup randomTriangles(size_t triangles, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> center(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+
+		Soup soup;
+		for (size_t t = 0; t < triangles; ++t) {
+			const SMath::Vec3<float> c{ center(rng), center(rng), center(rng) };
+			for (int k = 0; k < 3; ++k) {
+				SMath::Vertex v;
+				v.pos = c + SMath::Vec3<float>(offset(rng), offset(rng), offset(rng));
+				soup.indices.push_back(static_cast<std::uint32_t>(soup.vertices.size()));
+				soup.vertices.push_back(v);
+			}
+		}
+		return soup;
+	}
+
+	bool containsBox(const SMath::AABB& outer, const SMath::AABB& inner) {
+		return outer.contains(inner.min) && outer.contains(inner.max);
+	}
+
+	// Checks bounds nesting and that every primitive is referenced exactly once
+	void validate(const SMath::Bvh& bvh, const std::vector<SMath::AABB>& primBounds) {
+		std::vector<int> seen(primBounds.size(), 0);
+		for (size_t i = 0; i < bvh.nodes.size(); ++i) {
+			const SMath::BvhNode& node = bvh.nodes[i];
+			if (node.isLeaf()) {
+				for (std::uint32_t k = 0; k < node.count; ++k) {
+					const std::uint32_t prim = bvh.primitives[node.offset + k];
+					++seen[prim];
+					ASSERT_TRUE(containsBox(node.bounds, primBounds[prim]));
+				}
+			}
+			else {
+				ASSERT_LT(node.offset, bvh.nodes.size());
+				ASSERT_TRUE(containsBox(node.bounds, bvh.nodes[i + 1].bounds));
+				ASSERT_TRUE(containsBox(node.bounds, bvh.nodes[node.offset].bounds));
+			}
+		}
+		for (int count : seen) ASSERT_EQ(count, 1);
+	}
+
+	std::vector<SMath::AABB> triangleBounds(const Soup& soup) {
+		std::vector<SMath::AABB> bounds(soup.indices.size() / 3);
+		for (size_t t = 0; t < bounds.size(); ++t)
+			for (int k = 0; k < 3; ++k) bounds[t].expand(soup.vertices[soup.indices[t * 3 + k]].pos);
+		return bounds;
+	}
+}
+
+TEST(BvhTest, Empty) {
+	const SMath::Bvh bvh = SMath::Bvh::build({});
+	ASSERT_TRUE(bvh.empty());
+	bool called = false;
+	bvh.query(SMath::AABB({ -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f }), [&](std::uint32_t) { called = true; });
+	ASSERT_FALSE(called);
+}
+TEST(BvhTest, SinglePrimitive) {
+	const std::vector<SMath::AABB> bounds{ SMath::AABB({ 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }) };
+	const SMath::Bvh bvh = SMath::Bvh::build(bounds);
+	ASSERT_EQ(bvh.nodes.size(), 1u);
+	ASSERT_TRUE(bvh.nodes[0].isLeaf());
+	validate(bvh, bounds);
+}
+TEST(BvhTest, TrianglesStructure) {
+	const Soup soup = randomTriangles(5000, 1);
+	const SMath::Bvh bvh = SMath::Bvh::buildTriangles(soup.vertices, soup.indices);
+	validate(bvh, triangleBounds(soup));
+
+	for (const SMath::BvhNode& node : bvh.nodes)
+		if (node.isLeaf()) { ASSERT_LE(node.count, 4u); }
+}
+TEST(BvhTest, QueryMatchesBruteForce) {
+	const Soup soup = randomTriangles(3000, 2);
+	const std::vector<SMath::AABB> bounds = triangleBounds(soup);
+	const SMath::Bvh bvh = SMath::Bvh::build(bounds);
+
+	const SMath::AABB box({ -20.0f, -20.0f, -20.0f }, { 25.0f, 10.0f, 30.0f });
+	std::vector<std::uint32_t> hits;
+	bvh.query(box, [&](std::uint32_t prim) { if (bounds[prim].intersects(box)) hits.push_back(prim); });
+	std::sort(hits.begin(), hits.end());
+
+	std::vector<std::uint32_t> expected;
+	for (std::uint32_t i = 0; i < bounds.size(); ++i)
+		if (bounds[i].intersects(box)) expected.push_back(i);
+	ASSERT_FALSE(expected.empty());
+	ASSERT_EQ(hits, expected);
+}
+TEST(BvhTest, ParallelBuild) {
+	const Soup soup = randomTriangles(40000, 3);
+	SMath::Bvh::BuildOptions options;
+	options.threads = 4;
+	options.parallelThreshold = 256;
+
+	const SMath::Bvh bvh = SMath::Bvh::buildTriangles(soup.vertices, soup.indices, options);
+	validate(bvh, triangleBounds(soup));
+}
+TEST(BvhTest, CoincidentCentroids) {
+	std::vector<SMath::AABB> bounds(100, SMath::AABB({ 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }));
+	const SMath::Bvh bvh = SMath::Bvh::build(bounds);
+	validate(bvh, bounds);
+	for (const SMath::BvhNode& node : bvh.nodes)
+		if (node.isLeaf()) { ASSERT_LE(node.count, 4u); }
+}
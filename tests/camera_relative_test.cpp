@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "starlet-math/camera_relative.hpp"
+#include "test_helpers.hpp"
+
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+TEST(Mat4dTest, MatchesFloatMatrices) {
+	const SMath::Mat4d d = SMath::Mat4d::rotateX(30.0) * SMath::Mat4d::rotateY(-45.0) * SMath::Mat4d::translation({ 1.0, 2.0, 3.0, 1.0 });
+	const SMath::Mat4 f = SMath::Mat4::rotateX(30.0f) * SMath::Mat4::rotateY(-45.0f) * SMath::Mat4::translation({ 1.0f, 2.0f, 3.0f, 1.0f });
+	expectMatNear(d.cast<float>(), f, 1e-6f);
+
+	const SMath::Mat4d p = SMath::Mat4d::perspective(60.0, 16.0 / 9.0, 0.1, 1000.0);
+	expectMatNear(p.cast<float>(), SMath::Mat4::perspective(60.0f, 16.0f / 9.0f, 0.1f, 1000.0f), 1e-6f);
+}
+
+TEST(Mat4dTest, KeepsPrecisionFarFromOrigin) {
+	const SMath::Vec4<double> far{ 1.0e7 + 0.25, -3.0e6 + 0.5, 2.0e7 + 0.125, 1.0 };
+	const SMath::Mat4d m = SMath::Mat4d::translation(far) * SMath::Mat4d::rotateZ(37.0);
+
+	const SMath::Mat4d roundTrip = m * m.inverse();
+	for (int i = 0; i < 16; ++i)
+		EXPECT_NEAR(roundTrip.models[i], SMath::Mat4d::identity().models[i], 1e-8) << "element " << i;
+
+	const SMath::Vec4<double> p = m * SMath::Vec4<double>(0.0, 0.0, 0.0, 1.0);
+	EXPECT_EQ(p.x, far.x);
+	EXPECT_EQ(p.z, far.z);
+}
+
+TEST(CameraRelativeTest, RebaseKeepsSubUnitOffsets) {
+	const SMath::Vec3<double> camera{ 1.0e7, 5.0e6, -2.0e7 };
+	const SMath::Mat4d model = SMath::Mat4d::translation({ camera.x + 0.3, camera.y - 0.7, camera.z + 1.1, 1.0 }) * SMath::Mat4d::rotateY(20.0);
+
+	const SMath::Mat4 rebased = SMath::rebase(model, camera);
+	EXPECT_NEAR(rebased.models[12], 0.3f, 1e-6f);
+	EXPECT_NEAR(rebased.models[13], -0.7f, 1e-6f);
+	EXPECT_NEAR(rebased.models[14], 1.1f, 1e-6f);
+
+	// Dropping to float first loses the offset entirely at this distance
+	const SMath::Mat4 naive = model.cast<float>();
+	EXPECT_GT(std::abs((naive.models[12] - static_cast<float>(camera.x)) - 0.3f), 1e-2f);
+}
+
+TEST(CameraRelativeTest, BatchedMatchesDoubleReference) {
+	const SMath::Vec3<double> camera{ 4.0e6 + 0.5, -1.0e6, 9.0e6 };
+	const SMath::Mat4 view = SMath::Mat4::lookAt({ 0.0f, 0.0f, 0.0f }, { 0.3f, -0.2f, -1.0f });
+	const SMath::Mat4d viewD = SMath::Mat4d::lookAt({ 0.0, 0.0, 0.0 }, { 0.3, -0.2, -1.0 });
+
+	std::vector<SMath::Vec3<double>> positions;
+	std::vector<SMath::Mat4> local;
+	std::vector<SMath::Mat4d> models;
+	for (int i = 0; i < 9; ++i) {
+		const SMath::Vec3<double> p{ camera.x + i * 1.25, camera.y - i * 0.5, camera.z + 3.0 - i };
+		const SMath::Mat4d rotScale = SMath::Mat4d::rotateY(10.0 * i) * SMath::Mat4d::size({ 1.0 + i, 2.0, 0.5 });
+
+		positions.push_back(p);
+		local.push_back(rotScale.cast<float>());
+		models.push_back(SMath::Mat4d::translation({ p.x, p.y, p.z, 1.0 }) * rotScale);
+	}
+
+	std::vector<SMath::Mat4> fromPositions(positions.size()), fromModels(positions.size());
+	SMath::buildCameraRelativeModelViews(positions, local, camera, view, fromPositions);
+	SMath::buildCameraRelativeModelViews(models, camera, view, fromModels);
+
+	const SMath::Mat4d cameraTranslation = SMath::Mat4d::translation({ -camera.x, -camera.y, -camera.z, 1.0 });
+	for (size_t i = 0; i < positions.size(); ++i) {
+		const SMath::Mat4 expected = (viewD * cameraTranslation * models[i]).cast<float>();
+		expectMatNear(fromPositions[i], expected, 1e-5f);
+		expectMatNear(fromModels[i], expected, 1e-5f);
+	}
+}
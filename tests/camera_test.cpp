@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "starlet-math/camera.hpp"
+#include "test_helpers.hpp"
+
+#include <random>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	SMath::Camera testCamera(SMath::DepthMode mode, float farPlane) {
+		SMath::Camera camera;
+		camera.setPosition({ 3.0f, 2.0f, 10.0f });
+		camera.lookAt({ 0.0f, 0.0f, 0.0f });
+		camera.setViewport(1280.0f, 720.0f);
+		camera.setPerspective(70.0f, 0.5f, farPlane);
+		camera.setDepthMode(mode);
+		return camera;
+	}
+
+	// Points inside the view volume of testCamera
+	std::vector<SMath::Vec3<float>> pointsInView(size_t n) {
+		std::mt19937 rng(4);
+		std::uniform_real_distribution<float> d(-3.0f, 3.0f);
+		std::vector<SMath::Vec3<float>> out(n);
+		for (auto& p : out) p = { d(rng), d(rng), d(rng) };
+		return out;
+	}
+}
+
+TEST(CameraTest, DefaultsMatchConstants) {
+	const SMath::Camera camera;
+	EXPECT_EQ(camera.position(), Starlet::INITIAL_POS);
+	EXPECT_EQ(camera.fov(), Starlet::DEFAULT_FOV);
+	EXPECT_EQ(camera.nearPlane(), Starlet::NEAR_PLANE);
+	EXPECT_EQ(camera.farPlane(), Starlet::FAR_PLANE);
+
+	SMath::Camera oriented;
+	oriented.setOrientation(Starlet::DEFAULT_YAW, Starlet::DEFAULT_PITCH);
+	EXPECT_NEAR(oriented.front().x, camera.front().x, 1e-6f);
+	EXPECT_NEAR(oriented.front().z, camera.front().z, 1e-6f);
+}
+TEST(CameraTest, MatchesMat4Builders) {
+	const SMath::Camera camera = testCamera(SMath::DepthMode::Standard, 100.0f);
+	const SMath::Mat4 view = SMath::Mat4::lookAt(camera.position(), camera.front());
+	const SMath::Mat4 projection = SMath::Mat4::perspective(70.0f, 1280.0f / 720.0f, 0.5f, 100.0f);
+	expectMatNear(camera.view(), view, 1e-6f);
+	expectMatNear(camera.projection(), projection, 1e-5f);
+	expectMatNear(camera.viewProjection(), projection * view, 1e-5f);
+}
+TEST(CameraTest, InversesUndoForwardMatrices) {
+	for (const SMath::DepthMode mode : { SMath::DepthMode::Standard, SMath::DepthMode::Reversed }) {
+		for (const float farPlane : { 100.0f, SMath::Camera::InfiniteFar }) {
+			const SMath::Camera camera = testCamera(mode, farPlane);
+			expectMatNear(camera.view() * camera.inverseView(), SMath::Mat4::identity(), 1e-5f);
+			expectMatNear(camera.projection() * camera.inverseProjection(), SMath::Mat4::identity(), 1e-5f);
+			expectMatNear(camera.viewProjection() * camera.inverseViewProjection(), SMath::Mat4::identity(), 1e-4f);
+		}
+	}
+}
+TEST(CameraTest, DepthModesMapNearAndFar) {
+	for (const SMath::DepthMode mode : { SMath::DepthMode::Standard, SMath::DepthMode::Reversed }) {
+		SMath::Camera camera = testCamera(mode, 100.0f);
+		camera.setPosition({ 0.0f, 0.0f, 0.0f });
+		camera.setFront({ 0.0f, 0.0f, -1.0f });
+		EXPECT_NEAR(camera.worldToScreen({ 0.0f, 0.0f, -0.5f }).z, camera.nearDepth(), 1e-5f);
+		EXPECT_NEAR(camera.worldToScreen({ 0.0f, 0.0f, -100.0f }).z, camera.farDepth(), 1e-5f);
+		// Behind the camera lands outside the depth range
+		const float behind = camera.worldToScreen({ 0.0f, 0.0f, 5.0f }).z;
+		EXPECT_TRUE(behind < std::min(camera.nearDepth(), camera.farDepth()) || behind > std::max(camera.nearDepth(), camera.farDepth()));
+
+		camera.setPerspective(70.0f, 0.5f, SMath::Camera::InfiniteFar);
+		EXPECT_TRUE(camera.isInfinite());
+		EXPECT_NEAR(camera.worldToScreen({ 0.0f, 0.0f, -0.5f }).z, camera.nearDepth(), 1e-5f);
+		EXPECT_NEAR(camera.worldToScreen({ 0.0f, 0.0f, -1e7f }).z, camera.farDepth(), 1e-5f);
+	}
+}
+TEST(CameraTest, RebuildsOnlyAfterChanges) {
+	SMath::Camera camera = testCamera(SMath::DepthMode::Standard, 100.0f);
+	const SMath::Mat4 before = camera.viewProjection();
+	const std::uint64_t version = camera.version();
+
+	// Same values again are not changes
+	camera.setPosition({ 3.0f, 2.0f, 10.0f });
+	camera.lookAt({ 0.0f, 0.0f, 0.0f });
+	camera.setViewport(1280.0f, 720.0f);
+	camera.setPerspective(70.0f, 0.5f, 100.0f);
+	EXPECT_EQ(camera.version(), version);
+	expectMatNear(camera.viewProjection(), before, 0.0f);
+
+	camera.setViewport(640.0f, 640.0f);
+	EXPECT_GT(camera.version(), version);
+	EXPECT_NEAR(camera.projection().models[0], camera.projection().models[5], 1e-6f);
+	expectMatNear(camera.view(), SMath::Mat4::lookAt(camera.position(), camera.front()), 0.0f);
+
+	camera.setPosition({ 0.0f, 0.0f, 1.0f });
+	expectMatNear(camera.viewProjection(), camera.projection() * SMath::Mat4::lookAt(camera.position(), camera.front()), 1e-5f);
+}
+TEST(CameraTest, BatchedProjectionMatchesMatrices) {
+	const SMath::Camera camera = testCamera(SMath::DepthMode::Reversed, SMath::Camera::InfiniteFar);
+	const std::vector<SMath::Vec3<float>> world = pointsInView(37);
+	std::vector<SMath::Vec3<float>> screen(world.size()), back(world.size());
+	camera.worldToScreen(world, screen);
+	camera.screenToWorld(screen, back);
+
+	for (size_t i = 0; i < world.size(); ++i) {
+		const SMath::Vec4<float> clip = camera.viewProjection() * SMath::Vec4<float>{ world[i].x, world[i].y, world[i].z, 1.0f };
+		EXPECT_NEAR(screen[i].x, (clip.x / clip.w * 0.5f + 0.5f) * 1280.0f, 1e-2f);
+		EXPECT_NEAR(screen[i].y, (0.5f - clip.y / clip.w * 0.5f) * 720.0f, 1e-2f);
+		EXPECT_NEAR(screen[i].z, clip.z / clip.w, 1e-6f);
+		EXPECT_NEAR(back[i].x, world[i].x, 1e-3f);
+		EXPECT_NEAR(back[i].y, world[i].y, 1e-3f);
+		EXPECT_NEAR(back[i].z, world[i].z, 1e-3f);
+	}
+
+	// Centre of the screen on the near plane is straight ahead of the eye
+	const SMath::Vec3<float> nearCentre = camera.screenToWorld({ 640.0f, 360.0f, camera.nearDepth() });
+	const SMath::Vec3<float> expected = camera.position() + camera.front() * 0.5f;
+	EXPECT_NEAR(nearCentre.x, expected.x, 1e-4f);
+	EXPECT_NEAR(nearCentre.y, expected.y, 1e-4f);
+	EXPECT_NEAR(nearCentre.z, expected.z, 1e-4f);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "starlet-math/mat4.hpp"
+
+#include <cmath>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	constexpr bool near(const double a, const double b, const double tolerance) {
+		return (a > b ? a - b : b - a) <= tolerance;
+	}
+	constexpr bool matNear(const SMath::Mat4& a, const SMath::Mat4& b, const float tolerance) {
+		for (int i = 0; i < 16; ++i)
+			if (!near(a.models[i], b.models[i], tolerance)) return false;
+		return true;
+	}
+}
+
+// Everything below is evaluated by the compiler, a failure is a build error
+static_assert(near(SMath::Cx::sqrt(2.0), 1.41421356237309504880, 1e-15));
+static_assert(near(SMath::Cx::sqrt(1e-8), 1e-4, 1e-19));
+static_assert(SMath::Cx::sqrt(16) == 4.0);
+static_assert(near(SMath::Cx::sin(SMath::Cx::Detail::PI / 6.0), 0.5, 1e-15));
+static_assert(near(SMath::Cx::cos(SMath::Cx::Detail::PI / 3.0), 0.5, 1e-15));
+static_assert(near(SMath::Cx::tan(SMath::Cx::Detail::PI / 4.0), 1.0, 1e-15));
+static_assert(near(SMath::Cx::atan2(1.0, -1.0), 3.0 * SMath::Cx::Detail::PI / 4.0, 1e-15));
+static_assert(near(SMath::Cx::asin(0.5), SMath::Cx::Detail::PI / 6.0, 1e-15));
+
+static_assert(SMath::Vec3<float>(1.0f, 0.0f, 0.0f).cross({ 0.0f, 1.0f, 0.0f }) == SMath::Vec3<float>(0.0f, 0.0f, 1.0f));
+static_assert(SMath::Vec4<float>(1.0f, 2.0f, 3.0f, 4.0f).dot(SMath::Vec4<float>(1.0f)) == 10.0f);
+static_assert(SMath::Vec2<float>(3.0f, 4.0f).length() == 5.0f);
+static_assert(near(SMath::Vec3<float>(0.0f, 3.0f, 4.0f).normalized().z, 0.8, 1e-7));
+
+constexpr SMath::Mat4 BAKED_VIEW = SMath::Mat4::lookAt({ 0.0f, 2.0f, 5.0f }, { 0.0f, 0.0f, -1.0f });
+constexpr SMath::Mat4 BAKED_PROJECTION = SMath::Mat4::perspective(60.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+constexpr SMath::Mat4 BAKED_VIEW_PROJECTION = BAKED_PROJECTION * BAKED_VIEW;
+
+static_assert(SMath::Mat4::identity() * SMath::Mat4::identity() == SMath::Mat4::identity());
+static_assert(SMath::Mat4::translation({ 1.0f, 2.0f, 3.0f, 1.0f }).inverseRigid() == SMath::Mat4::translation({ -1.0f, -2.0f, -3.0f, 1.0f }));
+static_assert(matNear(SMath::Mat4::rotateZ(90.0f) * SMath::Mat4::rotateZ(-90.0f), SMath::Mat4::identity(), 1e-6f));
+static_assert(matNear(BAKED_VIEW * BAKED_VIEW.inverse(), SMath::Mat4::identity(), 1e-6f));
+static_assert(near(BAKED_PROJECTION.models[5], 1.7320508075688772, 1e-6));
+static_assert((SMath::Mat4::translation({ 1.0f, 2.0f, 3.0f, 1.0f }) * SMath::Vec4<float>(0.0f, 0.0f, 0.0f, 1.0f)).z == 3.0f);
+static_assert(near(SMath::Mat4::fromTRS({ 0.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 30.0f }, { 1.0f, 1.0f, 1.0f }).decompose().rot.z, 30.0, 1e-4));
+
+TEST(ConstexprTest, BakedMatricesMatchRuntime) {
+	// volatile keeps these calls on the runtime path
+	volatile float fov = 60.0f;
+	volatile float eyeY = 2.0f;
+
+	const SMath::Mat4 view = SMath::Mat4::lookAt({ 0.0f, eyeY, 5.0f }, { 0.0f, 0.0f, -1.0f });
+	const SMath::Mat4 projection = SMath::Mat4::perspective(fov, 16.0f / 9.0f, 0.1f, 100.0f);
+
+	for (int i = 0; i < 16; ++i) {
+		EXPECT_NEAR(BAKED_VIEW.models[i], view.models[i], 1e-6f) << "element " << i;
+		EXPECT_NEAR(BAKED_PROJECTION.models[i], projection.models[i], 1e-6f) << "element " << i;
+		EXPECT_NEAR(BAKED_VIEW_PROJECTION.models[i], (projection * view).models[i], 1e-5f) << "element " << i;
+	}
+}
+
+TEST(ConstexprTest, TrigMatchesCmath) {
+	for (double x = -20.0; x <= 20.0; x += 0.37) {
+		EXPECT_NEAR(SMath::Cx::Detail::sin(x), std::sin(x), 1e-14) << x;
+		EXPECT_NEAR(SMath::Cx::Detail::cos(x), std::cos(x), 1e-14) << x;
+		EXPECT_NEAR(SMath::Cx::Detail::atan2(x, 3.0 - x), std::atan2(x, 3.0 - x), 1e-14) << x;
+		EXPECT_NEAR(SMath::Cx::Detail::sqrt(x * x * 1e6), std::sqrt(x * x * 1e6), 1e-9) << x;
+	}
+}
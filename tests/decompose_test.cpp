@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "starlet-math/decompose.hpp"
+#include "test_helpers.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	// Angles in degrees, 180 and -180 are the same
+	void expectAngleNear(float a, float b, float tolerance) {
+		const float diff = std::remainder(a - b, 360.0f);
+		EXPECT_NEAR(diff, 0.0f, tolerance) << a << " vs " << b;
+	}
+
+	std::vector<SMath::Mat4> randomModelMatrices(size_t n, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> rot(-180.0f, 180.0f);
+		std::uniform_real_distribution<float> size(0.1f, 10.0f);
+
+		std::vector<SMath::Mat4> out(n);
+		for (SMath::Mat4& m : out)
+			m = SMath::Mat4::fromTRS({ pos(rng), pos(rng), pos(rng), 1.0f }, { rot(rng), rot(rng), rot(rng) }, { size(rng), size(rng), size(rng) });
+		return out;
+	}
+}
+
+TEST(DecomposeTest, EulerBatchMatchesDecompose) {
+	// 67 exercises the padded tail block
+	const std::vector<SMath::Mat4> matrices = randomModelMatrices(67, 42);
+	SMath::TransformBatch batch;
+	SMath::decomposeBatch(matrices, batch);
+	ASSERT_EQ(batch.count(), matrices.size());
+
+	for (size_t i = 0; i < matrices.size(); ++i) {
+		const SMath::Transform expected = matrices[i].decompose();
+		const SMath::Transform actual = batch.get(i);
+		EXPECT_FLOAT_EQ(actual.pos.x, expected.pos.x);
+		EXPECT_FLOAT_EQ(actual.pos.y, expected.pos.y);
+		EXPECT_FLOAT_EQ(actual.pos.z, expected.pos.z);
+		EXPECT_NEAR(actual.size.x, expected.size.x, 1e-5f * expected.size.x);
+		EXPECT_NEAR(actual.size.y, expected.size.y, 1e-5f * expected.size.y);
+		EXPECT_NEAR(actual.size.z, expected.size.z, 1e-5f * expected.size.z);
+		expectAngleNear(actual.rot.x, expected.rot.x, 2e-3f);
+		expectAngleNear(actual.rot.y, expected.rot.y, 2e-3f);
+		expectAngleNear(actual.rot.z, expected.rot.z, 2e-3f);
+	}
+}
+TEST(DecomposeTest, EulerBatchHandlesGimbalLock) {
+	// Column 0 straight down the z axis, the case asin and two atan2s lose
+	SMath::Mat4 m = SMath::Mat4::identity();
+	m.models[0] = 0.0f; m.models[2] = -1.0f;
+	m.models[8] = 1.0f; m.models[10] = 0.0f;
+
+	SMath::TransformBatch batch;
+	SMath::decomposeBatch(std::span<const SMath::Mat4>(&m, 1), batch);
+	const SMath::Transform expected = m.decompose();
+	EXPECT_NEAR(batch.rotY[0], 90.0f, 1e-3f);
+	expectAngleNear(batch.rotY[0], expected.rot.y, 1e-3f);
+	EXPECT_TRUE(std::isfinite(batch.rotX[0]));
+	EXPECT_EQ(batch.rotZ[0], 0.0f);
+}
+
+TEST(DecomposeTest, QuatBatchMatchesFromMat4) {
+	const std::vector<SMath::Mat4> matrices = randomModelMatrices(131, 7);
+	SMath::QuatTransformBatch batch;
+	SMath::decomposeBatch(matrices, batch);
+	ASSERT_EQ(batch.count(), matrices.size());
+
+	for (size_t i = 0; i < matrices.size(); ++i) {
+		const SMath::QuatTransform t = batch.get(i);
+		EXPECT_NEAR(std::abs(t.rot.dot(SMath::Quat<float>::fromMat4(matrices[i]))), 1.0f, 1e-5f);
+		EXPECT_NEAR(t.rot.length(), 1.0f, 1e-5f);
+		expectMatNear(t.modelMatrix(), matrices[i], 1e-3f);
+	}
+}
+TEST(DecomposeTest, QuatBatchZeroMatrixMatchesFromMat4) {
+	const SMath::Mat4 zero{};
+	SMath::QuatTransformBatch batch;
+	SMath::decomposeBatch(std::span<const SMath::Mat4>(&zero, 1), batch);
+	const SMath::QuatTransform t = batch.get(0);
+	EXPECT_NEAR(std::abs(t.rot.dot(SMath::Quat<float>::fromMat4(zero))), 1.0f, 1e-6f);
+	EXPECT_EQ(t.size.x, 0.0f);
+}
+
+TEST(DecomposeTest, PolarMatchesDecomposeWithoutShear) {
+	for (const SMath::Mat4& m : randomModelMatrices(64, 3)) {
+		const SMath::PolarDecomposition p = SMath::decomposePolar(m);
+		const SMath::Transform expected = m.decompose();
+		EXPECT_FALSE(p.reflected);
+		EXPECT_NEAR(p.size.x, expected.size.x, 1e-4f * expected.size.x);
+		EXPECT_NEAR(p.size.y, expected.size.y, 1e-4f * expected.size.y);
+		EXPECT_NEAR(p.size.z, expected.size.z, 1e-4f * expected.size.z);
+		EXPECT_NEAR(std::abs(p.rot.dot(SMath::Quat<float>::fromMat4(m))), 1.0f, 1e-5f);
+		expectMatNear(p.toQuatTransform().modelMatrix(), m, 1e-3f);
+	}
+}
+TEST(DecomposeTest, PolarHandlesReflection) {
+	const SMath::Mat4 rotation = SMath::Mat4::fromTRS({ 1.0f, 2.0f, 3.0f, 1.0f }, { 20.0f, -35.0f, 70.0f }, { 1.0f, 1.0f, 1.0f });
+	const SMath::Mat4 m = rotation * SMath::Mat4::size({ -2.0f, 3.0f, 4.0f });
+
+	const SMath::PolarDecomposition p = SMath::decomposePolar(m);
+	EXPECT_TRUE(p.reflected);
+	EXPECT_NEAR(p.size.x, -2.0f, 1e-4f);
+	EXPECT_NEAR(p.size.y, 3.0f, 1e-4f);
+	EXPECT_NEAR(p.size.z, 4.0f, 1e-4f);
+	EXPECT_NEAR(std::abs(p.rot.dot(SMath::Quat<float>::fromMat4(rotation))), 1.0f, 1e-5f);
+	expectMatNear(p.toQuatTransform().modelMatrix(), m, 1e-4f);
+
+	// Column lengths alone cannot see the flip
+	const SMath::Transform naive = m.decompose();
+	EXPECT_GT(naive.size.x, 0.0f);
+}
+TEST(DecomposeTest, PolarHandlesShear) {
+	const SMath::Mat4 rotation = SMath::Mat4::fromTRS({ 0.0f, 0.0f, 0.0f, 1.0f }, { -50.0f, 10.0f, 25.0f }, { 1.0f, 1.0f, 1.0f });
+	SMath::Mat4 stretch = SMath::Mat4::size({ 2.0f, 1.5f, 0.5f });
+	stretch.models[4] = 0.3f;  // symmetric shear, so this is already the polar stretch
+	stretch.models[1] = 0.3f;
+	const SMath::Mat4 m = rotation * stretch;
+
+	const SMath::PolarDecomposition p = SMath::decomposePolar(m);
+	EXPECT_FALSE(p.reflected);
+	EXPECT_NEAR(std::abs(p.rot.dot(SMath::Quat<float>::fromMat4(rotation))), 1.0f, 1e-5f);
+	expectMatNear(p.stretch, stretch, 1e-4f);
+	expectMatNear(p.compose(), m, 1e-4f);
+}
+TEST(DecomposeTest, PolarHandlesSingularMatrices) {
+	const SMath::Mat4 rotation = SMath::Mat4::fromTRS({ 5.0f, 0.0f, 0.0f, 1.0f }, { 30.0f, 60.0f, 0.0f }, { 1.0f, 1.0f, 1.0f });
+	for (const SMath::Vec3<float>& size : { SMath::Vec3<float>(0.0f, 2.0f, 3.0f), SMath::Vec3<float>(1.0f, 0.0f, 0.0f), SMath::Vec3<float>(0.0f) }) {
+		const SMath::Mat4 m = rotation * SMath::Mat4::size(size);
+		const SMath::PolarDecomposition p = SMath::decomposePolar(m);
+		EXPECT_NEAR(p.rot.length(), 1.0f, 1e-5f);
+		expectMatNear(p.compose(), m, 1e-4f);
+		EXPECT_NEAR(std::abs(p.size.x), size.x, 1e-4f);
+		EXPECT_NEAR(std::abs(p.size.y), size.y, 1e-4f);
+		EXPECT_NEAR(std::abs(p.size.z), size.z, 1e-4f);
+	}
+}
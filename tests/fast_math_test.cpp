@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "starlet-math/fast_math.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	double relError(const double approx, const double exact) {
+		return std::abs(approx - exact) / std::abs(exact);
+	}
+}
+
+// The exact reference is the double precision result for the same float input
+TEST(FastMathTest, SinCosWithinBound) {
+	double maxError = 0.0;
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<float> wide(-SMath::Fast::SINCOS_MAX_INPUT, SMath::Fast::SINCOS_MAX_INPUT);
+
+	auto check = [&](const float x) {
+		float s, c;
+		SMath::Fast::sincos(x, s, c);
+		maxError = std::max({ maxError, std::abs(s - std::sin(static_cast<double>(x))), std::abs(c - std::cos(static_cast<double>(x))) });
+		EXPECT_EQ(SMath::Fast::sin(x), s);
+		EXPECT_EQ(SMath::Fast::cos(x), c);
+	};
+	for (float x = -10.0f; x <= 10.0f; x += 1e-3f) check(x);
+	for (int i = 0; i < 100000; ++i) check(wide(rng));
+
+	EXPECT_LE(maxError, SMath::Fast::SINCOS_MAX_ERROR);
+}
+
+TEST(FastMathTest, SinCosFloat4MatchesScalar) {
+	for (float x = -50.0f; x <= 50.0f; x += 0.173f) {
+		const SMath::Simd::Float4 in = SMath::Simd::Float4::set(x, -x, x * 0.5f, x + 0.25f);
+		SMath::Simd::Float4 s, c;
+		SMath::Fast::sincos(in, s, c);
+		for (int l = 0; l < 4; ++l) {
+			EXPECT_NEAR(s.lane(l), std::sin(static_cast<double>(in.lane(l))), SMath::Fast::SINCOS_MAX_ERROR);
+			EXPECT_NEAR(c.lane(l), std::cos(static_cast<double>(in.lane(l))), SMath::Fast::SINCOS_MAX_ERROR);
+		}
+	}
+}
+
+TEST(FastMathTest, RsqrtAndRcpWithinBound) {
+	double maxRsqrt = 0.0, maxRcp = 0.0, maxRsqrt4 = 0.0, maxRcp4 = 0.0;
+	std::mt19937 rng(2);
+	std::uniform_real_distribution<float> exponent(-30.0f, 30.0f);
+
+	for (int i = 0; i < 200000; ++i) {
+		const float x = std::exp2(exponent(rng));
+		maxRsqrt = std::max(maxRsqrt, relError(SMath::Fast::rsqrt(x), 1.0 / std::sqrt(static_cast<double>(x))));
+		maxRcp = std::max(maxRcp, relError(SMath::Fast::rcp(x), 1.0 / static_cast<double>(x)));
+
+		const SMath::Simd::Float4 v = SMath::Simd::Float4::splat(x);
+		maxRsqrt4 = std::max(maxRsqrt4, relError(SMath::Fast::rsqrt(v).lane(0), 1.0 / std::sqrt(static_cast<double>(x))));
+		maxRcp4 = std::max(maxRcp4, relError(SMath::Fast::rcp(v).lane(0), 1.0 / static_cast<double>(x)));
+	}
+
+	EXPECT_LE(maxRsqrt, SMath::Fast::RSQRT_MAX_REL_ERROR);
+	EXPECT_LE(maxRcp, SMath::Fast::RCP_MAX_REL_ERROR);
+	EXPECT_LE(maxRsqrt4, SMath::Fast::RSQRT_MAX_REL_ERROR);
+	EXPECT_LE(maxRcp4, SMath::Fast::RCP_MAX_REL_ERROR);
+}
+
+TEST(FastMathTest, Atan2WithinBound) {
+	std::mt19937 rng(5);
+	std::uniform_real_distribution<float> d(-100.0f, 100.0f);
+	float maxError = 0.0f;
+	for (int i = 0; i < 200000; ++i) {
+		const float y = d(rng), x = d(rng);
+		maxError = std::max(maxError, static_cast<float>(std::abs(SMath::Fast::atan2(y, x) - std::atan2(static_cast<double>(y), static_cast<double>(x)))));
+	}
+	EXPECT_LE(maxError, SMath::Fast::ATAN2_MAX_ERROR);
+
+	EXPECT_EQ(SMath::Fast::atan2(0.0f, 0.0f), 0.0f);
+	EXPECT_NEAR(SMath::Fast::atan2(1.0f, 0.0f), 1.5707963f, SMath::Fast::ATAN2_MAX_ERROR);
+	EXPECT_NEAR(SMath::Fast::atan2(0.0f, -1.0f), 3.1415927f, SMath::Fast::ATAN2_MAX_ERROR);
+	EXPECT_NEAR(SMath::Fast::atan2(-1.0f, -1.0f), -2.3561945f, SMath::Fast::ATAN2_MAX_ERROR);
+}
+TEST(FastMathTest, Atan2Float4MatchesScalar) {
+	std::mt19937 rng(6);
+	std::uniform_real_distribution<float> d(-100.0f, 100.0f);
+	for (int i = 0; i < 20000; ++i) {
+		const SMath::Simd::Float4 y = SMath::Simd::Float4::set(d(rng), d(rng), 0.0f, -0.0f);
+		const SMath::Simd::Float4 x = SMath::Simd::Float4::set(d(rng), 0.0f, d(rng), -1.0f);
+		const SMath::Simd::Float4 a = SMath::Fast::atan2(y, x);
+		for (int l = 0; l < 4; ++l)
+			EXPECT_NEAR(a.lane(l), SMath::Fast::atan2(y.lane(l), x.lane(l)), 1e-6f) << y.lane(l) << ' ' << x.lane(l);
+	}
+}
+
+TEST(FastMathTest, NormalizedMatchesExact) {
+	std::mt19937 rng(3);
+	std::uniform_real_distribution<float> d(-1000.0f, 1000.0f);
+	for (int i = 0; i < 1000; ++i) {
+		const SMath::Vec3<float> v{ d(rng), d(rng), d(rng) };
+		const SMath::Vec3<float> fast = SMath::Fast::normalized(v), exact = v.normalized();
+		EXPECT_NEAR(fast.x, exact.x, 1e-6f);
+		EXPECT_NEAR(fast.y, exact.y, 1e-6f);
+		EXPECT_NEAR(fast.z, exact.z, 1e-6f);
+		EXPECT_NEAR(SMath::Fast::length(v), v.length(), v.length() * 1e-6);
+	}
+	EXPECT_EQ(SMath::Fast::normalized(SMath::Vec3<float>(0.0f)), SMath::Vec3<float>(0.0f));
+}
+
+TEST(FastMathTest, MatrixBuildersMatchExact) {
+	SMath::Transform t;
+	t.pos = { 1.0f, -2.0f, 3.0f, 1.0f };
+	t.rot = { 20.0f, -35.0f, 110.0f };
+	t.size = { 2.0f, 0.5f, 1.5f };
+
+	const SMath::Mat4 pairs[][2] = {
+		{ SMath::Fast::fromTRS(t), SMath::Mat4::fromTRS(t) },
+		{ SMath::Fast::rotateX(33.0f), SMath::Mat4::rotateX(33.0f) },
+		{ SMath::Fast::rotateY(-71.0f), SMath::Mat4::rotateY(-71.0f) },
+		{ SMath::Fast::rotateZ(250.0f), SMath::Mat4::rotateZ(250.0f) },
+		{ SMath::Fast::perspective(60.0f, 16.0f / 9.0f, 0.1f, 1000.0f), SMath::Mat4::perspective(60.0f, 16.0f / 9.0f, 0.1f, 1000.0f) }
+	};
+	for (const auto& pair : pairs)
+		for (int i = 0; i < 16; ++i)
+			EXPECT_NEAR(pair[0].models[i], pair[1].models[i], std::max(1e-6f, std::abs(pair[1].models[i]) * 1e-5f)) << "element " << i;
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include "starlet-math/frame_allocator.hpp"
+#include "starlet-math/mat4.hpp"
+#include "starlet-math/parallel.hpp"
+#include "starlet-math/transform.hpp"
+#include "starlet-math/vertex.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	bool cacheAligned(const void* p) { return reinterpret_cast<std::uintptr_t>(p) % 64 == 0; }
+}
+
+TEST(FrameAllocatorTest, ArenaBumpsAlignedBlocks) {
+	SMath::LinearArena arena(4096);
+	const auto mats = arena.allocate<SMath::Mat4>(5);
+	const auto verts = arena.allocate<SMath::Vertex>(3);
+	const auto transforms = arena.allocate<SMath::Transform>(7);
+
+	EXPECT_EQ(mats.size(), 5u);
+	EXPECT_TRUE(cacheAligned(mats.data()));
+	EXPECT_TRUE(cacheAligned(verts.data()));
+	EXPECT_TRUE(cacheAligned(transforms.data()));
+	EXPECT_GE(reinterpret_cast<const std::byte*>(verts.data()), reinterpret_cast<const std::byte*>(mats.data() + mats.size()));
+
+	for (auto& m : mats) m = SMath::Mat4::identity();
+	EXPECT_EQ(mats[4].models[15], 1.0f);
+
+	const SMath::ArenaStats s = arena.stats();
+	EXPECT_EQ(s.allocations, 3u);
+	EXPECT_EQ(s.overflowed, 0u);
+	EXPECT_EQ(s.used, arena.used());
+	EXPECT_EQ(s.used % 64, 0u);
+
+	// Reset hands the same memory out again
+	arena.reset();
+	EXPECT_EQ(arena.used(), 0u);
+	EXPECT_EQ(arena.allocate<SMath::Mat4>(1).data(), mats.data());
+	EXPECT_EQ(arena.stats().peak, s.used);
+}
+TEST(FrameAllocatorTest, OverflowFallsBackAndGrowsOnReset) {
+	SMath::LinearArena arena(256);
+	const auto small = arena.allocate<SMath::Mat4>(2);
+	small[1] = SMath::Mat4::identity();
+	const auto big = arena.allocate<SMath::Mat4>(100);
+	ASSERT_EQ(big.size(), 100u);
+	EXPECT_TRUE(cacheAligned(big.data()));
+	for (auto& m : big) m = SMath::Mat4{};
+	EXPECT_EQ(small[1].models[15], 1.0f);
+
+	const SMath::ArenaStats s = arena.stats();
+	EXPECT_EQ(s.overflowed, 100 * sizeof(SMath::Mat4));
+	EXPECT_EQ(s.capacity, 256u);
+
+	// The next frame of the same size fits without overflow
+	arena.reset();
+	EXPECT_GE(arena.capacity(), s.used);
+	arena.allocate<SMath::Mat4>(2);
+	arena.allocate<SMath::Mat4>(100);
+	EXPECT_EQ(arena.stats().overflowed, 0u);
+}
+TEST(FrameAllocatorTest, RingKeepsPreviousFramesAlive) {
+	SMath::FrameAllocator<3> frames(1024);
+	std::vector<SMath::Mat4*> blocks;
+	for (int f = 0; f < 3; ++f) {
+		if (f > 0) frames.beginFrame();
+		const auto mats = frames.allocate<SMath::Mat4>(2);
+		mats[0] = SMath::Mat4::translation({ static_cast<float>(f), 0.0f, 0.0f, 1.0f });
+		blocks.push_back(mats.data());
+	}
+	EXPECT_EQ(frames.frame(), 2u);
+
+	// The two earlier frames are untouched while frame 2 is recorded
+	for (int f = 0; f < 3; ++f) EXPECT_EQ(blocks[f][0].models[12], static_cast<float>(f));
+	EXPECT_EQ(std::set<SMath::Mat4*>(blocks.begin(), blocks.end()).size(), 3u);
+
+	// Frame 3 reuses frame 0's memory
+	frames.beginFrame();
+	EXPECT_EQ(frames.stats().used, 0u);
+	EXPECT_EQ(frames.allocate<SMath::Mat4>(2).data(), blocks[0]);
+}
+TEST(FrameAllocatorTest, WorkersClaimDistinctArenas) {
+	constexpr unsigned threads = 4;
+	SMath::FrameAllocator<> frames(0, threads, 1 << 16);
+	for (int frame = 0; frame < 2; ++frame) {
+		frames.beginFrame();
+		std::vector<SMath::LinearArena*> claimed(threads, nullptr);
+		SMath::parallelFor(threads, 1, [&](const size_t begin, const size_t end) {
+			SMath::LinearArena* arena = frames.claimWorker();
+			ASSERT_NE(arena, nullptr);
+			for (size_t i = begin; i < end; ++i) {
+				claimed[i] = arena;
+				const auto verts = arena->allocate<SMath::Vertex>(100);
+				for (auto& v : verts) v.pos = { static_cast<float>(i), 0.0f, 0.0f };
+			}
+		}, threads);
+
+		EXPECT_EQ(std::set<SMath::LinearArena*>(claimed.begin(), claimed.end()).size(), threads);
+		const SMath::ArenaStats s = frames.stats();
+		EXPECT_EQ(s.allocations, threads);
+		EXPECT_EQ(s.overflowed, 0u);
+		EXPECT_EQ(s.capacity, threads * (size_t(1) << 16));
+	}
+}
+TEST(FrameAllocatorTest, WorkerArenaStaysBoundToItsThread) {
+	SMath::FrameAllocator<> frames(0, 2, 1024);
+	SMath::LinearArena* first = frames.claimWorker();
+	ASSERT_NE(first, nullptr);
+	EXPECT_EQ(frames.claimWorker(), first);
+
+	// A second parallel pass in the same frame finds the calling thread's arena again
+	std::vector<SMath::LinearArena*> claimed(2, nullptr);
+	SMath::parallelFor(2, 1, [&](const size_t begin, const size_t) { claimed[begin] = frames.claimWorker(); }, 2);
+	EXPECT_EQ(claimed[1], first);
+	EXPECT_NE(claimed[0], nullptr);
+	EXPECT_NE(claimed[0], first);
+
+	// The binding ends with the frame
+	frames.beginFrame();
+	SMath::LinearArena* next = frames.claimWorker();
+	ASSERT_NE(next, nullptr);
+	EXPECT_EQ(frames.claimWorker(), next);
+}
+TEST(FrameAllocatorTest, ClaimsBeyondWorkerCountReturnNull) {
+	constexpr unsigned threads = 6;
+	constexpr size_t workers = 2;
+	SMath::FrameAllocator<> frames(0, workers, 1024);
+	std::vector<SMath::LinearArena*> claimed(threads, nullptr);
+	SMath::parallelFor(threads, 1, [&](const size_t begin, const size_t) { claimed[begin] = frames.claimWorker(); }, threads);
+
+	std::set<SMath::LinearArena*> bound(claimed.begin(), claimed.end());
+	EXPECT_EQ(std::count(claimed.begin(), claimed.end(), nullptr), static_cast<std::ptrdiff_t>(threads - workers));
+	bound.erase(nullptr);
+	EXPECT_EQ(bound.size(), workers);
+}
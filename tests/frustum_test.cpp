@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "starlet-math/frustum.hpp"
+
+#include <random>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	SMath::Frustum testFrustum() {
+		const SMath::Mat4 view = SMath::Mat4::lookAt({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f });
+		const SMath::Mat4 projection = SMath::Mat4::perspective(90.0f, 1.0f, 1.0f, 100.0f);
+		return SMath::Frustum(projection * view);
+	}
+
+	struct RandomBounds {
+		std::vector<float> x, y, z, radius;
+		std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+
+		explicit RandomBounds(size_t n) {
+			std::mt19937 rng(17);
+			std::uniform_real_distribution<float> pos(-150.0f, 150.0f);
+			std::uniform_real_distribution<float> extent(0.1f, 10.0f);
+			for (size_t i = 0; i < n; ++i) {
+				x.push_back(pos(rng)); y.push_back(pos(rng)); z.push_back(pos(rng));
+				radius.push_back(extent(rng));
+				minX.push_back(x[i] - extent(rng)); minY.push_back(y[i] - extent(rng)); minZ.push_back(z[i] - extent(rng));
+				maxX.push_back(x[i] + extent(rng)); maxY.push_back(y[i] + extent(rng)); maxZ.push_back(z[i] + extent(rng));
+			}
+		}
+
+		SMath::SphereBoundsSoA spheres() const { return { x, y, z, radius }; }
+		SMath::BoxBoundsSoA boxes() const { return { minX, minY, minZ, maxX, maxY, maxZ }; }
+	};
+
+	bool bit(const std::vector<std::uint8_t>& mask, size_t i) { return (mask[i / 8] >> (i % 8)) & 1u; }
+}
+
+TEST(FrustumTest, PlanesFromPerspective) {
+	const SMath::Frustum f = testFrustum();
+	ASSERT_TRUE(f.containsPoint({ 0.0f, 0.0f, -10.0f }));
+	ASSERT_FALSE(f.containsPoint({ 0.0f, 0.0f, 10.0f }));
+	ASSERT_FALSE(f.containsPoint({ 0.0f, 0.0f, -0.5f }));
+	ASSERT_FALSE(f.containsPoint({ 0.0f, 0.0f, -101.0f }));
+	ASSERT_FALSE(f.containsPoint({ 20.0f, 0.0f, -10.0f }));
+	ASSERT_NEAR(f.distance(SMath::Frustum::Near, { 0.0f, 0.0f, -3.0f }), 2.0f, 1e-4f);
+}
+TEST(FrustumTest, SphereAndBox) {
+	const SMath::Frustum f = testFrustum();
+	ASSERT_TRUE(f.intersectsSphere({ 12.0f, 0.0f, -10.0f }, 3.0f));
+	ASSERT_FALSE(f.intersectsSphere({ 12.0f, 0.0f, -10.0f }, 1.0f));
+	ASSERT_TRUE(f.intersectsAABB({ -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f }));
+	ASSERT_FALSE(f.intersectsAABB({ -1.0f, -1.0f, 1.0f }, { 1.0f, 1.0f, 2.0f }));
+}
+TEST(FrustumTest, BatchMatchesScalar) {
+	const SMath::Frustum f = testFrustum();
+	const RandomBounds bounds(1003);
+	const size_t n = bounds.x.size();
+
+	std::vector<std::uint8_t> sphereMask((n + 7) / 8), boxMask((n + 7) / 8);
+	f.cullSpheres(bounds.spheres(), sphereMask.data());
+	f.cullBoxes(bounds.boxes(), boxMask.data());
+
+	size_t visible = 0;
+	for (size_t i = 0; i < n; ++i) {
+		ASSERT_EQ(bit(sphereMask, i), f.intersectsSphere({ bounds.x[i], bounds.y[i], bounds.z[i] }, bounds.radius[i])) << i;
+		ASSERT_EQ(bit(boxMask, i), f.intersectsAABB({ bounds.minX[i], bounds.minY[i], bounds.minZ[i] }, { bounds.maxX[i], bounds.maxY[i], bounds.maxZ[i] })) << i;
+		visible += bit(sphereMask, i);
+	}
+	ASSERT_GT(visible, 0u);
+	ASSERT_LT(visible, n);
+}
+TEST(FrustumTest, CompactIndices) {
+	const SMath::Frustum f = testFrustum();
+	const RandomBounds bounds(2500);
+	const size_t n = bounds.x.size();
+
+	std::vector<std::uint8_t> mask((n + 7) / 8);
+	f.cullSpheres(bounds.spheres(), mask.data());
+	std::vector<std::uint32_t> indices(n);
+	const size_t count = f.cullSpheresCompact(bounds.spheres(), indices.data());
+
+	std::vector<std::uint32_t> expected;
+	for (size_t i = 0; i < n; ++i)
+		if (bit(mask, i)) expected.push_back(static_cast<std::uint32_t>(i));
+	ASSERT_EQ(count, expected.size());
+	for (size_t i = 0; i < count; ++i) ASSERT_EQ(indices[i], expected[i]);
+
+	f.cullBoxes(bounds.boxes(), mask.data());
+	const size_t boxCount = f.cullBoxesCompact(bounds.boxes(), indices.data());
+	size_t k = 0;
+	for (size_t i = 0; i < n; ++i) {
+		if (bit(mask, i)) { ASSERT_EQ(indices[k++], i); }
+	}
+	ASSERT_EQ(k, boxCount);
+}
+TEST(FrustumTest, ParallelMatchesSerial) {
+	const SMath::Frustum f = testFrustum();
+	const RandomBounds bounds(50001);
+	const size_t n = bounds.x.size();
+
+	std::vector<std::uint8_t> serial((n + 7) / 8), parallel((n + 7) / 8);
+	f.cullSpheres(bounds.spheres(), serial.data());
+	f.cullSpheresParallel(bounds.spheres(), parallel.data(), 4);
+	ASSERT_EQ(serial, parallel);
+
+	f.cullBoxes(bounds.boxes(), serial.data());
+	f.cullBoxesParallel(bounds.boxes(), parallel.data(), 4);
+	ASSERT_EQ(serial, parallel);
+}
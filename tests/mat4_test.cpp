@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include "starlet-math/mat4.hpp"
+#include "test_helpers.hpp"
+
+#include <random>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	SMath::Mat4 chainedTRS(const SMath::Transform& t) {
+		return SMath::Mat4::translation(t.pos)
+			* SMath::Mat4::rotateX(t.rot.x)
+			* SMath::Mat4::rotateY(t.rot.y)
+			* SMath::Mat4::rotateZ(t.rot.z)
+			* SMath::Mat4::size(t.size);
+	}
+}
+
+TEST(Mat4Test, Identity) {
+	SMath::Mat4 m = SMath::Mat4::identity();
+	for (int i = 0; i < 16; ++i)
+		ASSERT_FLOAT_EQ(m.models[i], (i % 5 == 0) ? 1.0f : 0.0f);
+}
+
+TEST(Mat4Test, FromTRSIdentity) {
+	expectMatNear(SMath::Mat4::fromTRS(SMath::Transform{}), SMath::Mat4::identity(), 0.0f);
+}
+TEST(Mat4Test, FromTRSSingleAxis) {
+	SMath::Transform t;
+	t.rot = { 90.0f, 0.0f, 0.0f };
+	expectMatNear(SMath::Mat4::fromTRS(t), SMath::Mat4::rotateX(90.0f), 1e-6f);
+
+	t.rot = { 0.0f, 45.0f, 0.0f };
+	expectMatNear(SMath::Mat4::fromTRS(t), SMath::Mat4::rotateY(45.0f), 1e-6f);
+
+	t.rot = { 0.0f, 0.0f, -30.0f };
+	expectMatNear(SMath::Mat4::fromTRS(t), SMath::Mat4::rotateZ(-30.0f), 1e-6f);
+}
+TEST(Mat4Test, FromTRSMatchesChainedProduct) {
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> rot(-180.0f, 180.0f);
+	std::uniform_real_distribution<float> size(0.1f, 5.0f);
+
+	for (int i = 0; i < 100; ++i) {
+		SMath::Transform t;
+		t.pos = { pos(rng), pos(rng), pos(rng), 1.0f };
+		t.rot = { rot(rng), rot(rng), rot(rng) };
+		t.size = { size(rng), size(rng), size(rng) };
+
+		expectMatNear(SMath::Mat4::fromTRS(t), chainedTRS(t), 1e-5f);
+		expectMatNear(SMath::Mat4::modelMatrix(t), chainedTRS(t), 1e-5f);
+	}
+}
+
+TEST(Mat4Test, MultiplyKernelsMatchScalar) {
+	std::mt19937 rng(7);
+	std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+	const SMath::Kernels::Isa isas[] = { SMath::Kernels::Isa::Sse2, SMath::Kernels::Isa::Avx2Fma };
+
+	for (int i = 0; i < 100; ++i) {
+		float a[16], b[16], v[4];
+		for (float& f : a) f = dist(rng);
+		for (float& f : b) f = dist(rng);
+		for (float& f : v) f = dist(rng);
+
+		float expected[16], expectedVec[4];
+		SMath::Kernels::mulScalar(a, b, expected);
+		SMath::Kernels::mulVecScalar(a, v, expectedVec);
+
+		for (SMath::Kernels::Isa isa : isas) {
+			if (!SMath::Kernels::isaSupported(isa)) continue;
+
+			float out[16], outVec[4];
+			SMath::Kernels::mul(a, b, out, isa);
+			SMath::Kernels::mulVec(a, v, outVec, isa);
+			for (int k = 0; k < 16; ++k) ASSERT_NEAR(out[k], expected[k], 1e-3f);
+			for (int k = 0; k < 4; ++k) ASSERT_NEAR(outVec[k], expectedVec[k], 1e-3f);
+		}
+	}
+}
+TEST(Mat4Test, MultiplyOperators) {
+	SMath::Mat4 t = SMath::Mat4::translation({ 1.0f, 2.0f, 3.0f, 1.0f });
+	SMath::Mat4 s = SMath::Mat4::size({ 2.0f, 2.0f, 2.0f });
+
+	SMath::Vec4<float> p = (t * s) * SMath::Vec4<float>(1.0f, 1.0f, 1.0f, 1.0f);
+	ASSERT_FLOAT_EQ(p.x, 3.0f); ASSERT_FLOAT_EQ(p.y, 4.0f); ASSERT_FLOAT_EQ(p.z, 5.0f); ASSERT_FLOAT_EQ(p.w, 1.0f);
+
+	SMath::Mat4 m = t;
+	m *= s;
+	ASSERT_TRUE(m == t * s);
+	ASSERT_TRUE(SMath::Mat4::identity() * t == t);
+}
+
+TEST(Mat4Test, InverseSuccessFlag) {
+	SMath::Mat4 m = SMath::Mat4::translation({ 1.0f, 2.0f, 3.0f, 1.0f }) * SMath::Mat4::size({ 2.0f, 4.0f, 8.0f });
+	SMath::Mat4 inv;
+	ASSERT_TRUE(m.inverse(inv));
+	expectMatNear(m * inv, SMath::Mat4::identity(), 1e-6f);
+
+	SMath::Mat4 singular{};
+	ASSERT_FALSE(singular.inverse(inv));
+	ASSERT_TRUE(inv == SMath::Mat4::identity());
+	ASSERT_TRUE(singular.inverse() == SMath::Mat4::identity());
+}
+TEST(Mat4Test, IsAffine) {
+	SMath::Transform t;
+	t.pos = { 1.0f, 2.0f, 3.0f, 1.0f };
+	t.rot = { 10.0f, 20.0f, 30.0f };
+	ASSERT_TRUE(SMath::Mat4::modelMatrix(t).isAffine());
+	ASSERT_TRUE(SMath::Mat4::lookAt({ 1.0f, 2.0f, 3.0f }, { 0.0f, 0.0f, -1.0f }).isAffine());
+	ASSERT_FALSE(SMath::Mat4::perspective(60.0f, 1.5f, 0.1f, 100.0f).isAffine());
+}
+TEST(Mat4Test, InverseAffineMatchesGeneral) {
+	std::mt19937 rng(3);
+	std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> rot(-180.0f, 180.0f);
+	std::uniform_real_distribution<float> size(0.5f, 4.0f);
+
+	for (int i = 0; i < 50; ++i) {
+		SMath::Transform t;
+		t.pos = { pos(rng), pos(rng), pos(rng), 1.0f };
+		t.rot = { rot(rng), rot(rng), rot(rng) };
+		t.size = { size(rng), size(rng), size(rng) };
+		const SMath::Mat4 m = SMath::Mat4::modelMatrix(t);
+
+		SMath::Mat4 inv;
+		ASSERT_TRUE(m.inverseAffine(inv));
+		expectMatNear(inv, m.inverse(), 1e-4f);
+	}
+
+	SMath::Mat4 flat = SMath::Mat4::size({ 1.0f, 0.0f, 1.0f });
+	SMath::Mat4 inv;
+	ASSERT_FALSE(flat.inverseAffine(inv));
+	ASSERT_TRUE(inv == SMath::Mat4::identity());
+}
+TEST(Mat4Test, NormalMatrixReportsSingular) {
+	const SMath::Mat4 m = SMath::Mat4::rotateY(30.0f) * SMath::Mat4::size({ 2.0f, 1.0f, 0.5f });
+	SMath::Mat4 normal;
+	ASSERT_TRUE(m.normalMatrix(normal));
+	expectMatNear(normal, m.inverse().transpose(), 1e-5f);
+	expectMatNear(normal, m.normalMatrix(), 0.0f);
+
+	const SMath::Mat4 flat = SMath::Mat4::size({ 1.0f, 0.0f, 1.0f });
+	EXPECT_FALSE(flat.normalMatrix(normal));
+	EXPECT_TRUE(normal == SMath::Mat4::identity());
+	EXPECT_TRUE(flat.normalMatrix() == SMath::Mat4::identity());
+}
+TEST(Mat4Test, NormalCofactorsMatchNormalMatrixDirection) {
+	// Includes a mirroring scale and a small uniform scale that would shrink raw cofactors below the renormalize cutoff
+	const SMath::Mat4 cases[] = {
+		SMath::Mat4::rotateY(30.0f) * SMath::Mat4::size({ 2.0f, 1.0f, 0.5f }),
+		SMath::Mat4::rotateX(-70.0f) * SMath::Mat4::size({ -1.0f, 3.0f, 1.0f }),
+		SMath::Mat4::size(SMath::Vec3<float>(1e-4f)),
+	};
+	for (const SMath::Mat4& m : cases) {
+		const SMath::Mat4 cof = m.normalCofactors();
+		const SMath::Mat4 normal = m.normalMatrix();
+		const SMath::Vec3<float> n = SMath::Vec3<float>(0.3f, -0.8f, 0.52f).normalized();
+		const SMath::Vec4<float> a = cof * SMath::Vec4<float>(n, 0.0f), b = normal * SMath::Vec4<float>(n, 0.0f);
+		const SMath::Vec3<float> da = SMath::Vec3<float>(a.x, a.y, a.z).normalized(), db = SMath::Vec3<float>(b.x, b.y, b.z).normalized();
+		EXPECT_NEAR(da.x, db.x, 1e-5f); EXPECT_NEAR(da.y, db.y, 1e-5f); EXPECT_NEAR(da.z, db.z, 1e-5f);
+		EXPECT_GT(SMath::Vec3<float>(a.x, a.y, a.z).length(), 1e-3f);
+	}
+
+	// Rank one or lower has no normal direction at all
+	const SMath::Mat4 line = SMath::Mat4::size({ 2.0f, 0.0f, 0.0f });
+	const SMath::Vec4<float> n = line.normalCofactors() * SMath::Vec4<float>(0.0f, 1.0f, 0.0f, 0.0f);
+	EXPECT_FLOAT_EQ(n.x, 0.0f); EXPECT_FLOAT_EQ(n.y, 0.0f); EXPECT_FLOAT_EQ(n.z, 0.0f);
+}
+TEST(Mat4Test, InverseRigid) {
+	const SMath::Mat4 view = SMath::Mat4::lookAt({ 4.0f, -2.0f, 7.0f }, { 0.3f, -0.2f, -1.0f });
+	expectMatNear(view.inverseRigid(), view.inverse(), 1e-5f);
+
+	SMath::Transform t;
+	t.pos = { -3.0f, 5.0f, 1.0f, 1.0f };
+	t.rot = { 33.0f, -71.0f, 12.0f };
+	const SMath::Mat4 m = SMath::Mat4::modelMatrix(t);
+	expectMatNear(m.inverseRigid(), m.inverse(), 1e-5f);
+}
+TEST(Mat4Test, InverseBatch) {
+	std::mt19937 rng(11);
+	std::uniform_real_distribution<float> dist(-5.0f, 5.0f);
+
+	// 15 = one eight-wide pass, one four-wide pass and a scalar tail of three, with a singular matrix in each
+	std::vector<SMath::Mat4> in(15);
+	for (SMath::Mat4& m : in)
+		for (float& f : m.models) f = dist(rng);
+	in[2] = SMath::Mat4{};
+	in[9] = SMath::Mat4{};
+	in[13] = SMath::Mat4{};
+
+	for (SMath::Kernels::Isa isa : { SMath::Kernels::Isa::Scalar, SMath::Kernels::Isa::Sse2, SMath::Kernels::Isa::Avx2Fma }) {
+		if (!SMath::Kernels::isaSupported(isa)) continue;
+		SCOPED_TRACE(static_cast<int>(isa));
+
+		auto batch = in;
+		std::vector<SMath::Mat4> out(batch.size());
+		ASSERT_FALSE(SMath::Mat4::inverseBatch(batch.data(), out.data(), batch.size(), isa));
+		for (size_t i = 0; i < batch.size(); ++i)
+			expectMatNear(out[i], batch[i].inverse(), 1e-3f);
+
+		batch[2] = SMath::Mat4::identity();
+		batch[9] = SMath::Mat4::identity();
+		ASSERT_FALSE(SMath::Mat4::inverseBatch(batch.data(), out.data(), batch.size(), isa));
+		batch[13] = SMath::Mat4::identity();
+		ASSERT_TRUE(SMath::Mat4::inverseBatch(batch.data(), out.data(), batch.size(), isa));
+
+		// In place
+		SMath::Mat4::inverseBatch(batch.data(), batch.data(), batch.size(), isa);
+		for (size_t i = 0; i < batch.size(); ++i)
+			expectMatNear(batch[i], out[i], 0.0f);
+	}
+}
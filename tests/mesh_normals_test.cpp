@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include "starlet-math/mesh_normals.hpp"
+
+#include <random>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	// (n + 1)^2 vertices on a grid in the xy plane, uv = xy, two counter-clockwise triangles per cell
+	void makeGrid(int n, std::vector<SMath::Vertex>& vertices, std::vector<std::uint32_t>& indices) {
+		vertices.assign((n + 1) * (n + 1), {});
+		for (int y = 0; y <= n; ++y)
+			for (int x = 0; x <= n; ++x) {
+				SMath::Vertex& v = vertices[y * (n + 1) + x];
+				v.pos = { static_cast<float>(x), static_cast<float>(y), 0.0f };
+				v.texCoord = { static_cast<float>(x) / n, static_cast<float>(y) / n };
+			}
+
+		indices.clear();
+		for (int y = 0; y < n; ++y)
+			for (int x = 0; x < n; ++x) {
+				const std::uint32_t i = y * (n + 1) + x;
+				indices.insert(indices.end(), { i, i + 1, i + n + 2, i, i + n + 2, i + n + 1 });
+			}
+	}
+
+	// Serial scatter over triangles, the loop computeNormals replaces
+	std::vector<SMath::Vec3<float>> referenceAreaNormals(const std::vector<SMath::Vertex>& vertices, const std::vector<std::uint32_t>& indices) {
+		std::vector<SMath::Vec3<float>> sums(vertices.size(), SMath::Vec3<float>(0.0f));
+		for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+			const SMath::Vec3<float>& a = vertices[indices[t]].pos;
+			const SMath::Vec3<float> n = (vertices[indices[t + 1]].pos - a).cross(vertices[indices[t + 2]].pos - a);
+			for (int k = 0; k < 3; ++k) sums[indices[t + k]] += n;
+		}
+		for (SMath::Vec3<float>& s : sums) s = s.normalized();
+		return sums;
+	}
+}
+
+TEST(MeshNormalsTest, AdjacencyListsEveryCorner) {
+	const std::vector<std::uint32_t> indices{ 0, 1, 2, 2, 1, 3, 3, 1, 0 };
+	const SMath::VertexAdjacency adj = SMath::VertexAdjacency::build(5, indices);
+
+	ASSERT_EQ(adj.vertexCount(), 5u);
+	ASSERT_EQ(adj.corners.size(), 9u);
+	EXPECT_EQ(adj.cornersOf(0).size(), 2u);
+	EXPECT_EQ(adj.cornersOf(1).size(), 3u);
+	EXPECT_EQ(adj.cornersOf(4).size(), 0u);
+	for (size_t v = 0; v < 5; ++v) {
+		const auto corners = adj.cornersOf(v);
+		for (size_t i = 0; i < corners.size(); ++i) {
+			EXPECT_EQ(indices[corners[i]], v);
+			if (i > 0) {
+				EXPECT_LT(corners[i - 1], corners[i]);
+			}
+		}
+	}
+}
+
+TEST(MeshNormalsTest, FlatGridFacesPositiveZ) {
+	std::vector<SMath::Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	makeGrid(8, vertices, indices);
+
+	for (SMath::NormalWeighting w : { SMath::NormalWeighting::Area, SMath::NormalWeighting::Angle }) {
+		SMath::computeNormals(vertices, indices, w);
+		for (const SMath::Vertex& v : vertices) {
+			EXPECT_NEAR(v.norm.x, 0.0f, 1e-6f);
+			EXPECT_NEAR(v.norm.y, 0.0f, 1e-6f);
+			EXPECT_NEAR(v.norm.z, 1.0f, 1e-6f);
+		}
+	}
+}
+TEST(MeshNormalsTest, TinyTrianglesStayUnitLength) {
+	std::vector<SMath::Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	makeGrid(2, vertices, indices);
+	for (SMath::Vertex& v : vertices) v.pos *= 1e-5f;
+
+	SMath::computeNormals(vertices, indices, SMath::NormalWeighting::Area);
+	for (const SMath::Vertex& v : vertices) EXPECT_NEAR(v.norm.z, 1.0f, 1e-6f);
+}
+TEST(MeshNormalsTest, AngleWeightingIgnoresTessellation) {
+	// A vertex where two perpendicular faces meet, one of them split into three slivers
+	std::vector<SMath::Vertex> vertices(6);
+	vertices[0].pos = { 0, 0, 0 };
+	vertices[1].pos = { 1, 0, 0 };
+	vertices[2].pos = { 0, 1, 0 };
+	vertices[3].pos = { 0, 0, 1 };
+	vertices[4].pos = { 0.5f, 0.5f, 0 };
+	vertices[5].pos = { 0.1f, 0.9f, 0 };
+	// xy face split at 4 and 5, facing +z, and one xz face facing +y
+	const std::vector<std::uint32_t> indices{ 0, 1, 4, 0, 4, 5, 0, 5, 2, 0, 3, 1 };
+
+	SMath::computeNormals(vertices, indices, SMath::NormalWeighting::Angle);
+	// Each face spans 90 degrees at vertex 0, so both count equally
+	EXPECT_NEAR(vertices[0].norm.x, 0.0f, 1e-6f);
+	EXPECT_NEAR(vertices[0].norm.y, vertices[0].norm.z, 1e-6f);
+}
+TEST(MeshNormalsTest, MatchesSerialReferenceOnAnyThreadCount) {
+	std::mt19937 rng(9);
+	std::uniform_real_distribution<float> d(-1.0f, 1.0f);
+	std::vector<SMath::Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	makeGrid(40, vertices, indices);
+	for (SMath::Vertex& v : vertices) v.pos.z = d(rng);
+
+	const std::vector<SMath::Vec3<float>> expected = referenceAreaNormals(vertices, indices);
+
+	std::vector<SMath::Vertex> single = vertices, many = vertices;
+	SMath::computeNormals(single, indices, SMath::NormalWeighting::Area, 1);
+	SMath::computeNormals(many, indices, SMath::NormalWeighting::Area, 7);
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		EXPECT_EQ(single[i].norm, many[i].norm);
+		EXPECT_NEAR(many[i].norm.x, expected[i].x, 1e-5f);
+		EXPECT_NEAR(many[i].norm.y, expected[i].y, 1e-5f);
+		EXPECT_NEAR(many[i].norm.z, expected[i].z, 1e-5f);
+	}
+}
+
+TEST(MeshNormalsTest, TangentsFollowU) {
+	std::vector<SMath::Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	makeGrid(6, vertices, indices);
+	SMath::computeNormals(vertices, indices);
+
+	std::vector<SMath::Vec4<float>> tangents(vertices.size());
+	SMath::computeTangents(vertices, indices, tangents);
+	for (const SMath::Vec4<float>& t : tangents) {
+		EXPECT_NEAR(t.x, 1.0f, 1e-6f);
+		EXPECT_NEAR(t.y, 0.0f, 1e-6f);
+		EXPECT_NEAR(t.z, 0.0f, 1e-6f);
+		EXPECT_EQ(t.w, 1.0f);
+	}
+}
+TEST(MeshNormalsTest, MirroredUvsFlipHandedness) {
+	std::vector<SMath::Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	makeGrid(4, vertices, indices);
+	for (SMath::Vertex& v : vertices) v.texCoord.x = -v.texCoord.x;
+	SMath::computeNormals(vertices, indices);
+
+	std::vector<SMath::Vec4<float>> tangents(vertices.size());
+	SMath::computeTangents(vertices, indices, tangents);
+	for (const SMath::Vec4<float>& t : tangents) {
+		EXPECT_NEAR(t.x, -1.0f, 1e-6f);
+		EXPECT_EQ(t.w, -1.0f);
+	}
+}
+TEST(MeshNormalsTest, TangentsAreOrthonormalOnCurvedSurface) {
+	std::vector<SMath::Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	makeGrid(16, vertices, indices);
+	for (SMath::Vertex& v : vertices) v.pos.z = 0.1f * (v.pos.x * v.pos.x - v.pos.y);
+	SMath::computeNormals(vertices, indices);
+
+	std::vector<SMath::Vec4<float>> tangents(vertices.size());
+	SMath::computeTangents(vertices, indices, tangents, 3);
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		const SMath::Vec3<float> t{ tangents[i].x, tangents[i].y, tangents[i].z };
+		EXPECT_NEAR(t.length(), 1.0f, 1e-5f);
+		EXPECT_NEAR(t.dot(vertices[i].norm), 0.0f, 1e-5f);
+		EXPECT_GT(t.x, 0.0f);
+	}
+}
+TEST(MeshNormalsTest, DegenerateUvsFallBackToPerpendicular) {
+	std::vector<SMath::Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	makeGrid(2, vertices, indices);
+	for (SMath::Vertex& v : vertices) v.texCoord = { 0.5f, 0.5f };
+	SMath::computeNormals(vertices, indices);
+
+	std::vector<SMath::Vec4<float>> tangents(vertices.size());
+	SMath::computeTangents(vertices, indices, tangents);
+	for (const SMath::Vec4<float>& t : tangents) {
+		EXPECT_NEAR(t.x * t.x + t.y * t.y + t.z * t.z, 1.0f, 1e-6f);
+		EXPECT_NEAR(t.z, 0.0f, 1e-6f);
+	}
+}
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include "starlet-math/quat.hpp"
+#include "test_helpers.hpp"
+
+#include <random>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	// q and -q are the same rotation
+	void expectSameRotation(const SMath::Quat<float>& a, const SMath::Quat<float>& b, float tolerance) {
+		EXPECT_NEAR(std::abs(a.dot(b)), 1.0f, tolerance);
+	}
+
+	std::vector<SMath::Quat<float>> randomQuats(size_t n, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+		std::vector<SMath::Quat<float>> quats(n);
+		for (auto& q : quats) q = SMath::Quat<float>::fromEuler({ angle(rng), angle(rng), angle(rng) });
+		return quats;
+	}
+}
+
+TEST(QuatTest, DefaultIsIdentity) {
+	SMath::Quat<float> q;
+	EXPECT_EQ(q, SMath::Quat<float>::identity());
+	expectMatNear(q.toMat4(), SMath::Mat4::identity(), 0.0f);
+}
+
+TEST(QuatTest, FromEulerMatchesRotationMatrices) {
+	const SMath::Vec3<float> angles[] = { { 30.0f, 0.0f, 0.0f }, { 0.0f, 45.0f, 0.0f }, { 0.0f, 0.0f, -60.0f }, { 25.0f, -70.0f, 130.0f } };
+	for (const auto& a : angles) {
+		const SMath::Mat4 expected = SMath::Mat4::rotateX(a.x) * SMath::Mat4::rotateY(a.y) * SMath::Mat4::rotateZ(a.z);
+		expectMatNear(SMath::Quat<float>::fromEuler(a).toMat4(), expected, 1e-5f);
+	}
+}
+
+TEST(QuatTest, ToEulerRoundTrip) {
+	for (const auto& q : randomQuats(64, 2)) {
+		const SMath::Vec3<float> e = q.toEuler();
+		EXPECT_LE(std::abs(e.y), 90.0f);
+		expectSameRotation(SMath::Quat<float>::fromEuler(e), q, 1e-5f);
+	}
+	// Gimbal lock folds z into x
+	const SMath::Quat<float> locked = SMath::Quat<float>::fromEuler({ 20.0f, 90.0f, 15.0f });
+	const SMath::Vec3<float> e = locked.toEuler();
+	EXPECT_NEAR(e.y, 90.0f, 1e-2f);
+	EXPECT_EQ(e.z, 0.0f);
+	expectSameRotation(SMath::Quat<float>::fromEuler(e), locked, 1e-5f);
+}
+
+TEST(QuatTest, FromMat4RoundTrip) {
+	for (const auto& q : randomQuats(64, 1)) {
+		expectSameRotation(SMath::Quat<float>::fromMat4(q.toMat4()), q, 1e-5f);
+
+		// Scale in the matrix is ignored
+		SMath::Mat4 scaled = q.toMat4() * SMath::Mat4::size({ 2.0f, 0.5f, 3.0f });
+		expectSameRotation(SMath::Quat<float>::fromMat4(scaled), q, 1e-5f);
+	}
+}
+
+TEST(QuatTest, MultiplyComposesLikeMatrices) {
+	const auto a = randomQuats(16, 2), b = randomQuats(16, 3);
+	for (size_t i = 0; i < a.size(); ++i)
+		expectMatNear((a[i] * b[i]).toMat4(), a[i].toMat4() * b[i].toMat4(), 1e-5f);
+}
+
+TEST(QuatTest, RotateVectorMatchesMatrix) {
+	const SMath::Vec3<float> v{ 1.0f, -2.0f, 0.5f };
+	for (const auto& q : randomQuats(16, 4)) {
+		const SMath::Vec3<float> r = q * v;
+		const SMath::Vec4<float> expected = q.toMat4() * SMath::Vec4<float>{ v.x, v.y, v.z, 0.0f };
+		EXPECT_NEAR(r.x, expected.x, 1e-5f);
+		EXPECT_NEAR(r.y, expected.y, 1e-5f);
+		EXPECT_NEAR(r.z, expected.z, 1e-5f);
+	}
+}
+
+TEST(QuatTest, InverseUndoesRotation) {
+	for (const auto& q : randomQuats(16, 5)) {
+		expectSameRotation(q * q.inverse(), SMath::Quat<float>(), 1e-5f);
+		expectSameRotation(q.conjugate(), q.inverse(), 1e-5f);
+	}
+}
+
+TEST(QuatTest, Slerp) {
+	const auto a = SMath::Quat<float>::fromAxisAngle({ 0.0f, 1.0f, 0.0f }, 0.0f);
+	const auto b = SMath::Quat<float>::fromAxisAngle({ 0.0f, 1.0f, 0.0f }, 90.0f);
+
+	expectSameRotation(SMath::Quat<float>::slerp(a, b, 0.0f), a, 1e-6f);
+	expectSameRotation(SMath::Quat<float>::slerp(a, b, 1.0f), b, 1e-6f);
+	expectSameRotation(SMath::Quat<float>::slerp(a, b, 0.5f), SMath::Quat<float>::fromAxisAngle({ 0.0f, 1.0f, 0.0f }, 45.0f), 1e-6f);
+
+	// -b is the same rotation, slerp still takes the short way
+	const SMath::Quat<float> negB{ -b.x, -b.y, -b.z, -b.w };
+	expectSameRotation(SMath::Quat<float>::slerp(a, negB, 0.5f), SMath::Quat<float>::fromAxisAngle({ 0.0f, 1.0f, 0.0f }, 45.0f), 1e-6f);
+}
+
+TEST(QuatTest, NlerpIsNormalized) {
+	const auto a = randomQuats(16, 6), b = randomQuats(16, 7);
+	for (size_t i = 0; i < a.size(); ++i)
+		EXPECT_NEAR(SMath::Quat<float>::nlerp(a[i], b[i], 0.3f).length(), 1.0f, 1e-6f);
+}
+
+TEST(QuatTest, BatchKernelsMatchScalar) {
+	// 19 is not a multiple of 4, so the scalar tail runs too
+	const auto a = randomQuats(19, 8), b = randomQuats(19, 9);
+	std::vector<SMath::Quat<float>> out(a.size());
+
+	SMath::multiplyBatch(a, b, out);
+	for (size_t i = 0; i < a.size(); ++i) {
+		const auto expected = a[i] * b[i];
+		EXPECT_NEAR(out[i].dot(expected), 1.0f, 1e-5f) << "quat " << i;
+	}
+
+	SMath::nlerpBatch(a, b, 0.25f, out);
+	for (size_t i = 0; i < a.size(); ++i) {
+		const auto expected = SMath::Quat<float>::nlerp(a[i], b[i], 0.25f);
+		EXPECT_NEAR(out[i].dot(expected), 1.0f, 1e-5f) << "quat " << i;
+	}
+
+	std::vector<SMath::Mat4> mats(a.size());
+	SMath::toMat4Batch(a, mats.data());
+	for (size_t i = 0; i < a.size(); ++i) expectMatNear(mats[i], a[i].toMat4(), 1e-6f);
+}
+
+TEST(QuatTest, NormalizeSlerpAndFromMat4BatchesMatchScalar) {
+	auto a = randomQuats(19, 10);
+	const auto b = randomQuats(19, 11);
+	// Nearly equal pairs take the nlerp fallback lane, a zero quaternion the identity lane
+	a[5] = SMath::Quat<float>::nlerp(b[5], b[5] * SMath::Quat<float>::fromEuler({ 0.5f, 0.0f, 0.0f }), 1.0f);
+	// Near half turns make x, y and z the largest component, covering every fromMat4 branch
+	a[0] = SMath::Quat<float>::fromAxisAngle({ 1.0f, 0.0f, 0.0f }, 170.0f);
+	a[1] = SMath::Quat<float>::fromAxisAngle({ 0.0f, 1.0f, 0.0f }, 170.0f);
+	a[3] = SMath::Quat<float>::fromAxisAngle({ 0.0f, 0.0f, 1.0f }, 170.0f);
+	std::vector<SMath::Quat<float>> out(a.size());
+
+	for (float t : { 0.0f, 0.3f, 1.0f }) {
+		SMath::slerpBatch(a, b, t, out);
+		for (size_t i = 0; i < a.size(); ++i) {
+			const auto expected = SMath::Quat<float>::slerp(a[i], b[i], t);
+			EXPECT_NEAR(out[i].x, expected.x, 2e-6f) << "quat " << i << " t " << t;
+			EXPECT_NEAR(out[i].y, expected.y, 2e-6f) << "quat " << i << " t " << t;
+			EXPECT_NEAR(out[i].z, expected.z, 2e-6f) << "quat " << i << " t " << t;
+			EXPECT_NEAR(out[i].w, expected.w, 2e-6f) << "quat " << i << " t " << t;
+		}
+	}
+
+	std::vector<SMath::Quat<float>> scaled(a.size());
+	for (size_t i = 0; i < a.size(); ++i) scaled[i] = { a[i].x * 3.0f, a[i].y * 3.0f, a[i].z * 3.0f, a[i].w * 3.0f };
+	scaled[2] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	SMath::normalizeBatch(scaled, out);
+	for (size_t i = 0; i < a.size(); ++i) {
+		const auto expected = scaled[i].normalized();
+		EXPECT_NEAR(out[i].x, expected.x, 1e-6f);
+		EXPECT_NEAR(out[i].y, expected.y, 1e-6f);
+		EXPECT_NEAR(out[i].z, expected.z, 1e-6f);
+		EXPECT_NEAR(out[i].w, expected.w, 1e-6f);
+	}
+	EXPECT_EQ(out[2], SMath::Quat<float>::identity());
+
+	// Scaled rotations so the column normalization matters
+	std::vector<SMath::Mat4> mats(a.size());
+	for (size_t i = 0; i < a.size(); ++i) mats[i] = a[i].toMat4() * SMath::Mat4::size({ 2.0f, 0.5f, 3.0f });
+	SMath::fromMat4Batch(mats.data(), out);
+	for (size_t i = 0; i < a.size(); ++i) {
+		const auto expected = SMath::Quat<float>::fromMat4(mats[i]);
+		EXPECT_NEAR(out[i].dot(expected), 1.0f, 1e-5f) << "quat " << i;
+		expectSameRotation(out[i], a[i], 1e-5f);
+	}
+}
+TEST(QuatTest, DoubleFromEulerKeepsDoublePrecision) {
+	const auto q = SMath::Quat<double>::fromEuler({ 0.0, 0.0, 90.0 });
+	EXPECT_NEAR(q.z, std::sqrt(0.5), 1e-15);
+	EXPECT_NEAR(q.w, std::sqrt(0.5), 1e-15);
+	const auto r = SMath::Quat<double>::fromAxisAngle({ 0.0, 0.0, 1.0 }, 90.0);
+	EXPECT_NEAR(r.z, std::sqrt(0.5), 1e-15);
+}
+
+TEST(QuatTest, QuatTransformMatchesEulerTransform) {
+	SMath::Transform t;
+	t.pos = { 1.0f, -2.0f, 3.0f, 1.0f };
+	t.rot = { 20.0f, -35.0f, 110.0f };
+	t.size = { 2.0f, 0.5f, 1.5f };
+
+	const SMath::QuatTransform qt = SMath::QuatTransform::fromTransform(t);
+	expectMatNear(qt.modelMatrix(), SMath::Mat4::modelMatrix(t), 1e-5f);
+}
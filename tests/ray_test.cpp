@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include "starlet-math/ray.hpp"
+
+#include <random>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	struct Soup {
+		std::vector<SMath::Vertex> vertices;
+		std::vector<std::uint32_t> indices;
+	};
+
+	Soup randomTriangles(size_t triangles, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> center(-20.0f, 20.0f);
+		std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+
+		Soup soup;
+		for (size_t t = 0; t < triangles; ++t) {
+			const SMath::Vec3<float> c{ center(rng), center(rng), center(rng) };
+			for (int k = 0; k < 3; ++k) {
+				SMath::Vertex v;
+				v.pos = c + SMath::Vec3<float>(offset(rng), offset(rng), offset(rng));
+				soup.indices.push_back(static_cast<std::uint32_t>(soup.vertices.size()));
+				soup.vertices.push_back(v);
+			}
+		}
+		return soup;
+	}
+
+	std::vector<SMath::Ray> randomRays(size_t n, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> d(-1.0f, 1.0f);
+		std::vector<SMath::Ray> rays(n);
+		for (SMath::Ray& r : rays) {
+			r.origin = { 20.0f * d(rng), 20.0f * d(rng), 40.0f };
+			r.dir = SMath::Vec3<float>(0.5f * d(rng), 0.5f * d(rng), -1.0f).normalized();
+		}
+		return rays;
+	}
+
+	// Plain scalar Moller-Trumbore loop over every triangle
+	SMath::RayHit bruteForce(const Soup& soup, const SMath::Ray& ray) {
+		SMath::RayHit best;
+		best.t = ray.tMax;
+		for (std::uint32_t tri = 0; tri < soup.indices.size() / 3; ++tri) {
+			SMath::Ray clipped = ray;
+			clipped.tMax = best.t;
+			float t, u, v;
+			if (SMath::intersectTriangle(clipped, soup.vertices[soup.indices[tri * 3]].pos, soup.vertices[soup.indices[tri * 3 + 1]].pos,
+			                             soup.vertices[soup.indices[tri * 3 + 2]].pos, t, u, v))
+				best = { t, u, v, tri };
+		}
+		return best;
+	}
+
+	std::vector<SMath::Kernels::Isa> supportedIsas() {
+		std::vector<SMath::Kernels::Isa> isas;
+		for (SMath::Kernels::Isa isa : { SMath::Kernels::Isa::Scalar, SMath::Kernels::Isa::Sse2, SMath::Kernels::Isa::Avx2Fma })
+			if (SMath::Kernels::isaSupported(isa)) isas.push_back(isa);
+		return isas;
+	}
+}
+
+TEST(RayTest, TriangleHitAndBarycentrics) {
+	const SMath::Vec3<float> a{ 0, 0, 0 }, b{ 1, 0, 0 }, c{ 0, 1, 0 };
+	SMath::Ray ray;
+	ray.origin = { 0.25f, 0.5f, 2.0f };
+	ray.dir = { 0.0f, 0.0f, -1.0f };
+
+	float t, u, v;
+	ASSERT_TRUE(SMath::intersectTriangle(ray, a, b, c, t, u, v));
+	EXPECT_FLOAT_EQ(t, 2.0f);
+	EXPECT_FLOAT_EQ(u, 0.25f);
+	EXPECT_FLOAT_EQ(v, 0.5f);
+
+	// Two-sided
+	ray.origin.z = -2.0f;
+	ray.dir.z = 1.0f;
+	EXPECT_TRUE(SMath::intersectTriangle(ray, a, b, c, t, u, v));
+}
+TEST(RayTest, TriangleMisses) {
+	const SMath::Vec3<float> a{ 0, 0, 0 }, b{ 1, 0, 0 }, c{ 0, 1, 0 };
+	float t, u, v;
+
+	SMath::Ray outside{ { 0.75f, 0.75f, 1.0f }, { 0.0f, 0.0f, -1.0f } };
+	EXPECT_FALSE(SMath::intersectTriangle(outside, a, b, c, t, u, v));
+
+	SMath::Ray parallel{ { 0.1f, 0.1f, 1.0f }, { 1.0f, 0.0f, 0.0f } };
+	EXPECT_FALSE(SMath::intersectTriangle(parallel, a, b, c, t, u, v));
+
+	SMath::Ray behind{ { 0.1f, 0.1f, 1.0f }, { 0.0f, 0.0f, 1.0f } };
+	EXPECT_FALSE(SMath::intersectTriangle(behind, a, b, c, t, u, v));
+
+	SMath::Ray tooShort{ { 0.1f, 0.1f, 1.0f }, { 0.0f, 0.0f, -1.0f }, 0.0f, 0.5f };
+	EXPECT_FALSE(SMath::intersectTriangle(tooShort, a, b, c, t, u, v));
+}
+
+TEST(RayTest, AABBSlabs) {
+	const SMath::AABB box{ { -1, -1, -1 }, { 1, 1, 1 } };
+	EXPECT_TRUE(SMath::intersectAABB(SMath::Ray{ { 0, 0, 5 }, { 0, 0, -1 } }, box));
+	EXPECT_TRUE(SMath::intersectAABB(SMath::Ray{ { 0, 0, 0 }, { 1, 0, 0 } }, box));
+	EXPECT_FALSE(SMath::intersectAABB(SMath::Ray{ { 0, 2, 5 }, { 0, 0, -1 } }, box));
+	EXPECT_FALSE(SMath::intersectAABB(SMath::Ray{ { 0, 0, 5 }, { 0, 0, 1 } }, box));
+	EXPECT_FALSE(SMath::intersectAABB(SMath::Ray{ { 0, 0, 5 }, { 0, 0, -1 }, 0.0f, 3.0f }, box));
+
+	float tNear;
+	const SMath::Ray ray{ { 0, 0, 5 }, { 0, 0, -2 } };
+	ASSERT_TRUE(SMath::intersectAABB(ray, ray.invDir(), box, tNear, ray.tMax));
+	EXPECT_FLOAT_EQ(tNear, 2.0f);
+}
+TEST(RayTest, AABBPacketMatchesScalar) {
+	const std::vector<SMath::Ray> rays = randomRays(64, 3);
+	const SMath::AABB box{ { -10, -10, -5 }, { 10, 10, 5 } };
+
+	for (size_t i = 0; i < rays.size(); i += 4) {
+		for (size_t count : { 4u, 3u }) {
+			const SMath::RayPacket4 packet(std::span<const SMath::Ray>(rays).subspan(i, count));
+			SMath::Simd::Float4 tNear;
+			const int mask = SMath::intersectAABB(packet, box, tNear);
+			for (size_t k = 0; k < 4; ++k) {
+				const bool expected = k < count && SMath::intersectAABB(rays[i + k], box);
+				EXPECT_EQ((mask >> k) & 1, expected ? 1 : 0);
+			}
+		}
+	}
+}
+
+TEST(RayTest, PacketsMatchScalarOnEveryIsa) {
+	const Soup soup = randomTriangles(203, 1);
+	const std::vector<SMath::TrianglePacket> packets = SMath::packTriangles(soup.vertices, soup.indices);
+	ASSERT_EQ(packets.size(), 26u);
+
+	int hits = 0;
+	for (const SMath::Ray& ray : randomRays(300, 2)) {
+		const SMath::RayHit expected = bruteForce(soup, ray);
+		hits += expected.hit();
+		for (SMath::Kernels::Isa isa : supportedIsas()) {
+			const SMath::RayHit hit = SMath::raycast(packets, ray, isa);
+			ASSERT_EQ(hit.triangle, expected.triangle);
+			if (hit.hit()) {
+				EXPECT_NEAR(hit.t, expected.t, 1e-4f);
+				EXPECT_NEAR(hit.u, expected.u, 1e-4f);
+				EXPECT_NEAR(hit.v, expected.v, 1e-4f);
+			}
+		}
+	}
+	EXPECT_GT(hits, 15);
+}
+
+TEST(RayTest, MeshRaycasterMatchesBruteForce) {
+	const Soup soup = randomTriangles(2000, 4);
+	const SMath::MeshRaycaster rc = SMath::MeshRaycaster::build(soup.vertices, soup.indices);
+	const std::vector<SMath::Ray> rays = randomRays(500, 5);
+
+	std::vector<SMath::RayHit> batch(rays.size());
+	rc.raycast(rays, batch);
+
+	for (size_t i = 0; i < rays.size(); ++i) {
+		const SMath::RayHit expected = bruteForce(soup, rays[i]);
+		const SMath::RayHit hit = rc.raycast(rays[i]);
+		ASSERT_EQ(hit.triangle, expected.triangle);
+		ASSERT_EQ(batch[i].triangle, expected.triangle);
+		if (hit.hit()) {
+			EXPECT_NEAR(hit.t, expected.t, 1e-4f);
+			EXPECT_NEAR(batch[i].t, expected.t, 1e-4f);
+		}
+		EXPECT_EQ(rc.occluded(rays[i]), expected.hit());
+	}
+}
+TEST(RayTest, MeshRaycasterRespectsRayLimits) {
+	Soup soup;
+	for (float z : { 0.0f, -5.0f }) {
+		for (const SMath::Vec3<float>& p : { SMath::Vec3<float>(-1, -1, z), SMath::Vec3<float>(1, -1, z), SMath::Vec3<float>(0, 1, z) }) {
+			SMath::Vertex v;
+			v.pos = p;
+			soup.indices.push_back(static_cast<std::uint32_t>(soup.vertices.size()));
+			soup.vertices.push_back(v);
+		}
+	}
+	const SMath::MeshRaycaster rc = SMath::MeshRaycaster::build(soup.vertices, soup.indices);
+
+	SMath::Ray ray{ { 0, 0, 10 }, { 0, 0, -1 } };
+	EXPECT_EQ(rc.raycast(ray).triangle, 0u);
+	EXPECT_FLOAT_EQ(rc.raycast(ray).t, 10.0f);
+
+	ray.tMin = 11.0f;
+	EXPECT_EQ(rc.raycast(ray).triangle, 1u);
+
+	ray.tMax = 14.0f;
+	EXPECT_FALSE(rc.raycast(ray).hit());
+	EXPECT_FALSE(rc.occluded(ray));
+
+	const SMath::MeshRaycaster empty = SMath::MeshRaycaster::build({}, {});
+	EXPECT_FALSE(empty.raycast(ray).hit());
+}
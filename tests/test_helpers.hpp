@@ -0,0 +1,10 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include "starlet-math/mat4.hpp"
+
+// Element-wise EXPECT_NEAR over all sixteen entries, reports the first index that differs
+inline void expectMatNear(const Starlet::Math::Mat4& a, const Starlet::Math::Mat4& b, float tolerance) {
+	for (int i = 0; i < 16; ++i)
+		EXPECT_NEAR(a.models[i], b.models[i], tolerance) << "element " << i;
+}
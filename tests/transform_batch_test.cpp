@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "starlet-math/transform_batch.hpp"
+#include "test_helpers.hpp"
+
+#include <random>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	SMath::Transform randomTransform(std::mt19937& rng) {
+		std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> rot(-360.0f, 360.0f);
+		std::uniform_real_distribution<float> size(0.1f, 10.0f);
+
+		SMath::Transform t;
+		t.pos = { pos(rng), pos(rng), pos(rng), 1.0f };
+		t.rot = { rot(rng), rot(rng), rot(rng) };
+		t.size = { size(rng), size(rng), size(rng) };
+		return t;
+	}
+}
+
+TEST(TransformBatchTest, PushAndGet) {
+	SMath::TransformBatch batch;
+	SMath::Transform t;
+	t.pos = { 1.0f, 2.0f, 3.0f, 1.0f };
+	t.rot = { 10.0f, 20.0f, 30.0f };
+	t.size = { 4.0f, 5.0f, 6.0f };
+	batch.push(t);
+
+	ASSERT_EQ(batch.count(), 1u);
+	SMath::Transform back = batch.get(0);
+	ASSERT_FLOAT_EQ(back.pos.x, 1.0f); ASSERT_FLOAT_EQ(back.pos.y, 2.0f); ASSERT_FLOAT_EQ(back.pos.z, 3.0f);
+	ASSERT_FLOAT_EQ(back.rot.x, 10.0f); ASSERT_FLOAT_EQ(back.rot.y, 20.0f); ASSERT_FLOAT_EQ(back.rot.z, 30.0f);
+	ASSERT_FLOAT_EQ(back.size.x, 4.0f); ASSERT_FLOAT_EQ(back.size.y, 5.0f); ASSERT_FLOAT_EQ(back.size.z, 6.0f);
+}
+TEST(TransformBatchTest, ResizeDefaultsToIdentity) {
+	SMath::TransformBatch batch;
+	batch.resize(3);
+
+	SMath::Mat4 out[3];
+	SMath::buildModelMatrices(batch, out);
+	for (const SMath::Mat4& m : out)
+		expectMatNear(m, SMath::Mat4::identity(), 0.0f);
+}
+
+TEST(TransformBatchTest, MatchesModelMatrix) {
+	std::mt19937 rng(1234);
+	SMath::TransformBatch batch;
+	std::vector<SMath::Transform> transforms;
+	for (int i = 0; i < 64; ++i) {
+		transforms.push_back(randomTransform(rng));
+		batch.push(transforms.back());
+	}
+
+	std::vector<SMath::Mat4> out(batch.count());
+	SMath::buildModelMatrices(batch, out.data());
+	for (size_t i = 0; i < transforms.size(); ++i)
+		expectMatNear(out[i], SMath::Mat4::modelMatrix(transforms[i]), 1e-4f);
+}
+TEST(TransformBatchTest, PartialBlock) {
+	std::mt19937 rng(99);
+	for (size_t n = 1; n <= 7; ++n) {
+		SMath::TransformBatch batch;
+		std::vector<SMath::Transform> transforms;
+		for (size_t i = 0; i < n; ++i) {
+			transforms.push_back(randomTransform(rng));
+			batch.push(transforms.back());
+		}
+
+		// One extra slot to catch writes past the end
+		std::vector<SMath::Mat4> out(n + 1);
+		SMath::buildModelMatrices(batch, out.data());
+		for (size_t i = 0; i < n; ++i)
+			expectMatNear(out[i], SMath::Mat4::modelMatrix(transforms[i]), 1e-4f);
+		ASSERT_TRUE(out[n] == SMath::Mat4{});
+	}
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "starlet-math/transform_hierarchy.hpp"
+#include "test_helpers.hpp"
+
+#include <random>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	SMath::Transform translated(float x, float y, float z) {
+		SMath::Transform t;
+		t.pos = { x, y, z, 1.0f };
+		return t;
+	}
+
+	// Recomputes every world matrix from scratch by walking up the parent chain
+	SMath::Mat4 bruteForceWorld(const SMath::TransformHierarchy& h, std::uint32_t i) {
+		SMath::Mat4 world = SMath::Mat4::modelMatrix(h.local(i));
+		for (std::uint32_t p = h.parent(i); p != SMath::TransformHierarchy::NoParent; p = h.parent(p))
+			world = SMath::Mat4::modelMatrix(h.local(p)) * world;
+		return world;
+	}
+
+	SMath::TransformHierarchy randomHierarchy(size_t n, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> dist(-5.0f, 5.0f);
+		std::uniform_real_distribution<float> angle(-90.0f, 90.0f);
+
+		SMath::TransformHierarchy h;
+		for (size_t i = 0; i < n; ++i) {
+			SMath::Transform t;
+			t.pos = { dist(rng), dist(rng), dist(rng), 1.0f };
+			t.rot = { angle(rng), angle(rng), angle(rng) };
+			const std::uint32_t parent = i == 0 ? SMath::TransformHierarchy::NoParent : static_cast<std::uint32_t>(rng() % i);
+			h.add(t, parent);
+		}
+		return h;
+	}
+}
+
+TEST(TransformHierarchyTest, ChainOfTranslations) {
+	SMath::TransformHierarchy h;
+	const std::uint32_t root = h.add(translated(1.0f, 0.0f, 0.0f));
+	const std::uint32_t child = h.add(translated(0.0f, 2.0f, 0.0f), root);
+	const std::uint32_t grandchild = h.add(translated(0.0f, 0.0f, 3.0f), child);
+
+	ASSERT_EQ(h.update(), 3u);
+	const SMath::Mat4& w = h.world(grandchild);
+	ASSERT_FLOAT_EQ(w.models[12], 1.0f); ASSERT_FLOAT_EQ(w.models[13], 2.0f); ASSERT_FLOAT_EQ(w.models[14], 3.0f);
+	ASSERT_EQ(h.depth(grandchild), 2u);
+}
+TEST(TransformHierarchyTest, OnlyDirtySubtreesRecompute) {
+	SMath::TransformHierarchy h;
+	const std::uint32_t a = h.add(translated(1.0f, 0.0f, 0.0f));
+	const std::uint32_t b = h.add(translated(0.0f, 1.0f, 0.0f));
+	const std::uint32_t a1 = h.add(translated(0.0f, 0.0f, 1.0f), a);
+	h.add(translated(0.0f, 0.0f, 1.0f), b);
+	h.update();
+
+	ASSERT_EQ(h.update(), 0u);
+
+	h.setLocal(a, translated(5.0f, 0.0f, 0.0f));
+	ASSERT_EQ(h.update(), 2u);
+	ASSERT_FLOAT_EQ(h.world(a1).models[12], 5.0f);
+	ASSERT_FLOAT_EQ(h.world(a1).models[14], 1.0f);
+}
+TEST(TransformHierarchyTest, MatchesBruteForce) {
+	SMath::TransformHierarchy h = randomHierarchy(200, 8);
+	h.update();
+	for (std::uint32_t i = 0; i < h.size(); ++i)
+		expectMatNear(h.world(i), bruteForceWorld(h, i), 1e-3f);
+
+	h.setLocal(17, translated(9.0f, 9.0f, 9.0f));
+	h.update();
+	for (std::uint32_t i = 0; i < h.size(); ++i)
+		expectMatNear(h.world(i), bruteForceWorld(h, i), 1e-3f);
+}
+TEST(TransformHierarchyTest, SortBreadthFirst) {
+	SMath::TransformHierarchy h;
+	const std::uint32_t root = h.add(translated(1.0f, 0.0f, 0.0f));
+	const std::uint32_t child = h.add(translated(0.0f, 1.0f, 0.0f), root);
+	const std::uint32_t grandchild = h.add(translated(0.0f, 0.0f, 1.0f), child);
+	const std::uint32_t root2 = h.add(translated(2.0f, 0.0f, 0.0f));
+	ASSERT_FALSE(h.isBreadthFirst());
+
+	const std::vector<std::uint32_t> remap = h.sortBreadthFirst();
+	ASSERT_TRUE(h.isBreadthFirst());
+	ASSERT_EQ(remap[root], 0u);
+	ASSERT_EQ(remap[root2], 1u);
+	ASSERT_EQ(remap[child], 2u);
+	ASSERT_EQ(remap[grandchild], 3u);
+	ASSERT_EQ(h.parent(remap[grandchild]), remap[child]);
+
+	h.update();
+	const SMath::Mat4& w = h.world(remap[grandchild]);
+	ASSERT_FLOAT_EQ(w.models[12], 1.0f); ASSERT_FLOAT_EQ(w.models[13], 1.0f); ASSERT_FLOAT_EQ(w.models[14], 1.0f);
+}
+TEST(TransformHierarchyTest, ParallelMatchesSerial) {
+	SMath::TransformHierarchy serial = randomHierarchy(5000, 9);
+	serial.sortBreadthFirst();
+	SMath::TransformHierarchy parallel = serial;
+
+	ASSERT_EQ(serial.update(), parallel.updateParallel(4));
+	for (std::uint32_t i = 0; i < serial.size(); ++i)
+		ASSERT_TRUE(serial.world(i) == parallel.world(i));
+
+	serial.setLocal(3, translated(1.0f, 2.0f, 3.0f));
+	parallel.setLocal(3, translated(1.0f, 2.0f, 3.0f));
+	ASSERT_EQ(serial.update(), parallel.updateParallel(4));
+	for (std::uint32_t i = 0; i < serial.size(); ++i)
+		ASSERT_TRUE(serial.world(i) == parallel.world(i));
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "starlet-math/mat4.hpp"
+#include "starlet-math/vec4f.hpp"
+
+#include <cmath>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	void expectVecNear(const SMath::Vec4f& a, const SMath::Vec4<float>& b, float tolerance) {
+		EXPECT_NEAR(a.x(), b.x, tolerance);
+		EXPECT_NEAR(a.y(), b.y, tolerance);
+		EXPECT_NEAR(a.z(), b.z, tolerance);
+		EXPECT_NEAR(a.w(), b.w, tolerance);
+	}
+}
+
+TEST(Vec4fTest, LayoutAndConstruction) {
+	static_assert(alignof(SMath::Vec4f) == 16);
+	static_assert(sizeof(SMath::Vec4f) == 16);
+
+	EXPECT_EQ(SMath::Vec4f(), SMath::Vec4f(0.0f, 0.0f, 0.0f, 0.0f));
+	EXPECT_EQ(SMath::Vec4f(2.0f), SMath::Vec4f(2.0f, 2.0f, 2.0f, 2.0f));
+	EXPECT_EQ(SMath::Vec4f(SMath::Vec3<float>(1.0f, 2.0f, 3.0f), 4.0f), SMath::Vec4f(1.0f, 2.0f, 3.0f, 4.0f));
+
+	const SMath::Vec4f a(1.0f, 2.0f, 3.0f, 4.0f);
+	EXPECT_EQ(a.x(), 1.0f);
+	EXPECT_EQ(a.y(), 2.0f);
+	EXPECT_EQ(a.z(), 3.0f);
+	EXPECT_EQ(a.w(), 4.0f);
+	EXPECT_EQ(a.xyz(), SMath::Vec3<float>(1.0f, 2.0f, 3.0f));
+}
+
+TEST(Vec4fTest, ConvertsToAndFromVec4) {
+	const SMath::Vec4<float> scalar{ 1.5f, -2.0f, 3.25f, 0.5f };
+	const SMath::Vec4f simd = scalar;
+	const SMath::Vec4<float> back = simd;
+	EXPECT_EQ(back, scalar);
+}
+
+TEST(Vec4fTest, ArithmeticMatchesVec4) {
+	const SMath::Vec4<float> a{ 1.0f, -2.0f, 3.0f, 4.0f }, b{ 0.5f, 2.0f, -1.0f, 8.0f };
+	const SMath::Vec4f fa = a, fb = b;
+
+	expectVecNear(fa + fb, a + b, 0.0f);
+	expectVecNear(fa - fb, a - b, 0.0f);
+	expectVecNear(fa * fb, a * b, 0.0f);
+	expectVecNear(fa / fb, a / b, 0.0f);
+	expectVecNear(fa * 3.0f, a * 3.0f, 0.0f);
+	expectVecNear(fa / 2.0f, a / 2.0f, 0.0f);
+	expectVecNear(fa + 1.0f, a + 1.0f, 0.0f);
+	expectVecNear(fa - 1.0f, a - 1.0f, 0.0f);
+	expectVecNear(-fa, -a, 0.0f);
+
+	SMath::Vec4f c = fa;
+	c += fb; c *= 2.0f; c -= fb; c /= fb;
+	SMath::Vec4<float> expected = a;
+	expected += b; expected *= 2.0f; expected -= b; expected /= b;
+	expectVecNear(c, expected, 1e-6f);
+
+	EXPECT_FLOAT_EQ(fa.dot(fb), a.dot(b));
+	EXPECT_FLOAT_EQ(fa.length(), a.length());
+	EXPECT_FLOAT_EQ(fa.lengthSquared(), a.lengthSquared());
+	expectVecNear(fa.normalized(), a.normalized(), 1e-6f);
+	EXPECT_EQ(SMath::Vec4f().normalized(), SMath::Vec4f());
+}
+
+TEST(Vec4fTest, Swizzle) {
+	const SMath::Vec4f a(1.0f, 2.0f, 3.0f, 4.0f);
+	EXPECT_EQ((a.swizzle<3, 2, 1, 0>()), SMath::Vec4f(4.0f, 3.0f, 2.0f, 1.0f));
+	EXPECT_EQ((a.swizzle<0, 0, 2, 2>()), SMath::Vec4f(1.0f, 1.0f, 3.0f, 3.0f));
+	EXPECT_EQ(a.broadcast<1>(), SMath::Vec4f(2.0f));
+	EXPECT_EQ(SMath::min(a, a.swizzle<3, 2, 1, 0>()), SMath::Vec4f(1.0f, 2.0f, 2.0f, 1.0f));
+	EXPECT_EQ(SMath::max(a, a.swizzle<3, 2, 1, 0>()), SMath::Vec4f(4.0f, 3.0f, 3.0f, 4.0f));
+}
+
+TEST(Vec4fTest, Mat4Columns) {
+	const SMath::Mat4 m = SMath::Mat4::rotateY(30.0f) * SMath::Mat4::translation({ 1.0f, 2.0f, 3.0f, 1.0f });
+	for (int c = 0; c < 4; ++c)
+		expectVecNear(m.column(c), { m.models[c * 4], m.models[c * 4 + 1], m.models[c * 4 + 2], m.models[c * 4 + 3] }, 0.0f);
+
+	const SMath::Vec4<float> p{ 0.5f, -1.0f, 2.0f, 1.0f };
+	expectVecNear(m * SMath::Vec4f(p), m * p, 1e-6f);
+
+	SMath::Mat4 n = SMath::Mat4::identity();
+	n.setColumn(3, SMath::Vec4f(5.0f, 6.0f, 7.0f, 1.0f));
+	EXPECT_EQ(n, SMath::Mat4::translation({ 5.0f, 6.0f, 7.0f, 1.0f }));
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "starlet-math/vec_batch.hpp"
+#include "starlet-math/vec2.hpp"
+
+#include <cmath>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	// 23 is not a multiple of 4, so the scalar tail runs too
+	constexpr size_t COUNT = 23;
+
+	template<typename V>
+	std::vector<V> randomVecs(unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> d(-50.0f, 50.0f);
+		std::vector<V> out(COUNT);
+		for (V& v : out) {
+			if constexpr (std::is_same_v<V, SMath::Vec3<float>>) v = { d(rng), d(rng), d(rng) };
+			else v = { d(rng), d(rng), d(rng), d(rng) };
+		}
+		// Zero and tiny vectors take the degenerate path
+		out[1] = V(0.0f);
+		out[6] = V(1e-8f);
+		return out;
+	}
+
+	// The bulk kernels may round differently from the scalar path under FMA contraction
+	constexpr float TOL = SMath::NORMALIZE_ALL_MAX_ERROR;
+	void expectVecNear(const SMath::Vec3<float>& a, const SMath::Vec3<float>& b, const size_t i) {
+		EXPECT_NEAR(a.x, b.x, TOL) << i; EXPECT_NEAR(a.y, b.y, TOL) << i; EXPECT_NEAR(a.z, b.z, TOL) << i;
+	}
+	void expectVecNear(const SMath::Vec4<float>& a, const SMath::Vec4<float>& b, const size_t i) {
+		EXPECT_NEAR(a.x, b.x, TOL) << i; EXPECT_NEAR(a.y, b.y, TOL) << i; EXPECT_NEAR(a.z, b.z, TOL) << i; EXPECT_NEAR(a.w, b.w, TOL) << i;
+	}
+	void expectLengthNear(const float bulk, const float scalar, const size_t i) {
+		EXPECT_NEAR(bulk, scalar, scalar * SMath::LENGTH_ALL_MAX_REL_ERROR) << i;
+	}
+}
+
+TEST(VecBatchTest, FloatLengthStaysFloat) {
+	static_assert(std::is_same_v<decltype(SMath::Vec2<float>().length()), float>);
+	static_assert(std::is_same_v<decltype(SMath::Vec3<float>().length()), float>);
+	static_assert(std::is_same_v<decltype(SMath::Vec4<float>().lengthSquared()), float>);
+	static_assert(std::is_same_v<decltype(SMath::Vec3<double>().length()), double>);
+	static_assert(std::is_same_v<decltype(SMath::Vec2<int>().length()), double>);
+	static_assert(std::is_same_v<decltype(SMath::Vec4<int>().lengthSquared()), double>);
+
+	EXPECT_DOUBLE_EQ(SMath::Vec2<int>(1, 1).length(), std::sqrt(2.0));
+}
+
+TEST(VecBatchTest, LargeComponentsDoNotOverflow) {
+	// 1e20 squared is past FLT_MAX, a naive float lengthSquared() goes to inf and normalizes to zero
+	const SMath::Vec3<float> v3(3e20f, 0.0f, -4e20f);
+	EXPECT_FLOAT_EQ(v3.length(), 5e20f);
+	EXPECT_EQ(v3.normalized(), SMath::Vec3<float>(0.6f, 0.0f, -0.8f));
+
+	const SMath::Vec4<float> v4(2e30f, -2e30f, 2e30f, -2e30f);
+	EXPECT_FLOAT_EQ(v4.length(), 4e30f);
+	EXPECT_EQ(v4.normalized(), SMath::Vec4<float>(0.5f, -0.5f, 0.5f, -0.5f));
+
+	const SMath::Vec2<float> v2(0.0f, -1e25f);
+	EXPECT_FLOAT_EQ(v2.length(), 1e25f);
+	EXPECT_EQ(v2.normalized(), SMath::Vec2<float>(0.0f, -1.0f));
+
+	// One overflowing vector in a SIMD group sends the group through the scalar path
+	auto bulk = randomVecs<SMath::Vec3<float>>(3);
+	bulk[2] = v3;
+	std::vector<float> lengths(bulk.size());
+	SMath::lengthAll(bulk, lengths);
+	std::vector<SMath::Vec3<float>> out(bulk.size());
+	SMath::normalizeAll(bulk, out);
+	for (size_t i = 0; i < bulk.size(); ++i) {
+		expectLengthNear(lengths[i], bulk[i].length(), i);
+		expectVecNear(out[i], bulk[i].normalized(), i);
+	}
+	EXPECT_FLOAT_EQ(lengths[2], 5e20f);
+
+	auto bulk4 = randomVecs<SMath::Vec4<float>>(4);
+	bulk4[21] = v4;
+	std::vector<SMath::Vec4<float>> out4(bulk4.size());
+	SMath::normalizeAll(bulk4, out4);
+	EXPECT_EQ(out4[21], SMath::Vec4<float>(0.5f, -0.5f, 0.5f, -0.5f));
+	bulk4[5] = v4;
+	SMath::normalizeAll(bulk4, out4);
+	EXPECT_EQ(out4[5], SMath::Vec4<float>(0.5f, -0.5f, 0.5f, -0.5f));
+	std::vector<float> lengths4(bulk4.size());
+	SMath::lengthAll(bulk4, lengths4);
+	EXPECT_FLOAT_EQ(lengths4[5], 4e30f);
+}
+
+TEST(VecBatchTest, Vec3MatchesScalar) {
+	const auto v = randomVecs<SMath::Vec3<float>>(1);
+
+	std::vector<float> lengths(v.size());
+	SMath::lengthAll(v, lengths);
+	for (size_t i = 0; i < v.size(); ++i) expectLengthNear(lengths[i], v[i].length(), i);
+
+	std::vector<SMath::Vec3<float>> out(v.size());
+	SMath::normalizeAll(v, out);
+	for (size_t i = 0; i < v.size(); ++i) expectVecNear(out[i], v[i].normalized(), i);
+
+	auto inPlace = v;
+	SMath::normalizeAll(std::span<SMath::Vec3<float>>(inPlace));
+	EXPECT_EQ(inPlace, out);
+}
+
+TEST(VecBatchTest, Vec4MatchesScalar) {
+	const auto v = randomVecs<SMath::Vec4<float>>(2);
+
+	std::vector<float> lengths(v.size());
+	SMath::lengthAll(v, lengths);
+	for (size_t i = 0; i < v.size(); ++i) expectLengthNear(lengths[i], v[i].length(), i);
+
+	std::vector<SMath::Vec4<float>> out(v.size());
+	SMath::normalizeAll(v, out);
+	for (size_t i = 0; i < v.size(); ++i) expectVecNear(out[i], v[i].normalized(), i);
+
+	auto inPlace = v;
+	SMath::normalizeAll(std::span<SMath::Vec4<float>>(inPlace));
+	for (size_t i = 0; i < v.size(); ++i) EXPECT_EQ(inPlace[i], out[i]) << i;
+}
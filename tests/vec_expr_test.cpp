@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include "starlet-math/vec_expr.hpp"
+
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+namespace Expr = Starlet::Math::Expr;
+
+namespace {
+	template<typename V>
+	std::vector<V> randomVectors(size_t n, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> d(0.5f, 4.0f);
+		std::vector<V> out(n);
+		for (V& v : out)
+			for (size_t c = 0; c < sizeof(V) / sizeof(v.x); ++c) (&v.x)[c] = static_cast<std::remove_reference_t<decltype(v.x)>>(d(rng));
+		return out;
+	}
+}
+
+TEST(VecExprTest, EvalMatchesOperators) {
+	const SMath::Vec3<float> a{ 1.0f, 2.0f, 3.0f }, b{ -4.0f, 0.5f, 2.0f }, c{ 0.25f, 8.0f, -1.0f }, d{ 2.0f, 4.0f, 0.5f };
+	const float s = 1.5f;
+
+	const SMath::Vec3<float> lazy = Expr::eval(Expr::lazy(a) + b * s - c / d);
+	const SMath::Vec3<float> plain = a + b * s - c / d;
+	EXPECT_FLOAT_EQ(lazy.x, plain.x);
+	EXPECT_FLOAT_EQ(lazy.y, plain.y);
+	EXPECT_FLOAT_EQ(lazy.z, plain.z);
+
+	const SMath::Vec3<float> negated = Expr::eval(-(Expr::lazy(a) - 1.0f) * 2.0);
+	EXPECT_EQ(negated, SMath::Vec3<float>(0.0f, -2.0f, -4.0f));
+	static_assert(std::is_same_v<decltype(negated), const SMath::Vec3<float>>);
+}
+TEST(VecExprTest, AllVectorSizesAndDouble) {
+	const SMath::Vec2<float> v2 = Expr::eval(Expr::lazy(SMath::Vec2<float>{ 1.0f, 2.0f }) * 3.0f + 1.0f);
+	EXPECT_EQ(v2.x, 4.0f);
+	EXPECT_EQ(v2.y, 7.0f);
+
+	const SMath::Vec4<double> a{ 1.0, 2.0, 3.0, 4.0 }, b{ 0.5, 0.5, 0.5, 0.5 };
+	const SMath::Vec4<double> v4 = Expr::eval(Expr::lazy(a) * b - a / 2);
+	for (int c = 0; c < 4; ++c) EXPECT_DOUBLE_EQ((&v4.x)[c], 0.0);
+}
+TEST(VecExprTest, MultiplyAddFuses) {
+	const auto e = Expr::lazy(SMath::Vec3<float>(1.0f)) * 2.0f + SMath::Vec3<float>(3.0f);
+	static_assert(std::is_same_v<std::remove_cv_t<decltype(e)>,
+		Expr::FusedMulAdd<Expr::VecNode<SMath::Vec3<float>>, Expr::ScalarNode<float>, Expr::VecNode<SMath::Vec3<float>>>>);
+	EXPECT_EQ(Expr::eval(e), SMath::Vec3<float>(5.0f));
+
+	// c - a * b and a * b - c fuse too
+	EXPECT_EQ(Expr::eval(SMath::Vec3<float>(10.0f) - Expr::lazy(SMath::Vec3<float>(2.0f)) * 3.0f), SMath::Vec3<float>(4.0f));
+	EXPECT_EQ(Expr::eval(Expr::lazy(SMath::Vec3<float>(2.0f)) * 3.0f - 10.0f), SMath::Vec3<float>(-4.0f));
+}
+TEST(VecExprTest, AssignSpansMatchesLoop) {
+	// 1001 Vec3s is 3003 floats, not a multiple of the SIMD width
+	const auto a = randomVectors<SMath::Vec3<float>>(1001, 1), b = randomVectors<SMath::Vec3<float>>(1001, 2), c = randomVectors<SMath::Vec3<float>>(1001, 3);
+	std::vector<SMath::Vec3<float>> out(a.size());
+	Expr::assign(out, Expr::lazy(a) * 0.5f + b - c / Expr::lazy(a));
+
+	for (size_t i = 0; i < a.size(); ++i) {
+		const SMath::Vec3<float> expected = a[i] * 0.5f + b[i] - c[i] / a[i];
+		EXPECT_NEAR(out[i].x, expected.x, 1e-5f);
+		EXPECT_NEAR(out[i].y, expected.y, 1e-5f);
+		EXPECT_NEAR(out[i].z, expected.z, 1e-5f);
+	}
+}
+TEST(VecExprTest, AssignBroadcastsSingleVectors) {
+	const auto p = randomVectors<SMath::Vec4<double>>(33, 4);
+	const SMath::Vec4<double> offset{ 1.0, -1.0, 2.0, 0.0 };
+	std::vector<SMath::Vec4<double>> out(p.size());
+	Expr::assign(out, Expr::lazy(p) * 2.0 + offset);
+	for (size_t i = 0; i < p.size(); ++i) {
+		EXPECT_DOUBLE_EQ(out[i].x, p[i].x * 2.0 + 1.0);
+		EXPECT_DOUBLE_EQ(out[i].w, p[i].w * 2.0);
+	}
+}
+TEST(VecExprTest, AssignInPlace) {
+	auto pos = randomVectors<SMath::Vec3<float>>(50, 5);
+	const auto vel = randomVectors<SMath::Vec3<float>>(50, 6);
+	const auto before = pos;
+	Expr::assign(pos, Expr::lazy(vel) * 0.25f + Expr::lazy(pos));
+	for (size_t i = 0; i < pos.size(); ++i) EXPECT_NEAR(pos[i].y, before[i].y + vel[i].y * 0.25f, 1e-6f);
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "starlet-math/vertex_packed.hpp"
+
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	std::vector<SMath::Vertex> randomVertices(size_t n, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> pos(-50.0f, 50.0f), unit(0.0f, 1.0f), dir(-1.0f, 1.0f), uv(-4.0f, 4.0f);
+
+		std::vector<SMath::Vertex> vertices(n);
+		for (SMath::Vertex& v : vertices) {
+			v.pos = { pos(rng), pos(rng), pos(rng) };
+			v.col = { unit(rng), unit(rng), unit(rng), unit(rng) };
+			v.norm = SMath::Vec3<float>(dir(rng), dir(rng), dir(rng)).normalized();
+			v.texCoord = { uv(rng), uv(rng) };
+		}
+		return vertices;
+	}
+
+	float angleBetween(const SMath::Vec3<float>& a, const SMath::Vec3<float>& b) {
+		const SMath::Vec3<float> c = a.cross(b);
+		return std::atan2(std::sqrt(c.x * c.x + c.y * c.y + c.z * c.z), a.dot(b));
+	}
+
+	void expectSameVertex(const SMath::Vertex& a, const SMath::Vertex& b) {
+		EXPECT_FLOAT_EQ(a.pos.x, b.pos.x); EXPECT_FLOAT_EQ(a.pos.y, b.pos.y); EXPECT_FLOAT_EQ(a.pos.z, b.pos.z);
+		EXPECT_FLOAT_EQ(a.col.r, b.col.r); EXPECT_FLOAT_EQ(a.col.g, b.col.g); EXPECT_FLOAT_EQ(a.col.b, b.col.b); EXPECT_FLOAT_EQ(a.col.a, b.col.a);
+		EXPECT_FLOAT_EQ(a.norm.x, b.norm.x); EXPECT_FLOAT_EQ(a.norm.y, b.norm.y); EXPECT_FLOAT_EQ(a.norm.z, b.norm.z);
+		EXPECT_FLOAT_EQ(a.texCoord.x, b.texCoord.x); EXPECT_FLOAT_EQ(a.texCoord.y, b.texCoord.y);
+	}
+}
+
+TEST(VertexPackedTest, HalfExactValues) {
+	for (float x : { 0.0f, -0.0f, 1.0f, -2.0f, 0.5f, 65504.0f, 0x1p-14f, 0x1p-24f, 0.333251953125f }) {
+		const float back = SMath::Packing::halfToFloat(SMath::Packing::floatToHalf(x));
+		EXPECT_EQ(back, x);
+		EXPECT_EQ(std::signbit(back), std::signbit(x));
+	}
+	EXPECT_EQ(SMath::Packing::floatToHalf(1.0f), 0x3C00u);
+	EXPECT_EQ(SMath::Packing::floatToHalf(-2.0f), 0xC000u);
+	// Ties round to even
+	EXPECT_EQ(SMath::Packing::floatToHalf(1.0f + 0x1p-11f), 0x3C00u);
+	EXPECT_EQ(SMath::Packing::floatToHalf(1.0f + 3.0f * 0x1p-11f), 0x3C02u);
+}
+TEST(VertexPackedTest, HalfSpecialValues) {
+	EXPECT_EQ(SMath::Packing::floatToHalf(1e6f), 0x7C00u);
+	EXPECT_EQ(SMath::Packing::floatToHalf(-std::numeric_limits<float>::infinity()), 0xFC00u);
+	EXPECT_TRUE(std::isnan(SMath::Packing::halfToFloat(SMath::Packing::floatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+	EXPECT_TRUE(std::isinf(SMath::Packing::halfToFloat(0x7C00u)));
+	EXPECT_EQ(SMath::Packing::floatToHalf(1e-9f), 0u);
+}
+TEST(VertexPackedTest, HalfRoundTripError) {
+	std::mt19937 rng(7);
+	std::uniform_real_distribution<float> d(-1000.0f, 1000.0f);
+	for (int i = 0; i < 10000; ++i) {
+		const float x = d(rng);
+		const float back = SMath::Packing::halfToFloat(SMath::Packing::floatToHalf(x));
+		EXPECT_LE(std::abs(back - x), std::abs(x) * SMath::Packing::HALF_MAX_REL_ERROR) << x;
+	}
+}
+
+TEST(VertexPackedTest, OctahedralRoundTripError) {
+	std::mt19937 rng(11);
+	std::uniform_real_distribution<float> d(-1.0f, 1.0f);
+	float worst = 0.0f;
+	for (int i = 0; i < 20000; ++i) {
+		const SMath::Vec3<float> n = SMath::Vec3<float>(d(rng), d(rng), d(rng)).normalized();
+		if (n.lengthSquared() == 0.0f) continue;
+		std::int16_t enc[2];
+		SMath::Packing::octEncode(n, enc);
+		worst = std::max(worst, angleBetween(n, SMath::Packing::octDecode(enc)));
+	}
+	EXPECT_LE(worst, SMath::Packing::OCT_MAX_ANGLE_ERROR);
+}
+TEST(VertexPackedTest, OctahedralAxesAndZero) {
+	const SMath::Vec3<float> axes[] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+	for (const SMath::Vec3<float>& a : axes) {
+		std::int16_t enc[2];
+		SMath::Packing::octEncode(a, enc);
+		const SMath::Vec3<float> back = SMath::Packing::octDecode(enc);
+		EXPECT_NEAR(back.x, a.x, 1e-6f); EXPECT_NEAR(back.y, a.y, 1e-6f); EXPECT_NEAR(back.z, a.z, 1e-6f);
+	}
+
+	std::int16_t enc[2];
+	SMath::Packing::octEncode(SMath::Vec3<float>(0.0f), enc);
+	EXPECT_EQ(enc[0], 0);
+	EXPECT_EQ(enc[1], 0);
+	EXPECT_FLOAT_EQ(SMath::Packing::octDecode(enc).z, 1.0f);
+}
+
+TEST(VertexPackedTest, ColorRoundTrip) {
+	EXPECT_EQ(SMath::Packing::packRGBA8({ 1.0f, 0.0f, 0.0f, 1.0f }), 0xFF0000FFu);
+	EXPECT_EQ(SMath::Packing::packRGBA8({ 2.0f, -1.0f, 0.5f, 0.0f }), 0x008000FFu);
+
+	std::mt19937 rng(3);
+	std::uniform_real_distribution<float> d(0.0f, 1.0f);
+	for (int i = 0; i < 5000; ++i) {
+		const SMath::Vec4<float> c{ d(rng), d(rng), d(rng), d(rng) };
+		const SMath::Vec4<float> back = SMath::Packing::unpackRGBA8(SMath::Packing::packRGBA8(c));
+		EXPECT_LE(std::abs(back.r - c.r), SMath::Packing::RGBA8_MAX_ERROR + 1e-7f);
+		EXPECT_LE(std::abs(back.a - c.a), SMath::Packing::RGBA8_MAX_ERROR + 1e-7f);
+	}
+}
+
+TEST(VertexPackedTest, BulkMatchesScalar) {
+	for (size_t n : { 0u, 1u, 4u, 7u, 65u }) {
+		const std::vector<SMath::Vertex> vertices = randomVertices(n, static_cast<unsigned>(n));
+
+		std::vector<SMath::PackedVertex> packed(n);
+		SMath::packVertices(vertices, packed);
+		std::vector<SMath::Vertex> unpacked(n);
+		SMath::unpackVertices(packed, unpacked);
+
+		for (size_t i = 0; i < n; ++i) {
+			const SMath::PackedVertex expected = SMath::Packing::pack(vertices[i]);
+			EXPECT_EQ(packed[i].col, expected.col);
+			EXPECT_EQ(packed[i].norm[0], expected.norm[0]);
+			EXPECT_EQ(packed[i].norm[1], expected.norm[1]);
+			EXPECT_EQ(packed[i].texCoord[0], expected.texCoord[0]);
+			EXPECT_EQ(packed[i].texCoord[1], expected.texCoord[1]);
+			expectSameVertex(unpacked[i], SMath::Packing::unpack(expected));
+		}
+	}
+}
+TEST(VertexPackedTest, BulkHalfSpecialValuesMatchScalar) {
+	// NaNs with payloads and either sign, infinities and overflow, in both UV lanes of a full SIMD block
+	const float specials[] = {
+		std::bit_cast<float>(0x7FC12345u), std::bit_cast<float>(0xFF800001u), std::numeric_limits<float>::quiet_NaN(),
+		std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), 70000.0f, -1e-8f, 0.0f
+	};
+	std::vector<SMath::Vertex> vertices(8);
+	for (size_t i = 0; i < vertices.size(); ++i) vertices[i].texCoord = { specials[i], specials[7 - i] };
+
+	std::vector<SMath::PackedVertex> packed(vertices.size());
+	SMath::packVertices(vertices, packed);
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		EXPECT_EQ(packed[i].texCoord[0], SMath::Packing::floatToHalf(vertices[i].texCoord.x)) << "vertex " << i;
+		EXPECT_EQ(packed[i].texCoord[1], SMath::Packing::floatToHalf(vertices[i].texCoord.y)) << "vertex " << i;
+	}
+}
+TEST(VertexPackedTest, PackedRoundTripError) {
+	const std::vector<SMath::Vertex> vertices = randomVertices(1001, 21);
+	std::vector<SMath::PackedVertex> packed(vertices.size());
+	std::vector<SMath::Vertex> back(vertices.size());
+	SMath::packVertices(vertices, packed);
+	SMath::unpackVertices(packed, back);
+
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		EXPECT_EQ(back[i].pos, vertices[i].pos);
+		EXPECT_LE(std::abs(back[i].col.g - vertices[i].col.g), SMath::Packing::RGBA8_MAX_ERROR + 1e-7f);
+		EXPECT_LE(angleBetween(back[i].norm, vertices[i].norm), SMath::Packing::OCT_MAX_ANGLE_ERROR);
+		EXPECT_LE(std::abs(back[i].texCoord.x - vertices[i].texCoord.x), std::abs(vertices[i].texCoord.x) * SMath::Packing::HALF_MAX_REL_ERROR);
+	}
+}
+TEST(VertexPackedTest, QuantizedRoundTripError) {
+	for (size_t n : { 1u, 6u, 1001u }) {
+		const std::vector<SMath::Vertex> vertices = randomVertices(n, 5);
+		const SMath::AABB bounds = SMath::AABB::fromVertices(vertices);
+
+		std::vector<SMath::QuantizedVertex> packed(n);
+		std::vector<SMath::Vertex> back(n);
+		SMath::packVertices(vertices, bounds, packed);
+		SMath::unpackVertices(packed, bounds, back);
+
+		// Half a step of 65535 per axis, plus float rounding of the dequantize
+		const SMath::Vec3<float> tolerance = bounds.extent() * (0.5f / 65535.0f) + SMath::Vec3<float>(1e-5f);
+		const SMath::Packing::PositionQuantizer q(bounds);
+		for (size_t i = 0; i < n; ++i) {
+			EXPECT_LE(std::abs(back[i].pos.x - vertices[i].pos.x), tolerance.x);
+			EXPECT_LE(std::abs(back[i].pos.y - vertices[i].pos.y), tolerance.y);
+			EXPECT_LE(std::abs(back[i].pos.z - vertices[i].pos.z), tolerance.z);
+			EXPECT_LE(angleBetween(back[i].norm, vertices[i].norm), SMath::Packing::OCT_MAX_ANGLE_ERROR);
+
+			const SMath::QuantizedVertex expected = SMath::Packing::pack(vertices[i], q);
+			EXPECT_EQ(packed[i].pos[0], expected.pos[0]);
+			EXPECT_EQ(packed[i].pos[1], expected.pos[1]);
+			EXPECT_EQ(packed[i].pos[2], expected.pos[2]);
+			expectSameVertex(back[i], SMath::Packing::unpack(expected, q));
+		}
+	}
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "starlet-math/vertex_stream.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	std::vector<SMath::Vertex> numberedVertices(size_t n) {
+		std::vector<SMath::Vertex> vertices(n);
+		for (size_t i = 0; i < n; ++i) {
+			const float base = static_cast<float>(i * 12);
+			SMath::Vertex& v = vertices[i];
+			v.pos = { base, base + 1, base + 2 };
+			v.col = { base + 3, base + 4, base + 5, base + 6 };
+			v.norm = { base + 7, base + 8, base + 9 };
+			v.texCoord = { base + 10, base + 11 };
+		}
+		return vertices;
+	}
+}
+
+TEST(VertexStreamTest, LanesAreAligned) {
+	SMath::VertexStreamSoA stream;
+	stream.resize(5);
+	ASSERT_EQ(reinterpret_cast<std::uintptr_t>(stream.posX.data()) % 64, 0u);
+	ASSERT_EQ(reinterpret_cast<std::uintptr_t>(stream.v.data()) % 64, 0u);
+}
+TEST(VertexStreamTest, Deinterleave) {
+	const std::vector<SMath::Vertex> vertices = numberedVertices(9);
+	SMath::VertexStreamSoA stream(vertices);
+
+	ASSERT_EQ(stream.size(), 9u);
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		const float base = static_cast<float>(i * 12);
+		ASSERT_FLOAT_EQ(stream.posX[i], base); ASSERT_FLOAT_EQ(stream.posY[i], base + 1); ASSERT_FLOAT_EQ(stream.posZ[i], base + 2);
+		ASSERT_FLOAT_EQ(stream.colR[i], base + 3); ASSERT_FLOAT_EQ(stream.colG[i], base + 4);
+		ASSERT_FLOAT_EQ(stream.colB[i], base + 5); ASSERT_FLOAT_EQ(stream.colA[i], base + 6);
+		ASSERT_FLOAT_EQ(stream.normX[i], base + 7); ASSERT_FLOAT_EQ(stream.normY[i], base + 8); ASSERT_FLOAT_EQ(stream.normZ[i], base + 9);
+		ASSERT_FLOAT_EQ(stream.u[i], base + 10); ASSERT_FLOAT_EQ(stream.v[i], base + 11);
+	}
+}
+TEST(VertexStreamTest, RoundTrip) {
+	for (size_t n : { 0u, 1u, 4u, 7u, 64u }) {
+		const std::vector<SMath::Vertex> vertices = numberedVertices(n);
+		SMath::VertexStreamSoA stream(vertices);
+
+		std::vector<SMath::Vertex> out(n);
+		stream.interleave(out);
+		for (size_t i = 0; i < n; ++i) {
+			const float* a = reinterpret_cast<const float*>(&vertices[i]);
+			const float* b = reinterpret_cast<const float*>(&out[i]);
+			for (int k = 0; k < 12; ++k) ASSERT_FLOAT_EQ(a[k], b[k]);
+		}
+	}
+}
+TEST(VertexStreamTest, GetAndSet) {
+	SMath::VertexStreamSoA stream;
+	stream.resize(2);
+
+	SMath::Vertex v;
+	v.pos = { 1.0f, 2.0f, 3.0f };
+	v.texCoord = { 0.25f, 0.75f };
+	stream.set(1, v);
+
+	const SMath::Vertex back = stream.get(1);
+	ASSERT_FLOAT_EQ(back.pos.x, 1.0f); ASSERT_FLOAT_EQ(back.pos.y, 2.0f); ASSERT_FLOAT_EQ(back.pos.z, 3.0f);
+	ASSERT_FLOAT_EQ(back.texCoord.x, 0.25f); ASSERT_FLOAT_EQ(back.texCoord.y, 0.75f);
+}
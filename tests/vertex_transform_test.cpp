@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "starlet-math/vertex_transform.hpp"
+
+#include <random>
+#include <vector>
+
+namespace SMath = Starlet::Math;
+
+namespace {
+	std::vector<SMath::Vertex> randomVertices(size_t n, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+
+		std::vector<SMath::Vertex> vertices(n);
+		for (SMath::Vertex& v : vertices) {
+			v.pos = { dist(rng), dist(rng), dist(rng) };
+			v.col = { dist(rng), dist(rng), dist(rng), dist(rng) };
+			v.norm = SMath::Vec3<float>(dist(rng), dist(rng), dist(rng)).normalized();
+			v.texCoord = { dist(rng), dist(rng) };
+		}
+		return vertices;
+	}
+
+	SMath::Mat4 testMatrix() {
+		SMath::Transform t;
+		t.pos = { 3.0f, -2.0f, 5.0f, 1.0f };
+		t.rot = { 25.0f, -40.0f, 70.0f };
+		t.size = { 2.0f, 0.5f, 3.0f };
+		return SMath::Mat4::modelMatrix(t);
+	}
+
+	void expectVertexNear(const SMath::Vertex& a, const SMath::Vertex& b) {
+		EXPECT_NEAR(a.pos.x, b.pos.x, 1e-4f); EXPECT_NEAR(a.pos.y, b.pos.y, 1e-4f); EXPECT_NEAR(a.pos.z, b.pos.z, 1e-4f);
+		EXPECT_NEAR(a.norm.x, b.norm.x, 1e-5f); EXPECT_NEAR(a.norm.y, b.norm.y, 1e-5f); EXPECT_NEAR(a.norm.z, b.norm.z, 1e-5f);
+		EXPECT_FLOAT_EQ(a.col.r, b.col.r); EXPECT_FLOAT_EQ(a.col.g, b.col.g); EXPECT_FLOAT_EQ(a.col.b, b.col.b); EXPECT_FLOAT_EQ(a.col.a, b.col.a);
+		EXPECT_FLOAT_EQ(a.texCoord.x, b.texCoord.x); EXPECT_FLOAT_EQ(a.texCoord.y, b.texCoord.y);
+	}
+
+	SMath::Vertex reference(const SMath::Mat4& m, const SMath::Vertex& v) {
+		const SMath::Vec4<float> p = m * SMath::Vec4<float>(v.pos, 1.0f);
+		const SMath::Mat4 normalMat = m.inverse().transpose();
+		const SMath::Vec4<float> n = normalMat * SMath::Vec4<float>(v.norm, 0.0f);
+
+		SMath::Vertex out = v;
+		out.pos = { p.x, p.y, p.z };
+		out.norm = SMath::Vec3<float>(n.x, n.y, n.z).normalized();
+		return out;
+	}
+}
+
+TEST(VertexTransformTest, Identity) {
+	const std::vector<SMath::Vertex> in = randomVertices(10, 1);
+	std::vector<SMath::Vertex> out(in.size());
+	SMath::transformVertices(SMath::Mat4::identity(), in.data(), out.data(), in.size());
+	for (size_t i = 0; i < in.size(); ++i)
+		expectVertexNear(out[i], in[i]);
+}
+TEST(VertexTransformTest, MatchesReference) {
+	const SMath::Mat4 m = testMatrix();
+	const std::vector<SMath::Vertex> in = randomVertices(100, 2);
+	std::vector<SMath::Vertex> out(in.size());
+	SMath::transformVertices(m, in.data(), out.data(), in.size());
+	for (size_t i = 0; i < in.size(); ++i)
+		expectVertexNear(out[i], reference(m, in[i]));
+}
+TEST(VertexTransformTest, InPlace) {
+	const SMath::Mat4 m = testMatrix();
+	const std::vector<SMath::Vertex> original = randomVertices(33, 3);
+	std::vector<SMath::Vertex> vertices = original;
+	SMath::transformVertices(m, vertices.data(), vertices.size());
+	for (size_t i = 0; i < vertices.size(); ++i)
+		expectVertexNear(vertices[i], reference(m, original[i]));
+}
+TEST(VertexTransformTest, ZeroNormalStaysZero) {
+	SMath::Vertex v;
+	v.norm = { 0.0f, 0.0f, 0.0f };
+	SMath::Vertex out;
+	SMath::transformVertices(testMatrix(), &v, &out, 1);
+	ASSERT_FLOAT_EQ(out.norm.x, 0.0f); ASSERT_FLOAT_EQ(out.norm.y, 0.0f); ASSERT_FLOAT_EQ(out.norm.z, 0.0f);
+}
+TEST(VertexTransformTest, LargeStreamingOutput) {
+	const SMath::Mat4 m = testMatrix();
+	const size_t n = SMath::STREAMING_STORE_BYTES / sizeof(SMath::Vertex) + 5;
+	const std::vector<SMath::Vertex> in = randomVertices(n, 4);
+	std::vector<SMath::Vertex> out(n);
+	SMath::transformVertices(m, in.data(), out.data(), n);
+	for (size_t i = 0; i < n; i += 997)
+		expectVertexNear(out[i], reference(m, in[i]));
+	expectVertexNear(out[n - 1], reference(m, in[n - 1]));
+}
+TEST(VertexTransformTest, DegenerateScaleRotatesNormals) {
+	// Flattened onto the rotated xz plane: every normal with a y component ends up along the rotated y axis
+	const SMath::Mat4 r = SMath::Mat4::rotateZ(30.0f);
+	const SMath::Mat4 m = r * SMath::Mat4::size({ 1.0f, 0.0f, 1.0f });
+	const SMath::Vec4<float> up4 = r * SMath::Vec4<float>(0.0f, 1.0f, 0.0f, 0.0f);
+	const SMath::Vec3<float> up(up4.x, up4.y, up4.z);
+
+	std::vector<SMath::Vertex> in = randomVertices(9, 5);
+	for (size_t i = 0; i < in.size(); ++i) {
+		const float y = i % 2 == 0 ? 0.8f : -0.6f;
+		in[i].norm = SMath::Vec3<float>(0.3f, y, -0.5f).normalized();
+	}
+	std::vector<SMath::Vertex> out(in.size());
+	SMath::transformVertices(m, in.data(), out.data(), in.size());
+	for (size_t i = 0; i < in.size(); ++i) {
+		const SMath::Vec3<float> expected = i % 2 == 0 ? up : -up;
+		EXPECT_NEAR(out[i].norm.x, expected.x, 1e-5f) << i;
+		EXPECT_NEAR(out[i].norm.y, expected.y, 1e-5f) << i;
+		EXPECT_NEAR(out[i].norm.z, expected.z, 1e-5f) << i;
+	}
+}